@@ -8,6 +8,7 @@
 
 #include "angle/ProductQuadrature.hh"
 #include "utilities/SoftEquivalence.hh"
+#include <cmath>
 
 namespace detran_angle
 {
@@ -289,6 +290,30 @@ ProductQuadrature::polar(const size_t angle) const
   return tmp;
 }
 
+//----------------------------------------------------------------------------//
+void ProductQuadrature::set_azimuths(const vec_dbl &phi)
+{
+  Require(phi.size() == d_number_azimuth_octant);
+
+  double half_pi = 0.5 * detran_utilities::pi;
+  double total = 0.0;
+  for (size_t a = 0; a < d_number_azimuth_octant; ++a)
+    total += d_azimuth_weight[a];
+  for (size_t a = 0; a < d_number_azimuth_octant; ++a)
+  {
+    Insist(phi[a] > 0.0 && phi[a] < half_pi, "Azimuths must be in (0, pi/2)");
+    Insist(a == 0 || phi[a] > phi[a - 1], "Azimuths must increase");
+    double lower = a > 0 ? 0.5 * (phi[a - 1] + phi[a]) : 0.0;
+    double upper = a + 1 < d_number_azimuth_octant ?
+                   0.5 * (phi[a] + phi[a + 1]) : half_pi;
+    d_phi[a]            = phi[a];
+    d_cos_phi[a]        = std::cos(phi[a]);
+    d_sin_phi[a]        = std::sin(phi[a]);
+    d_azimuth_weight[a] = (upper - lower) * total / half_pi;
+  }
+  build();
+}
+
 //----------------------------------------------------------------------------//
 void ProductQuadrature::build()
 {
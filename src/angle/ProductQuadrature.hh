@@ -134,6 +134,15 @@ public:
   /// Polar index from cardinal within octant
   size_t polar(const size_t angle) const;
 
+  /**
+   *  @brief Replace the azimuths, e.g. to make MOC tracking cyclic
+   *  @param phi    Azimuths within the first octant, in increasing order
+   *
+   *  Each azimuth is weighted by the arc between the midpoints to its
+   *  neighbors (or to 0 and pi/2), scaled so the weights keep their sum.
+   */
+  void set_azimuths(const vec_dbl &phi);
+
   // Prepend class on the following because onld SWIG fails on this
   // particular nested type.
 
@@ -201,6 +201,20 @@ public:
     return d_boundary_flux_size[side];
   }
 
+  /**
+   *  @brief Number of reflected boundary flux values in a group
+   *
+   *  These are the incident fluxes that Krylov solvers carry as
+   *  unknowns, i.e. half the flux on each reflecting side.
+   */
+  virtual size_t reflective_flux_size() const
+  {
+    size_t n = 0;
+    for (size_t side = 0; side < d_is_reflective.size(); ++side)
+      if (d_is_reflective[side]) n += d_boundary_flux_size[side] / 2;
+    return n;
+  }
+
   /// Display boundray information and contents
   virtual void display(bool inout) const
   {
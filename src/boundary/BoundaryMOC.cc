@@ -10,6 +10,7 @@
 #include "BoundaryMOC.hh"
 #include "VacuumMOC.hh"
 #include "ReflectiveMOC.hh"
+#include "PeriodicMOC.hh"
 #include <iostream>
 
 namespace detran
@@ -26,16 +27,10 @@ BoundaryMOC<D>::BoundaryMOC(SP_input        input,
                     vec3_dbl(quadrature->number_angles(),
                              vec2_dbl(2)))
   , d_bc(2*D::dimension)
+  , d_is_periodic(2*D::dimension, false)
 {
   Require(d_quadrature);
-  Insist(D::dimension == 2, "MOC is for 2D only.");
-
-  // Allocated the flux container.
-  initialize();
-
-  // Setup indexing.
-  setup_indices();
-  setup_side_indices();
+  Insist(D::dimension > 1, "MOC is for 2D and 3D only.");
 
   // Create boundary conditions.
   std::vector<std::string> names(6);
@@ -66,6 +61,11 @@ BoundaryMOC<D>::BoundaryMOC(SP_input        input,
       d_is_reflective[side] = true;
       d_has_reflective = true;
     }
+    else if (type == "periodic")
+    {
+      d_bc[side] = new PeriodicMOC<D>((*this), side, d_input, d_mesh, d_quadrature);
+      d_is_periodic[side] = true;
+    }
     else
     {
       type.append(" is not a supported bc type.");
@@ -73,6 +73,46 @@ BoundaryMOC<D>::BoundaryMOC(SP_input        input,
       break;
     }
   }
+  Insist(d_is_periodic[Mesh::WEST]  == d_is_periodic[Mesh::EAST] &&
+         d_is_periodic[Mesh::SOUTH] == d_is_periodic[Mesh::NORTH],
+         "Periodic MOC boundaries must come in opposite pairs.");
+
+  // In 3D, the sweeper handles the bottom and top as it follows each
+  // track up and down the axial mesh, so nothing is stored.
+  if (D::dimension == 3)
+  {
+    for (int side = 0; side < 4; ++side)
+    {
+      Insist(!d_is_reflective[side] && !d_is_periodic[side],
+             "3D MOC supports only vacuum radial boundaries.");
+    }
+    Insist(d_is_periodic[Mesh::BOTTOM] == d_is_periodic[Mesh::TOP],
+           "Periodic MOC boundaries must come in opposite pairs.");
+    setup_side_indices();
+    return;
+  }
+
+  // Linked tracks are swept as chains, which need no track fluxes.
+  bool chain_sweep = true;
+  if (d_input->check("moc_chain_sweep"))
+    chain_sweep = 0 != d_input->template get<int>("moc_chain_sweep");
+  Mesh::SP_trackdb tracks = d_mesh->tracks();
+  if (chain_sweep && tracks && tracks->is_linked())
+  {
+    setup_chains();
+  }
+  else
+  {
+    Insist(!d_is_periodic[Mesh::WEST] && !d_is_periodic[Mesh::SOUTH],
+           "Periodic MOC boundaries need chain sweeps of cyclic tracks.");
+
+    // Allocated the flux container.
+    initialize();
+
+    // Setup indexing.
+    setup_indices();
+    setup_side_indices();
+  }
 
 }
 
@@ -96,29 +136,28 @@ BoundaryMOC<D>::Create(SP_input       input,
 template<class D>
 void BoundaryMOC<D>::initialize()
 {
-
-//  // The boundary flux array is already
-//  // sized to [groups, angles, 2], where 2 is for inout.
-//
-//  // \todo Sloppy hack; need to specialize boundary so that the
-//  //       quadrature is specialized, too
-//  QuadratureMOC::SP_quadrature q;
-//  q = (QuadratureMOC::SP_quadrature) d_quadrature;
-//
-//  for (int g = 0; g < d_number_groups; g++)
-//  {
-//    for (int o = 0; o < 4; o++)
-//    {
-//      for (int a = 0; a < q->number_angles_octant(); a++)
-//      {
-//        int azimuth = q->azimuth(a);
-//        int angle = q->index(o, a);
-//        d_boundary_flux[g][angle][IN].resize(q->number_tracks(azimuth), 0.0);
-//        d_boundary_flux[g][angle][OUT].resize(q->number_tracks(azimuth), 0.0);
-//      }
-//    }
-//  }
-
+  // The boundary flux array is already sized to [groups, angles, 2],
+  // where 2 is for in/out.  Each angle holds one value per track along
+  // its azimuth, indexed as in the sweep: octants 1 and 3 use the
+  // azimuths of the second quadrant.  Without tracks, nothing is sized.
+  Mesh::SP_trackdb tracks = d_mesh->tracks();
+  if (!tracks) return;
+  size_t na = d_quadrature->number_azimuths_octant();
+  for (size_t g = 0; g < d_number_groups; g++)
+  {
+    for (size_t o = 0; o < 4; o++)
+    {
+      for (size_t a = 0; a < d_quadrature->number_angles_octant(); a++)
+      {
+        size_t azimuth = d_quadrature->azimuth(a);
+        if (o == 1 || o == 3) azimuth += na;
+        size_t angle = d_quadrature->index(o, a);
+        size_t n = tracks->number_tracks(azimuth);
+        d_boundary_flux[g][angle][IN].assign(n, 0.0);
+        d_boundary_flux[g][angle][OUT].assign(n, 0.0);
+      }
+    }
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -239,6 +278,8 @@ void BoundaryMOC<D>::setup_side_indices()
   using std::cout;
   using std::endl;
 
+  d_side_index.resize(2*D::dimension);
+
 //
 //  // Incident octants; left to right from incident perspective.
 //  int oct[4][2] = {{0, 3},
@@ -376,6 +417,101 @@ void BoundaryMOC<D>::setup_side_indices()
 
 }
 
+//---------------------------------------------------------------------------//
+template<class D>
+void BoundaryMOC<D>::setup_chains()
+{
+  typedef detran_geometry::TrackDB TrackDB;
+
+  Mesh::SP_trackdb tracks = d_mesh->tracks();
+  size_t na = d_quadrature->number_azimuths_octant();
+  size_t np = d_quadrature->number_polar_octant();
+  d_chain_track.assign(na, vec_int());
+  d_chain_offset.assign(na, vec_int(1, 0));
+  d_number_closed.assign(na, 0);
+  d_chain_flux.assign(2, vec3_dbl(d_number_groups, vec2_dbl(na)));
+
+  for (size_t a = 0; a < na; ++a)
+  {
+    // Tracks of an azimuth link only to those of the azimuth and its
+    // mirror.  Track i of these, in direction d, is node 2 * i + d.
+    size_t n0 = tracks->number_tracks(a);
+    size_t n1 = tracks->number_tracks(a + na);
+    size_t f0 = tracks->first_track(a);
+    size_t f1 = tracks->first_track(a + na);
+    size_t n  = 2 * (n0 + n1);
+    vec_int flat(n0 + n1);
+    for (size_t i = 0; i < n0 + n1; ++i)
+      flat[i] = i < n0 ? f0 + i : f1 + i - n0;
+
+    // The node each node leads into, or -1 at a vacuum side
+    vec_int next(n, -1);
+    vec_bool has_previous(n, false);
+    for (size_t node = 0; node < n; ++node)
+    {
+      size_t track = flat[node / 2], d = node % 2;
+      int side = tracks->exit_side(track, d);
+      if (!d_is_reflective[side] && !d_is_periodic[side]) continue;
+      int kind = d_is_reflective[side] ? TrackDB::REFLECT : TrackDB::PERIODIC;
+      int link = tracks->link(track, d, kind);
+      size_t t = link / 2;
+      size_t i = (t >= f0 && t < f0 + n0) ? t - f0 : n0 + t - f1;
+      Assert(i < n0 + n1);
+      next[node] = 2 * i + link % 2;
+      Assert(!has_previous[next[node]]);
+      has_previous[next[node]] = true;
+    }
+
+    // Chains start at vacuum sides; the nodes left over form closed ones.
+    vec2_int open, closed;
+    vec_bool visited(n, false);
+    for (size_t node = 0; node < n; ++node)
+    {
+      if (has_previous[node]) continue;
+      open.push_back(vec_int());
+      for (int k = node; k >= 0; k = next[k])
+      {
+        open.back().push_back(k);
+        visited[k] = true;
+      }
+    }
+    for (size_t node = 0; node < n; ++node)
+    {
+      if (visited[node]) continue;
+      closed.push_back(vec_int());
+      int k = node;
+      do
+      {
+        Assert(k >= 0);
+        closed.back().push_back(k);
+        visited[k] = true;
+        k = next[k];
+      } while (k != node);
+    }
+
+    // Store closed chains first, with nodes as 4 * flat track + octant.
+    d_number_closed[a] = closed.size();
+    closed.insert(closed.end(), open.begin(), open.end());
+    for (size_t c = 0; c < closed.size(); ++c)
+    {
+      for (size_t j = 0; j < closed[c].size(); ++j)
+      {
+        size_t i = closed[c][j] / 2, d = closed[c][j] % 2;
+        int o = (i < n0 ? 0 : 1) + (d == TrackDB::BACKWARD ? 2 : 0);
+        d_chain_track[a].push_back(4 * flat[i] + o);
+      }
+      d_chain_offset[a].push_back(d_chain_track[a].size());
+    }
+    for (size_t inout = 0; inout < 2; ++inout)
+      for (size_t g = 0; g < d_number_groups; ++g)
+        d_chain_flux[inout][g][a].assign(d_number_closed[a] * np, 0.0);
+
+    // Closed chains carry flux back into themselves, so Krylov solvers
+    // treat them as reflecting.
+    if (d_number_closed[a]) d_has_reflective = true;
+  }
+}
+
 //---------------------------------------------------------------------------//
 // EXPLICIT INSTANTIATIONS
 //---------------------------------------------------------------------------//
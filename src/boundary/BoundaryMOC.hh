@@ -26,6 +26,25 @@ namespace detran
  *  by sweeping along fixed tracks crossing the domain.  Tracks
  *  begin and end at a global boundary.  This class stores the
  *  angular flux for each track.
+ *
+ *  With cyclic tracks (see Tracker), each track leads into another
+ *  across a reflecting or periodic side, and the tracks of an azimuth
+ *  and its mirror form chains.  A chain begins at a vacuum side or
+ *  closes on itself.  The sweeper then follows each chain, carrying the
+ *  flux from one track to the next, so only an incident and outgoing
+ *  flux per closed chain and polar angle are stored rather than two per
+ *  track and angle.  The incident ones are the boundary unknowns of
+ *  Krylov solvers, which then see closed chains as reflecting.
+ *  Periodic sides require chains and must come in opposite pairs.
+ *
+ *  In 3D, the tracks are axially extruded 2D tracks (see Sweeper3DMOC),
+ *  which the sweeper follows across the bottom and top itself.  Nothing
+ *  is then stored, and the radial sides must be vacuum.
+ *
+ *  Relevant input database entries:
+ *    - bc_west, bc_east, etc. [str] (vacuum, reflect, or periodic)
+ *    - moc_chain_sweep [int]        (sweep chains of linked tracks;
+ *                                    default 1)
  */
 
 template <class D>
@@ -52,6 +71,7 @@ public:
   typedef detran_utilities::vec_int             vec_int;
   typedef detran_utilities::vec2_int            vec2_int;
   typedef detran_utilities::vec3_int            vec3_int;
+  typedef detran_utilities::vec_dbl             vec_dbl;
   typedef detran_utilities::vec2_dbl            vec2_dbl;
   typedef detran_utilities::vec3_dbl            vec3_dbl;
   typedef std::vector<vec3_dbl>                 bf_type;
@@ -98,10 +118,10 @@ public:
 
   /// Set the entire group boundary flux for reflecting sides.
   void psi(const size_t g, double *v, const int inout, const int gs,
-           bool onlyref = true)
-  {
-    THROW("IMPLEMENT ME");
-  }
+           bool onlyref = true);
+
+  /// Number of closed chain fluxes in a group, if there are chains.
+  size_t reflective_flux_size() const;
 
   //-------------------------------------------------------------------------//
   // BOUNDARY FLUX ACCESS
@@ -159,12 +179,47 @@ public:
   void feed_from(const size_t o1, const size_t a1, const size_t t1,
                  size_t &o2, size_t &a2, size_t &t2);
 
+  /// Is a side periodic?
+  bool is_periodic(const size_t side) const
+  {
+    Require(side < d_is_periodic.size());
+    return d_is_periodic[side];
+  }
+
   /// Return vector of octant, azimuth, track triplets for a side.
   const vec2_int& side_indices(const size_t side) const
   {
     return d_side_index[side];
   }
 
+  //-------------------------------------------------------------------------//
+  // CHAINS
+  //-------------------------------------------------------------------------//
+
+  /// Are the tracks swept as chains?
+  bool has_chains() const { return !d_chain_offset.empty(); }
+
+  /// Number of chains of an azimuth (within the first octant)
+  inline size_t number_chains(const size_t a) const;
+
+  /// Number of chains of an azimuth that close; these come first.
+  inline size_t number_closed(const size_t a) const;
+
+  //@{
+  /// Range of entries of a chain
+  inline size_t chain_begin(const size_t a, const size_t c) const;
+  inline size_t chain_end(const size_t a, const size_t c) const;
+  //@}
+
+  /// Chain entry of an azimuth, given as 4 * flat track + octant
+  inline int chain_track(const size_t a, const size_t i) const;
+
+  /// Flux entering (IN) or leaving (OUT) a closed chain for a group and
+  /// polar angle
+  inline double& chain_flux(const size_t g, const size_t a,
+                            const size_t c, const size_t p,
+                            const size_t inout = IN);
+
 private:
 
   //-------------------------------------------------------------------------//
@@ -180,6 +235,8 @@ private:
   using Base::d_has_vacuum;
   using Base::d_boundary_flux_size;
 
+  typedef detran_utilities::vec_bool            vec_bool;
+
   /// MOC Quadrature
   SP_quadrature d_quadrature;
   /// Boundary flux [energy, angle, inout, track]
@@ -192,6 +249,16 @@ private:
   std::vector<vec3_int> d_feed_from;
   /// d_side_index[side][o a t]
   vec3_int d_side_index;
+  /// Is a side periodic?
+  vec_bool d_is_periodic;
+  /// Chain entries by [azimuth][entry]
+  vec2_int d_chain_track;
+  /// Chain offsets into the entries by [azimuth][chain]
+  vec2_int d_chain_offset;
+  /// Number of closed chains by azimuth
+  vec_int d_number_closed;
+  /// Closed chain fluxes by [inout][group][azimuth][chain * polar + polar]
+  std::vector<vec3_dbl> d_chain_flux;
 
   //-------------------------------------------------------------------------//
   // IMPLEMENTATION
@@ -206,6 +273,9 @@ private:
   /// Setup indices for an incident side.
   void setup_side_indices();
 
+  /// Follow the links of the tracks into chains.
+  void setup_chains();
+
 };
 
 } // end namespace detran
@@ -32,6 +32,14 @@ inline void BoundaryMOC<D>::set(const size_t g)
 template <class D>
 inline void BoundaryMOC<D>::update(const size_t g)
 {
+  // Closed chains lead back into themselves.
+  if (has_chains())
+  {
+    d_chain_flux[IN][g] = d_chain_flux[OUT][g];
+    return;
+  }
+  // 3D tracks carry their own boundary fluxes.
+  if (D::dimension == 3) return;
   for(int side = 0; side < 2*D::dimension; side++)
     d_bc[side]->update(g);
 }
@@ -40,6 +48,8 @@ inline void BoundaryMOC<D>::update(const size_t g)
 template <class D>
 inline void BoundaryMOC<D>::update(const size_t g, const size_t o, const size_t a)
 {
+  // Chains are followed through reflections by the sweeper.
+  if (has_chains() || D::dimension == 3) return;
   for(int side = 0; side < 2*D::dimension; side++)
     d_bc[side]->update(g, o, a);
 }
@@ -48,7 +58,53 @@ inline void BoundaryMOC<D>::update(const size_t g, const size_t o, const size_t
 template <class D>
 inline void BoundaryMOC<D>::clear(const size_t g)
 {
-  /* ... */
+  Require(g < d_number_groups);
+  for (size_t angle = 0; angle < d_boundary_flux[g].size(); ++angle)
+    for (size_t inout = 0; inout < 2; ++inout)
+      for (size_t t = 0; t < d_boundary_flux[g][angle][inout].size(); ++t)
+        d_boundary_flux[g][angle][inout][t] = 0.0;
+  for (size_t inout = 0; inout < d_chain_flux.size(); ++inout)
+    for (size_t a = 0; a < d_chain_flux[inout][g].size(); ++a)
+      for (size_t i = 0; i < d_chain_flux[inout][g][a].size(); ++i)
+        d_chain_flux[inout][g][a][i] = 0.0;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline void BoundaryMOC<D>::psi(const size_t  g,
+                                double       *v,
+                                const int     inout,
+                                const int     gs,
+                                bool          onlyref)
+{
+  Require(g < d_number_groups);
+  Require(v);
+  Insist(has_chains(),
+         "Krylov solvers need chain sweeps for reflecting MOC boundaries.");
+  size_t n = 0;
+  for (size_t a = 0; a < d_chain_flux[inout][g].size(); ++a)
+  {
+    vec_dbl &flux = d_chain_flux[inout][g][a];
+    for (size_t i = 0; i < flux.size(); ++i, ++n)
+    {
+      if (gs == Base::SET)
+        flux[i] = v[n];
+      else
+        v[n] = flux[i];
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline typename BoundaryMOC<D>::size_t
+BoundaryMOC<D>::reflective_flux_size() const
+{
+  if (!has_chains()) return Base::reflective_flux_size();
+  size_t n = 0;
+  for (size_t a = 0; a < d_chain_flux[IN][0].size(); ++a)
+    n += d_chain_flux[IN][0][a].size();
+  return n;
 }
 
 //---------------------------------------------------------------------------//
@@ -119,6 +175,68 @@ BoundaryMOC<D>::feed_from(const size_t  o1, const size_t  a1, const size_t  t1,
 //  t2 = d_feed_from[o1][a1][t1][2];
 }
 
+//---------------------------------------------------------------------------//
+// CHAINS
+//---------------------------------------------------------------------------//
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline typename BoundaryMOC<D>::size_t
+BoundaryMOC<D>::number_chains(const size_t a) const
+{
+  Require(a < d_chain_offset.size());
+  return d_chain_offset[a].size() - 1;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline typename BoundaryMOC<D>::size_t
+BoundaryMOC<D>::number_closed(const size_t a) const
+{
+  Require(a < d_number_closed.size());
+  return d_number_closed[a];
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline typename BoundaryMOC<D>::size_t
+BoundaryMOC<D>::chain_begin(const size_t a, const size_t c) const
+{
+  Require(c < number_chains(a));
+  return d_chain_offset[a][c];
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline typename BoundaryMOC<D>::size_t
+BoundaryMOC<D>::chain_end(const size_t a, const size_t c) const
+{
+  Require(c < number_chains(a));
+  return d_chain_offset[a][c + 1];
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline int BoundaryMOC<D>::chain_track(const size_t a, const size_t i) const
+{
+  Require(a < d_chain_track.size());
+  Require(i < d_chain_track[a].size());
+  return d_chain_track[a][i];
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline double& BoundaryMOC<D>::chain_flux(const size_t g, const size_t a,
+                                          const size_t c, const size_t p,
+                                          const size_t inout)
+{
+  Require(g < d_number_groups);
+  Require(c < number_closed(a));
+  Require(p < d_quadrature->number_polar_octant());
+  Require(inout < 2);
+  return d_chain_flux[inout][g][a][c * d_quadrature->number_polar_octant() + p];
+}
+
 } // end namespace detran
 
 #endif // detran_BOUNDARYMOC_I_HH_
@@ -0,0 +1,85 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   PeriodicMOC.hh
+ *  @brief  PeriodicMOC class definition.
+ *  @note   Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_PERIODICMOC_HH_
+#define detran_PERIODICMOC_HH_
+
+#include "BoundaryConditionMOC.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class PeriodicMOC
+ *  @brief Periodic boundary condition for MOC
+ *
+ *  A track leaving through a periodic side continues as the track
+ *  entering the opposite side at the same point.  Only cyclic tracks
+ *  link that way, and their chains are swept whole (see BoundaryMOC),
+ *  so there is nothing to update here.
+ */
+//---------------------------------------------------------------------------//
+
+template <class D>
+class PeriodicMOC : public BoundaryConditionMOC<D>
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef BoundaryConditionMOC<D>             Base;
+  typedef typename Base::SP_bc                SP_bc;
+  typedef typename Base::Boundary_T           Boundary_T;
+  typedef typename Base::SP_input             SP_input;
+  typedef typename Base::SP_mesh              SP_mesh;
+  typedef typename Base::SP_quadrature        SP_quadrature;
+  typedef typename Base::size_t               size_t;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  PeriodicMOC(BoundaryMOC<D>& boundary,
+            const size_t side,
+            SP_input input,
+            SP_mesh mesh,
+            SP_quadrature quadrature)
+    : BoundaryConditionMOC<D>(boundary, side, input, mesh, quadrature)
+  {
+    /* ... */
+  }
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL MOC BOUNDARY CONDITIONS MUST IMPLEMENT THESE
+  //-------------------------------------------------------------------------//
+
+  /// Set initial and/or fixed boundary condition.  Chains do the work.
+  void set(const size_t g){}
+
+  /// Update a boundary following a sweep.  Chains do the work.
+  void update(const size_t g){}
+
+  /// Update a boundary for a given angle following a sweep. Chains do the work.
+  void update(const size_t g, const size_t o, const size_t a){}
+
+private:
+
+};
+
+
+} // end namespace detran
+
+#endif // detran_PERIODICMOC_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file PeriodicMOC.hh
+//---------------------------------------------------------------------------//
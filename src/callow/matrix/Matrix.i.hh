@@ -106,8 +106,9 @@ inline void Matrix::multiply(const Vector &x, Vector &y)
   y.scale(0);
   // row pointer
   int p = 0;
-  // for all rows
-  #pragma omp for schedule(static) private(p)
+  // for all rows; a region of its own, since an orphaned loop would be
+  // split across any enclosing team (e.g. group-parallel solvers)
+  #pragma omp parallel for schedule(static) private(p)
   for (int i = 0; i < d_m; ++i)
   {
     double temp = y[i];
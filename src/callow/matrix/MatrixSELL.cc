@@ -0,0 +1,132 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  MatrixSELL.cc
+ *  @brief MatrixSELL member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "MatrixSELL.hh"
+#include <algorithm>
+#include <cstdio>
+
+namespace callow
+{
+
+namespace
+{
+
+/// Orders rows by decreasing length, then by index
+struct longer_row
+{
+  longer_row(Matrix &A) : d_A(A) {}
+  bool operator()(const int a, const int b) const
+  {
+    int la = d_A.end(a) - d_A.start(a);
+    int lb = d_A.end(b) - d_A.start(b);
+    return la > lb || (la == lb && a < b);
+  }
+  Matrix &d_A;
+};
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------//
+MatrixSELL::MatrixSELL(Matrix &A, const int sigma)
+  : MatrixBase(A.number_rows(), A.number_columns())
+  , d_nnz(A.number_nonzeros())
+{
+  Insist(A.is_ready(), "The matrix must be assembled before conversion");
+  Require(sigma > 0);
+
+  // sort the rows by length within each window of sigma rows
+  int number_chunks = (d_m + chunk_size - 1) / chunk_size;
+  d_row.assign(number_chunks * chunk_size, -1);
+  for (int i = 0; i < d_m; ++i)
+    d_row[i] = i;
+  for (int b = 0; b < d_m; b += sigma)
+  {
+    int e = std::min(b + sigma, d_m);
+    std::sort(d_row.begin() + b, d_row.begin() + e, longer_row(A));
+  }
+
+  // size the chunks
+  d_chunk.resize(number_chunks + 1, 0);
+  d_width.resize(number_chunks, 0);
+  for (int k = 0; k < number_chunks; ++k)
+  {
+    for (int r = 0; r < chunk_size; ++r)
+    {
+      int i = d_row[k * chunk_size + r];
+      if (i >= 0) d_width[k] = std::max(d_width[k], A.end(i) - A.start(i));
+    }
+    d_chunk[k + 1] = d_chunk[k] + d_width[k] * chunk_size;
+  }
+
+  // fill the chunks column by column, padding with zeros in column 0
+  d_values.assign(d_chunk[number_chunks], 0.0);
+  d_columns.assign(d_chunk[number_chunks], 0);
+  for (int k = 0; k < number_chunks; ++k)
+  {
+    for (int r = 0; r < chunk_size; ++r)
+    {
+      int i = d_row[k * chunk_size + r];
+      if (i < 0) continue;
+      for (int p = A.start(i); p < A.end(i); ++p)
+      {
+        int q = d_chunk[k] + (p - A.start(i)) * chunk_size + r;
+        d_values[q]  = A.values()[p];
+        d_columns[q] = A.column(p);
+      }
+    }
+  }
+
+  d_is_ready = true;
+}
+
+//----------------------------------------------------------------------------//
+MatrixSELL::SP_matrix MatrixSELL::Create(Matrix &A, const int sigma)
+{
+  SP_matrix p(new MatrixSELL(A, sigma));
+  return p;
+}
+
+//----------------------------------------------------------------------------//
+void MatrixSELL::display(bool forceprint) const
+{
+  Require(d_is_ready);
+  printf(" SELL-%i matrix \n", chunk_size);
+  printf(" ---------------------------\n");
+  printf("      number rows = %5i \n",   d_m);
+  printf("   number columns = %5i \n",   d_n);
+  printf("   number nonzero = %5i \n",   d_nnz);
+  printf("      stored size = %5i \n\n", (int)d_values.size());
+  printf("\n");
+  if ((d_m > 20 || d_n > 20) && !forceprint)
+  {
+    printf("  *** matrix not printed for m or n > 20 *** \n");
+    return;
+  }
+  for (int k = 0; k < d_width.size(); ++k)
+  {
+    for (int r = 0; r < chunk_size; ++r)
+    {
+      int i = d_row[k * chunk_size + r];
+      if (i < 0) continue;
+      printf(" row  %3i | ", i);
+      for (int w = 0; w < d_width[k]; ++w)
+      {
+        int p = d_chunk[k] + w * chunk_size + r;
+        printf(" %3i (%13.6e)", d_columns[p], d_values[p]);
+      }
+      printf("\n");
+    }
+  }
+  printf("\n");
+}
+
+} // end namespace callow
+
+//----------------------------------------------------------------------------//
+//              end of MatrixSELL.cc
+//----------------------------------------------------------------------------//
@@ -0,0 +1,154 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  MatrixSELL.hh
+ *  @brief MatrixSELL class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef callow_MATRIXSELL_HH_
+#define callow_MATRIXSELL_HH_
+
+#include "Matrix.hh"
+#include <vector>
+
+namespace callow
+{
+
+/**
+ *  @class MatrixSELL
+ *  @brief Sliced ELLPACK (SELL-C-sigma) matrix
+ *
+ *  The rows of an assembled @ref Matrix are cut into chunks of C rows,
+ *  and each chunk is padded to the length of its longest row and stored
+ *  column major.  The multiply then runs over the C rows of a chunk in
+ *  lock step, which the compiler can vectorize regardless of how
+ *  irregular the row lengths are.  To limit the padding, rows are first
+ *  sorted by decreasing length within windows of sigma rows; the
+ *  permutation is internal, so x and y keep the original ordering.
+ *
+ *  Example with C = 2 and sigma = 1 (no sorting):
+ *
+ *   | 7  0  0  2 |
+ *   | 0  2  0  4 |
+ *   | 1  0  0  0 |
+ *   | 3  8  0  6 |
+ *
+ *  chunk pointers  = [0 4 10]
+ *  chunk widths    = [2 3]
+ *  value           = [7 2 2 4 | 1 3 0 8 0 6]
+ *  column indices  = [0 1 3 3 | 0 0 0 1 0 3]
+ *
+ *  The matrix only provides the action of A (and A'), so it can be used by
+ *  any solver that works through @ref MatrixBase, e.g. GMRES or the
+ *  eigensolvers, but not by Jacobi, Gauss-Seidel, or the ILU
+ *  preconditioners, which need the CRS arrays.
+ *
+ *  The values are copied when the matrix is constructed, so it is a
+ *  snapshot of A at that time.  Later changes to A are not seen; to
+ *  use them, construct a new MatrixSELL from the updated A.
+ */
+/**
+ *  @example callow/test/test_MatrixSELL.cc
+ *
+ *  Test of MatrixSELL class
+ */
+
+class CALLOW_EXPORT MatrixSELL: public MatrixBase
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<MatrixSELL>  SP_matrix;
+  typedef MatrixBase::SP_matrix             SP_matrixbase;
+
+  /// Rows per chunk, fixed so the inner loop has a constant trip count
+  static const int chunk_size = 8;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Convert an assembled CRS matrix
+   *
+   *  A is copied and not referenced afterward.
+   *
+   *  @param A      assembled matrix
+   *  @param sigma  sorting window in rows (1 for no sorting)
+   */
+  MatrixSELL(Matrix &A, const int sigma = 32 * chunk_size);
+  /// virtual destructor
+  virtual ~MatrixSELL(){}
+  /// sp constructor
+  static SP_matrix Create(Matrix &A, const int sigma = 32 * chunk_size);
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /// number of nonzeros in the original matrix
+  int number_nonzeros() const { return d_nnz; }
+  /// number of stored entries, including the padding
+  int number_stored() const { return d_values.size(); }
+  /// number of chunks
+  int number_chunks() const { return d_width.size(); }
+
+  //--------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL MATRICES MUST IMPLEMENT
+  //--------------------------------------------------------------------------//
+
+  // nothing to do, since the matrix is built assembled
+  void assemble(){ /* ... */ }
+  // action y <-- A * x
+  void multiply(const Vector &x,  Vector &y);
+  // action y <-- A' * x
+  void multiply_transpose(const Vector &x, Vector &y);
+  // pretty print to screen
+  void display(bool forceprint = false) const;
+
+protected:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// expose base members
+  using MatrixBase::d_m;
+  using MatrixBase::d_n;
+  using MatrixBase::d_is_ready;
+
+  /// matrix elements, column major within each chunk
+  std::vector<double> d_values;
+  /// column indices, with padding pointing to column zero
+  std::vector<int> d_columns;
+  /// offset of each chunk in the value and column arrays
+  std::vector<int> d_chunk;
+  /// width of each chunk
+  std::vector<int> d_width;
+  /// original row for each chunk slot, with -1 for padding rows
+  std::vector<int> d_row;
+  /// number of nonzeros in the original matrix
+  int d_nnz;
+
+};
+
+CALLOW_TEMPLATE_EXPORT(detran_utilities::SP<MatrixSELL>)
+
+} // end namespace callow
+
+//----------------------------------------------------------------------------//
+// INLINE FUNCTIONS
+//----------------------------------------------------------------------------//
+
+#include "MatrixSELL.i.hh"
+
+#endif /* callow_MATRIXSELL_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of MatrixSELL.hh
+//----------------------------------------------------------------------------//
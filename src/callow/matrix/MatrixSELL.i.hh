@@ -0,0 +1,76 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  MatrixSELL.i.hh
+ *  @brief MatrixSELL inline member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef callow_MATRIXSELL_I_HH_
+#define callow_MATRIXSELL_I_HH_
+
+namespace callow
+{
+
+//----------------------------------------------------------------------------//
+inline void MatrixSELL::multiply(const Vector &x, Vector &y)
+{
+  Require(d_is_ready);
+  Require(x.size() == d_n);
+  Require(y.size() == d_m);
+
+  const double *xx = &x[0];
+  double       *yy = &y[0];
+  const double *v  = d_m ? &d_values[0]  : NULL;
+  const int    *c  = d_m ? &d_columns[0] : NULL;
+
+  #pragma omp parallel for schedule(static) default(shared)
+  for (int k = 0; k < number_chunks(); ++k)
+  {
+    double temp[chunk_size] = {0.0};
+    for (int w = 0; w < d_width[k]; ++w)
+    {
+      int p = d_chunk[k] + w * chunk_size;
+      for (int r = 0; r < chunk_size; ++r)
+        temp[r] += v[p + r] * xx[c[p + r]];
+    }
+    for (int r = 0; r < chunk_size; ++r)
+    {
+      int i = d_row[k * chunk_size + r];
+      if (i >= 0) yy[i] = temp[r];
+    }
+  }
+}
+
+//----------------------------------------------------------------------------//
+inline void MatrixSELL::multiply_transpose(const Vector &x, Vector &y)
+{
+  Require(d_is_ready);
+  Require(x.size() == d_m);
+  Require(y.size() == d_n);
+
+  // the scatter into y is done serially to avoid write conflicts;
+  // padded entries are zero and so add nothing
+  y.scale(0);
+  for (int k = 0; k < number_chunks(); ++k)
+  {
+    for (int r = 0; r < chunk_size; ++r)
+    {
+      int i = d_row[k * chunk_size + r];
+      if (i < 0) continue;
+      for (int w = 0; w < d_width[k]; ++w)
+      {
+        int p = d_chunk[k] + w * chunk_size + r;
+        y[d_columns[p]] += d_values[p] * x[i];
+      }
+    }
+  }
+}
+
+} // end namespace callow
+
+#endif /* callow_MATRIXSELL_I_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of MatrixSELL.i.hh
+//----------------------------------------------------------------------------//
@@ -0,0 +1,389 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  PCAMG.cc
+ *  @brief PCAMG member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "PCAMG.hh"
+#include "PCILUT.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace callow
+{
+
+namespace
+{
+
+typedef std::vector<std::vector<int> >    rows_int;
+typedef std::vector<std::vector<double> > rows_dbl;
+
+//----------------------------------------------------------------------------//
+/// Assemble an m x n matrix from its rows
+Matrix::SP_matrix build_matrix(const int m, const int n,
+                               rows_int &cols, rows_dbl &vals)
+{
+  std::vector<int> nnz(m);
+  for (int i = 0; i < m; ++i)
+    nnz[i] = std::max(1, (int)cols[i].size());
+  Matrix::SP_matrix A(new Matrix(m, n));
+  A->preallocate(&nnz[0]);
+  for (int i = 0; i < m; ++i)
+  {
+    // assembly requires every row to have an entry
+    if (cols[i].size())
+      A->insert(i, &cols[i][0], &vals[i][0], cols[i].size());
+    else
+      A->insert(i, std::min(i, n - 1), 0.0);
+  }
+  A->assemble();
+  return A;
+}
+
+//----------------------------------------------------------------------------//
+/// Sparse product C = A * B, computed by rows
+Matrix::SP_matrix multiply(Matrix &A, Matrix &B)
+{
+  int m = A.number_rows();
+  int n = B.number_columns();
+  rows_int cols(m);
+  rows_dbl vals(m);
+  #pragma omp parallel default(shared)
+  {
+    std::vector<double> w(n, 0.0);
+    std::vector<int>    marker(n, -1);
+    #pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < m; ++i)
+    {
+      for (int p = A.start(i); p < A.end(i); ++p)
+      {
+        int    k = A.columns()[p];
+        double a = A.values()[p];
+        for (int q = B.start(k); q < B.end(k); ++q)
+        {
+          int j = B.columns()[q];
+          if (marker[j] != i)
+          {
+            marker[j] = i;
+            w[j] = 0.0;
+            cols[i].push_back(j);
+          }
+          w[j] += a * B.values()[q];
+        }
+      }
+      std::sort(cols[i].begin(), cols[i].end());
+      vals[i].resize(cols[i].size());
+      for (int c = 0; c < cols[i].size(); ++c)
+        vals[i][c] = w[cols[i][c]];
+    }
+  }
+  return build_matrix(m, n, cols, vals);
+}
+
+//----------------------------------------------------------------------------//
+/// Transpose of A
+Matrix::SP_matrix transpose(Matrix &A)
+{
+  int n = A.number_columns();
+  rows_int cols(n);
+  rows_dbl vals(n);
+  for (int i = 0; i < A.number_rows(); ++i)
+  {
+    for (int p = A.start(i); p < A.end(i); ++p)
+    {
+      cols[A.columns()[p]].push_back(i);
+      vals[A.columns()[p]].push_back(A.values()[p]);
+    }
+  }
+  return build_matrix(n, A.number_rows(), cols, vals);
+}
+
+//----------------------------------------------------------------------------//
+/// y <-- A * x, or y <-- y + A * x if add
+void spmv(Matrix &A, const double *x, double *y, const bool add)
+{
+  const int    *r = A.rows();
+  const int    *c = A.columns();
+  const double *v = A.values();
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < A.number_rows(); ++i)
+  {
+    double temp = add ? y[i] : 0.0;
+    for (int p = r[i]; p < r[i + 1]; ++p)
+      temp += v[p] * x[c[p]];
+    y[i] = temp;
+  }
+}
+
+//----------------------------------------------------------------------------//
+/// r <-- b - A * x
+void residual(Matrix &A, const double *b, const double *x, double *r)
+{
+  const int    *rr = A.rows();
+  const int    *c  = A.columns();
+  const double *v  = A.values();
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < A.number_rows(); ++i)
+  {
+    double temp = b[i];
+    for (int p = rr[i]; p < rr[i + 1]; ++p)
+      temp -= v[p] * x[c[p]];
+    r[i] = temp;
+  }
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------//
+PCAMG::PCAMG(SP_matrix    A,
+             const double strength,
+             const int    sweeps,
+             const double omega,
+             const int    coarse_size,
+             const int    max_levels)
+  : Base("PCAMG")
+  , d_strength(strength)
+  , d_sweeps(sweeps)
+  , d_omega(omega)
+{
+  Require(A);
+  Require(A->number_rows() == A->number_columns());
+  Require(d_strength >= 0.0);
+  Require(d_sweeps > 0);
+  Require(max_levels > 0);
+  Insist(dynamic_cast<Matrix*>(A.bp()),
+    "Need an explicit matrix for use with PCAMG");
+
+  d_size = A->number_rows();
+
+  // build the hierarchy
+  d_A.push_back(SP_matrixfull(A));
+  while (d_A.back()->number_rows() > coarse_size &&
+         d_A.size() < max_levels)
+  {
+    if (!coarsen(d_A.size() - 1)) break;
+  }
+
+  // level vectors and smoother diagonals
+  int number_levels = d_A.size();
+  d_inverse_diagonal.resize(number_levels - 1);
+  for (int l = 0; l < number_levels; ++l)
+  {
+    int n = d_A[l]->number_rows();
+    d_b.push_back(SP_vector(new Vector(n, 0.0)));
+    d_x.push_back(SP_vector(new Vector(n, 0.0)));
+    d_r.push_back(SP_vector(new Vector(n, 0.0)));
+    if (l == number_levels - 1) break;
+    d_inverse_diagonal[l].resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+      double d = d_A[l]->values()[d_A[l]->diagonal(i)];
+      Insist(d != 0.0, "PCAMG requires a nonzero diagonal");
+      d_inverse_diagonal[l][i] = 1.0 / d;
+    }
+  }
+
+  // exact factorization of the coarsest operator
+  d_coarse_solver = new PCILUT(SP_matrix(d_A.back()), 0.0, -1, -1);
+}
+
+//----------------------------------------------------------------------------//
+PCAMG::SP_preconditioner PCAMG::Create(SP_matrix A)
+{
+  SP_preconditioner p(new PCAMG(A));
+  return p;
+}
+
+//----------------------------------------------------------------------------//
+void PCAMG::apply(Vector &b, Vector &x)
+{
+  Require(b.size() == d_size);
+  Require(x.size() == d_size);
+  d_b[0]->copy(b);
+  cycle(0);
+  x.copy(*d_x[0]);
+}
+
+//----------------------------------------------------------------------------//
+void PCAMG::display_hierarchy() const
+{
+  printf(" AMG hierarchy \n");
+  printf(" ---------------------------\n");
+  int nnz_0 = d_A[0]->number_nonzeros();
+  int nnz   = 0;
+  for (int l = 0; l < d_A.size(); ++l)
+  {
+    printf("  level %2i: rows = %8i, nonzeros = %10i \n",
+           l, d_A[l]->number_rows(), d_A[l]->number_nonzeros());
+    nnz += d_A[l]->number_nonzeros();
+  }
+  printf("  operator complexity = %8.4f \n\n", double(nnz) / nnz_0);
+}
+
+//----------------------------------------------------------------------------//
+bool PCAMG::coarsen(const int l)
+{
+  Matrix &A = *d_A[l];
+  int n = A.number_rows();
+  const int    *c = A.columns();
+  const double *v = A.values();
+
+  // strong connections
+  std::vector<char> strong(A.number_nonzeros(), 0);
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < n; ++i)
+  {
+    double a_ii = std::abs(v[A.diagonal(i)]);
+    for (int p = A.start(i); p < A.end(i); ++p)
+    {
+      int j = c[p];
+      if (j == i) continue;
+      double a_jj = std::abs(v[A.diagonal(j)]);
+      if (std::abs(v[p]) >= d_strength * std::sqrt(a_ii * a_jj))
+        strong[p] = 1;
+    }
+  }
+
+  // aggregation, first from nodes whose strong neighborhood is free
+  std::vector<int> agg(n, -1);
+  int number_aggregates = 0;
+  for (int i = 0; i < n; ++i)
+  {
+    if (agg[i] != -1) continue;
+    bool free = true;
+    for (int p = A.start(i); p < A.end(i) && free; ++p)
+      if (strong[p] && agg[c[p]] != -1) free = false;
+    if (!free) continue;
+    agg[i] = number_aggregates;
+    for (int p = A.start(i); p < A.end(i); ++p)
+      if (strong[p]) agg[c[p]] = number_aggregates;
+    ++number_aggregates;
+  }
+  // then leftovers join a neighboring aggregate from the first pass
+  std::vector<int> agg_first(agg);
+  for (int i = 0; i < n; ++i)
+  {
+    if (agg[i] != -1) continue;
+    for (int p = A.start(i); p < A.end(i); ++p)
+    {
+      if (strong[p] && agg_first[c[p]] != -1)
+      {
+        agg[i] = agg_first[c[p]];
+        break;
+      }
+    }
+  }
+  // and the rest form aggregates with their free neighbors
+  for (int i = 0; i < n; ++i)
+  {
+    if (agg[i] != -1) continue;
+    agg[i] = number_aggregates;
+    for (int p = A.start(i); p < A.end(i); ++p)
+      if (strong[p] && agg[c[p]] == -1) agg[c[p]] = number_aggregates;
+    ++number_aggregates;
+  }
+  if (number_aggregates >= n) return false;
+
+  // filtered diagonal and the Gershgorin bound on rho(inv(D_F) * A_F)
+  std::vector<double> diag_F(n, 0.0);
+  std::vector<double> rho_i(n, 0.0);
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < n; ++i)
+  {
+    double d = 0.0;
+    double s = 0.0;
+    for (int p = A.start(i); p < A.end(i); ++p)
+    {
+      if (c[p] == i || !strong[p])
+        d += v[p];
+      else
+        s += std::abs(v[p]);
+    }
+    diag_F[i] = d;
+    rho_i[i] = d != 0.0 ? 1.0 + s / std::abs(d) : 1.0;
+  }
+  double rho = *std::max_element(rho_i.begin(), rho_i.end());
+  double omega = 4.0 / (3.0 * rho);
+
+  // smoothed prolongator P = (I - omega * inv(D_F) * A_F) * P_0
+  rows_int cols(n);
+  rows_dbl vals(n);
+  #pragma omp parallel for schedule(static)
+  for (int i = 0; i < n; ++i)
+  {
+    double scale = diag_F[i] != 0.0 ? omega / diag_F[i] : 0.0;
+    cols[i].push_back(agg[i]);
+    vals[i].push_back(1.0 - scale * diag_F[i]);
+    for (int p = A.start(i); p < A.end(i); ++p)
+    {
+      if (c[p] == i || !strong[p]) continue;
+      int J = agg[c[p]];
+      int k = 0;
+      while (k < cols[i].size() && cols[i][k] != J) ++k;
+      if (k == cols[i].size())
+      {
+        cols[i].push_back(J);
+        vals[i].push_back(0.0);
+      }
+      vals[i][k] -= scale * v[p];
+    }
+  }
+  SP_matrixfull P = build_matrix(n, number_aggregates, cols, vals);
+  SP_matrixfull R = transpose(*P);
+  SP_matrixfull AP = multiply(A, *P);
+  d_P.push_back(P);
+  d_R.push_back(R);
+  d_A.push_back(multiply(*R, *AP));
+  return true;
+}
+
+//----------------------------------------------------------------------------//
+void PCAMG::cycle(const int l)
+{
+  if (l == d_A.size() - 1)
+  {
+    d_coarse_solver->apply(*d_b[l], *d_x[l]);
+    return;
+  }
+  smooth(l, true);
+  residual(*d_A[l], &(*d_b[l])[0], &(*d_x[l])[0], &(*d_r[l])[0]);
+  spmv(*d_R[l], &(*d_r[l])[0], &(*d_b[l + 1])[0], false);
+  cycle(l + 1);
+  spmv(*d_P[l], &(*d_x[l + 1])[0], &(*d_x[l])[0], true);
+  smooth(l, false);
+}
+
+//----------------------------------------------------------------------------//
+void PCAMG::smooth(const int l, const bool zero)
+{
+  Matrix &A = *d_A[l];
+  int n = A.number_rows();
+  const double *dinv = &d_inverse_diagonal[l][0];
+  const double *b = &(*d_b[l])[0];
+  double *x = &(*d_x[l])[0];
+  double *r = &(*d_r[l])[0];
+  for (int s = 0; s < d_sweeps; ++s)
+  {
+    // the first sweep from a zero guess is just a scaled copy of b
+    if (s == 0 && zero)
+    {
+      #pragma omp parallel for schedule(static)
+      for (int i = 0; i < n; ++i)
+        x[i] = d_omega * dinv[i] * b[i];
+      continue;
+    }
+    residual(A, b, x, r);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+      x[i] += d_omega * dinv[i] * r[i];
+  }
+}
+
+} // end namespace callow
+
+//----------------------------------------------------------------------------//
+//              end of file PCAMG.cc
+//----------------------------------------------------------------------------//
@@ -0,0 +1,149 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  PCAMG.hh
+ *  @brief PCAMG class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef callow_PCAMG_HH_
+#define callow_PCAMG_HH_
+
+#include "Preconditioner.hh"
+#include "callow/matrix/Matrix.hh"
+#include <vector>
+
+namespace callow
+{
+
+/**
+ *  @class PCAMG
+ *  @brief Smoothed aggregation algebraic multigrid preconditioner
+ *
+ *  The hierarchy is built following Vanek, Mandel, and Brezina:
+ *
+ *    1. An entry is a strong connection if
+ *       \f$ |a_{ij}| \ge \theta \sqrt{|a_{ii} a_{jj}|} \f$.
+ *    2. Nodes are grouped into aggregates of strongly-connected
+ *       neighborhoods, with leftover nodes joining an adjacent aggregate.
+ *    3. The piecewise-constant tentative prolongator is smoothed by one
+ *       damped Jacobi step with the filtered operator (weak entries
+ *       lumped onto the diagonal), \f$ P = (I - \omega D^{-1} A_F) P_0 \f$,
+ *       where \f$ \omega = 4/(3\rho) \f$ and \f$ \rho \f$ is the
+ *       Gershgorin bound on the spectral radius of \f$ D^{-1} A_F \f$.
+ *    4. The coarse operator is the Galerkin product \f$ P^T A P \f$.
+ *
+ *  Coarsening stops when the operator is small enough, the maximum
+ *  number of levels is reached, or aggregation stops reducing the size.
+ *  The coarsest level is solved exactly with a complete @ref PCILUT
+ *  factorization.
+ *
+ *  Each application is one V-cycle with a zero initial guess and damped
+ *  Jacobi smoothing, so the preconditioner is a fixed linear operator.
+ *  The strength, prolongator, and product computations of the setup and
+ *  all kernels of the cycle are threaded by rows; only the aggregation
+ *  is serial.
+ */
+
+class CALLOW_EXPORT PCAMG: public Preconditioner
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef Preconditioner                    Base;
+  typedef Base::SP_preconditioner           SP_preconditioner;
+  typedef MatrixBase::SP_matrix             SP_matrix;
+  typedef Matrix::SP_matrix                 SP_matrixfull;
+  typedef Vector::SP_vector                 SP_vector;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param A            explicit matrix
+   *  @param strength     strength of connection threshold theta
+   *  @param sweeps       pre- and post-smoothing sweeps per level
+   *  @param omega        damping factor for the Jacobi smoother
+   *  @param coarse_size  stop coarsening at or below this size
+   *  @param max_levels   maximum number of levels, including the finest
+   */
+  PCAMG(SP_matrix    A,
+        const double strength    = 0.08,
+        const int    sweeps      = 2,
+        const double omega       = 2.0 / 3.0,
+        const int    coarse_size = 100,
+        const int    max_levels  = 10);
+
+  /// SP constructor
+  static SP_preconditioner Create(SP_matrix A);
+
+  /// Virtual destructor
+  virtual ~PCAMG(){};
+
+  //--------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL PRECONDITIONERS MUST IMPLEMENT THIS
+  //--------------------------------------------------------------------------//
+
+  /// Solve Px = b with one V-cycle
+  void apply(Vector &b, Vector &x);
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /// Number of levels in the hierarchy
+  int number_levels() const { return d_A.size(); }
+  /// Operator on a level
+  SP_matrixfull level_operator(const int l) const { return d_A[l]; }
+  /// Print the hierarchy
+  void display_hierarchy() const;
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Operators, prolongators, and restrictions by level
+  std::vector<SP_matrixfull> d_A;
+  std::vector<SP_matrixfull> d_P;
+  std::vector<SP_matrixfull> d_R;
+  /// Inverse diagonals by level
+  std::vector<std::vector<double> > d_inverse_diagonal;
+  /// Right hand sides, solutions, and work vectors by level
+  std::vector<SP_vector> d_b;
+  std::vector<SP_vector> d_x;
+  std::vector<SP_vector> d_r;
+  /// Exact solver for the coarsest level
+  SP_preconditioner d_coarse_solver;
+  /// Parameters
+  double d_strength;
+  int d_sweeps;
+  double d_omega;
+
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  /// Build the prolongator from level l, returning false if not useful
+  bool coarsen(const int l);
+  /// V-cycle on level l for d_b[l] into d_x[l]
+  void cycle(const int l);
+  /// Damped Jacobi sweeps on level l, starting from x = 0 if zero
+  void smooth(const int l, const bool zero);
+
+};
+
+} // end namespace callow
+
+#endif // callow_PCAMG_HH_
+
+//----------------------------------------------------------------------------//
+//              end of file PCAMG.hh
+//----------------------------------------------------------------------------//
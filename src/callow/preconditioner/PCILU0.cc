@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------//
 
 #include "PCILU0.hh"
+#include <algorithm>
 
 namespace callow
 {
@@ -14,6 +15,7 @@ namespace callow
 //----------------------------------------------------------------------------//
 PCILU0::PCILU0(SP_matrix A)
   : Base("PCILU0")
+  , d_level_scheduled(false)
 {
   Require(A);
   Require(A->number_rows() == A->number_columns());
@@ -54,8 +56,9 @@ PCILU0::PCILU0(SP_matrix A)
   {
 
     // pre-store the column pointers for this row.  if
-    // the column isn't present, the value remains -1
-    for (int p = d_P->start(i); p < d_P->diagonal(i); ++p)
+    // the column isn't present, the value remains -1.  the whole
+    // row is needed, since the diagonal and upper entries are updated
+    for (int p = d_P->start(i); p < d_P->end(i); ++p)
       iw[d_P->column(p)] = p;
 
     // loop through the columns
@@ -82,15 +85,21 @@ PCILU0::PCILU0(SP_matrix A)
     }
 
     // reset
-    for (int p = d_P->start(i); p < d_P->diagonal(i); ++p)
+    for (int p = d_P->start(i); p < d_P->end(i); ++p)
       iw[d_P->column(p)] = -1;
   }
 
   delete [] iw;
 
-  // size the working vector
-  d_y.resize(d_P->number_rows(), 0.0);
+  setup_levels();
+}
 
+//----------------------------------------------------------------------------//
+PCILU0::PCILU0(std::string name)
+  : Base(name)
+  , d_level_scheduled(false)
+{
+  /* derived classes build d_P and then call setup_levels */
 }
 
 //----------------------------------------------------------------------------//
@@ -100,6 +109,67 @@ PCILU0::SP_preconditioner PCILU0::Create(SP_matrix A)
   return p;
 }
 
+//----------------------------------------------------------------------------//
+void PCILU0::setup_levels()
+{
+  Require(d_P);
+  int n = d_P->number_rows();
+
+  // minimum average number of rows per level for which the scheduled
+  // solves are expected to beat the serial ones
+  const int min_rows_per_level = 64;
+
+  // level of each row, and the number of rows in each level
+  std::vector<int> level(n, 0);
+  std::vector<int> count;
+
+  for (int t = 0; t < 2; ++t)
+  {
+    bool lower = (t == 0);
+    std::vector<int> &ptr = lower ? d_lower_level : d_upper_level;
+    std::vector<int> &row = lower ? d_lower_row   : d_upper_row;
+
+    // row i of L depends on rows k < i, and row i of U on rows k > i, so
+    // the levels are found in one pass in the direction of the solve
+    int number_levels = 0;
+    for (int ii = 0; ii < n; ++ii)
+    {
+      int i = lower ? ii : n - 1 - ii;
+      int b = lower ? d_P->start(i) : d_P->diagonal(i) + 1;
+      int e = lower ? d_P->diagonal(i) : d_P->end(i);
+      int l = 0;
+      for (int p = b; p < e; ++p)
+        l = std::max(l, level[d_P->column(p)] + 1);
+      level[i] = l;
+      number_levels = std::max(number_levels, l + 1);
+    }
+
+    // bucket the rows by level, keeping the solve order within each
+    count.assign(number_levels + 1, 0);
+    for (int i = 0; i < n; ++i)
+      ++count[level[i] + 1];
+    for (int l = 0; l < number_levels; ++l)
+      count[l + 1] += count[l];
+    ptr = count;
+    row.resize(n);
+    for (int ii = 0; ii < n; ++ii)
+    {
+      int i = lower ? ii : n - 1 - ii;
+      row[count[level[i]]++] = i;
+    }
+  }
+
+  int number_levels = std::max(d_lower_level.size(),
+                               d_upper_level.size()) - 1;
+  d_level_scheduled = (n >= min_rows_per_level * number_levels);
+#ifndef DETRAN_ENABLE_OPENMP
+  d_level_scheduled = false;
+#endif
+
+  // size the working vector
+  d_y.resize(n, 0.0);
+}
+
 } // end namespace callow
 
 //----------------------------------------------------------------------------//
@@ -11,6 +11,7 @@
 
 #include "Preconditioner.hh"
 #include "callow/matrix/Matrix.hh"
+#include <vector>
 
 namespace callow
 {
@@ -34,6 +35,14 @@ namespace callow
  *      end
  *    end
  *  @endcode
+ *
+ *  The triangular solves are level scheduled.  The rows of L (and of U)
+ *  are grouped into levels such that each row depends only on rows of
+ *  earlier levels, and the rows of a level are solved concurrently.
+ *  When the levels are too thin to pay for the synchronization (e.g. a
+ *  1-D stencil), the solves fall back to the plain serial loops.  Since
+ *  each row is computed by exactly the same sequence of operations in
+ *  either case, the result does not depend on the number of threads.
  */
 
 class CALLOW_EXPORT PCILU0: public Preconditioner
@@ -73,10 +82,37 @@ public:
 
 protected:
 
-  /// ILU decomposition of A
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// ILU decomposition of A, with unit L stored below the diagonal
   SP_matrixfull d_P;
   /// Working vector
   Vector d_y;
+  /// Level pointers and rows for the forward (L) solve
+  std::vector<int> d_lower_level;
+  std::vector<int> d_lower_row;
+  /// Level pointers and rows for the backward (U) solve
+  std::vector<int> d_upper_level;
+  std::vector<int> d_upper_row;
+  /// Use the level scheduled solves
+  bool d_level_scheduled;
+
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  /// Constructor for derived factorizations that build d_P themselves
+  PCILU0(std::string name);
+
+  /// Build the level schedules from the structure of d_P and size d_y
+  void setup_levels();
+
+  /// Forward solve of row i
+  inline void solve_lower(const int i, const Vector &b);
+  /// Backward solve of row i
+  inline void solve_upper(const int i, Vector &x);
 
 };
 
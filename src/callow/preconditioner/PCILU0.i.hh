@@ -15,52 +15,67 @@
 namespace callow
 {
 
-//---------------------------------------------------------------------------/
-inline void PCILU0::apply(Vector &b, Vector &x)
+//---------------------------------------------------------------------------//
+inline void PCILU0::solve_lower(const int i, const Vector &b)
 {
-  // solve LUx = x --> x = inv(U)*inv(L)*x
-
   // forward substitution
-  //   for i = 0:m-1
-  //     x[i] = 1/L[i,i] * ( b[i] - sum(k=0:i-1, L[i,k]*y[k]) )
-  // but note that in our ILU(0) scheme, L is *unit* lower triangle,
+  //   x[i] = 1/L[i,i] * ( b[i] - sum(k=0:i-1, L[i,k]*y[k]) )
+  // but note that in our ILU scheme, L is *unit* lower triangle,
   // meaning L has ones on the diagonal (whereas U does not)
-  for (int i = 0; i < d_P->number_rows(); ++i)
+  const double *v = d_P->values();
+  double y = b[i];
+  for (int p = d_P->start(i); p < d_P->diagonal(i); ++p)
+    y -= v[p] * d_y[d_P->column(p)];
+  d_y[i] = y;
+}
+
+//---------------------------------------------------------------------------//
+inline void PCILU0::solve_upper(const int i, Vector &x)
+{
+  // backward substitution
+  //   x[i] = 1/U[i,i] * ( y[i] - sum(k=i+1:m-1, U[i,k]*x[k]) )
+  const double *v = d_P->values();
+  int d = d_P->diagonal(i);
+  double y = d_y[i];
+  for (int p = d + 1; p < d_P->end(i); ++p)
+    y -= v[p] * x[d_P->column(p)];
+  x[i] = y / v[d];
+}
+
+//---------------------------------------------------------------------------//
+inline void PCILU0::apply(Vector &b, Vector &x)
+{
+  // solve LUx = b --> x = inv(U)*inv(L)*b
+  int n = d_P->number_rows();
+
+  if (!d_level_scheduled)
   {
-    // start index
-    int s = d_P->start(i);
-    // diagonal index
-    int d = d_P->diagonal(i);
-    // invert row
-    d_y[i] = b[i];
-    for (int p = s; p < d; ++p)
-    {
-      // column index
-      int c = d_P->column(p);
-      d_y[i] -= d_P->values()[p] * d_y[c];
-    }
+    for (int i = 0; i < n; ++i)
+      solve_lower(i, b);
+    for (int i = n - 1; i >= 0; --i)
+      solve_upper(i, x);
+    return;
   }
 
-  // backward substitution
-  //   for i = m-1:0
-  //     y[i] = 1/U[i,i] * ( b[i] - sum(k=i+1:m-1, U[i,k]*y[k]) )
-  for (int i = d_P->number_rows() - 1; i >= 0; --i)
+  // rows within a level are independent; the implicit barrier at the
+  // end of each loop separates the levels
+  int number_lower = d_lower_level.size() - 1;
+  int number_upper = d_upper_level.size() - 1;
+  #pragma omp parallel default(shared)
   {
-    // diagonal index
-    int d = d_P->diagonal(i);
-    // end index
-    int e = d_P->end(i);
-    // invert row
-    x[i] = d_y[i];
-    for (int p = d; p < e; ++p)
+    for (int l = 0; l < number_lower; ++l)
     {
-      // column index
-      int c = d_P->column(p);
-      x[i] -= d_P->values()[p] * x[c];
+      #pragma omp for schedule(static)
+      for (int r = d_lower_level[l]; r < d_lower_level[l + 1]; ++r)
+        solve_lower(d_lower_row[r], b);
+    }
+    for (int l = 0; l < number_upper; ++l)
+    {
+      #pragma omp for schedule(static)
+      for (int r = d_upper_level[l]; r < d_upper_level[l + 1]; ++r)
+        solve_upper(d_upper_row[r], x);
     }
-    x[i] /= d_P->values()[d];
   }
-
 }
 
 } // end namespace detran
@@ -0,0 +1,225 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  PCILUT.cc
+ *  @brief PCILUT member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "PCILUT.hh"
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace callow
+{
+
+namespace
+{
+
+/// Orders columns by decreasing magnitude of the work row, then by index
+struct larger_entry
+{
+  larger_entry(const std::vector<double> &w) : d_w(w) {}
+  bool operator()(const int a, const int b) const
+  {
+    double wa = std::abs(d_w[a]);
+    double wb = std::abs(d_w[b]);
+    return wa > wb || (wa == wb && a < b);
+  }
+  const std::vector<double> &d_w;
+};
+
+/// Drop entries below tau and keep at most fill of the rest, sorted
+void select_entries(std::vector<int>         &cols,
+                    const std::vector<double> &w,
+                    const double              tau,
+                    const int                 fill)
+{
+  if (tau > 0.0)
+  {
+    int n = 0;
+    for (int c = 0; c < cols.size(); ++c)
+      if (std::abs(w[cols[c]]) >= tau) cols[n++] = cols[c];
+    cols.resize(n);
+  }
+  if (fill >= 0 && cols.size() > fill)
+  {
+    std::nth_element(cols.begin(), cols.begin() + fill, cols.end(),
+                     larger_entry(w));
+    cols.resize(fill);
+  }
+  std::sort(cols.begin(), cols.end());
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------//
+PCILUT::PCILUT(SP_matrix    A,
+               const double tolerance,
+               const int    fill,
+               const int    level)
+  : Base("PCILUT")
+  , d_tolerance(tolerance)
+  , d_fill(fill)
+  , d_level(level)
+{
+  Require(A);
+  Require(A->number_rows() == A->number_columns());
+  Require(d_tolerance >= 0.0);
+  Insist(dynamic_cast<Matrix*>(A.bp()),
+    "Need an explicit matrix for use with PCILUT");
+  SP_matrixfull B(A);
+
+  int n = B->number_rows();
+  d_size = n;
+
+  // factored rows: the strictly lower part of L and, diagonal first, U
+  std::vector<std::vector<int> >    L_col(n), U_col(n), U_lev(n);
+  std::vector<std::vector<double> > L_val(n), U_val(n);
+
+  // dense work row, levels of its entries, and its nonzero pattern
+  std::vector<double> w(n, 0.0);
+  std::vector<int>    lev(n, 0);
+  std::vector<bool>   nonzero(n, false);
+  std::set<int>       lower;
+  std::vector<int>    upper;
+  std::vector<int>    kept;
+
+  for (int i = 0; i < n; ++i)
+  {
+    // scatter row i of A into the work row
+    double norm = 0.0;
+    for (int p = B->start(i); p < B->end(i); ++p)
+    {
+      int j = B->column(p);
+      double v = B->values()[p];
+      w[j] = v;
+      lev[j] = 0;
+      nonzero[j] = true;
+      norm += v * v;
+      if (j < i)
+        lower.insert(j);
+      else
+        upper.push_back(j);
+    }
+    double tau = d_tolerance * std::sqrt(norm);
+
+    // eliminate the lower entries in increasing column order, including
+    // any fill that lands below the diagonal along the way
+    kept.clear();
+    while (!lower.empty())
+    {
+      int k = *lower.begin();
+      lower.erase(lower.begin());
+
+      double wk = w[k] / U_val[k][0];
+      if (tau > 0.0 && std::abs(wk) < tau)
+      {
+        w[k] = 0.0;
+        nonzero[k] = false;
+        continue;
+      }
+      w[k] = wk;
+      kept.push_back(k);
+
+      for (int q = 1; q < U_col[k].size(); ++q)
+      {
+        int j = U_col[k][q];
+        int l = lev[k] + U_lev[k][q] + 1;
+        if (nonzero[j])
+        {
+          w[j] -= wk * U_val[k][q];
+          lev[j] = std::min(lev[j], l);
+        }
+        else
+        {
+          if (d_level >= 0 && l > d_level) continue;
+          w[j] = -wk * U_val[k][q];
+          lev[j] = l;
+          nonzero[j] = true;
+          if (j < i)
+            lower.insert(j);
+          else
+            upper.push_back(j);
+        }
+      }
+    }
+
+    // apply the dropping rules to each part of the row.  the full lists
+    // are kept so that the work row can be reset afterward.
+    std::vector<int> strict_lower(kept);
+    select_entries(strict_lower, w, 0.0, d_fill);
+    std::vector<int> offdiag;
+    for (int c = 0; c < upper.size(); ++c)
+      if (upper[c] != i) offdiag.push_back(upper[c]);
+    select_entries(offdiag, w, tau, d_fill);
+
+    if (!nonzero[i] || w[i] == 0.0)
+    {
+      THROW("ZERO PIVOT IN ILUT");
+    }
+
+    // store the row
+    L_col[i] = strict_lower;
+    L_val[i].resize(strict_lower.size());
+    for (int c = 0; c < strict_lower.size(); ++c)
+      L_val[i][c] = w[strict_lower[c]];
+    U_col[i].resize(offdiag.size() + 1);
+    U_val[i].resize(offdiag.size() + 1);
+    U_lev[i].resize(offdiag.size() + 1);
+    U_col[i][0] = i;
+    U_val[i][0] = w[i];
+    U_lev[i][0] = lev[i];
+    for (int c = 0; c < offdiag.size(); ++c)
+    {
+      U_col[i][c + 1] = offdiag[c];
+      U_val[i][c + 1] = w[offdiag[c]];
+      U_lev[i][c + 1] = lev[offdiag[c]];
+    }
+
+    // reset the work row
+    for (int c = 0; c < kept.size(); ++c)
+    {
+      w[kept[c]] = 0.0;
+      nonzero[kept[c]] = false;
+    }
+    for (int c = 0; c < upper.size(); ++c)
+    {
+      w[upper[c]] = 0.0;
+      nonzero[upper[c]] = false;
+    }
+    upper.clear();
+  }
+
+  // assemble L and U into a single matrix laid out as for PCILU0
+  std::vector<int> nnz(n);
+  for (int i = 0; i < n; ++i)
+    nnz[i] = L_col[i].size() + U_col[i].size();
+  d_P = new Matrix(n, n);
+  d_P->preallocate(&nnz[0]);
+  for (int i = 0; i < n; ++i)
+  {
+    if (L_col[i].size())
+      d_P->insert(i, &L_col[i][0], &L_val[i][0], L_col[i].size());
+    d_P->insert(i, &U_col[i][0], &U_val[i][0], U_col[i].size());
+  }
+  d_P->assemble();
+
+  setup_levels();
+}
+
+//----------------------------------------------------------------------------//
+PCILUT::SP_preconditioner
+PCILUT::Create(SP_matrix A, const double tolerance,
+               const int fill, const int level)
+{
+  SP_preconditioner p(new PCILUT(A, tolerance, fill, level));
+  return p;
+}
+
+} // end namespace callow
+
+//----------------------------------------------------------------------------//
+//              end of file PCILUT.cc
+//----------------------------------------------------------------------------//
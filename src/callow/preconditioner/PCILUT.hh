@@ -0,0 +1,101 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  PCILUT.hh
+ *  @brief PCILUT class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef callow_PCILUT_HH_
+#define callow_PCILUT_HH_
+
+#include "PCILU0.hh"
+
+namespace callow
+{
+
+/**
+ *  @class PCILUT
+ *  @brief Implements the ILU(k) and ILUT preconditioners
+ *
+ *  The factorization is computed row by row in the IKJ ordering of
+ *  Saad (ch. 10), with a dense work row into which fill is allowed.
+ *  Two dropping rules are supported and may be combined:
+ *
+ *    - level of fill: an entry created by eliminating (i, k) with
+ *      (k, j) gets level lev(i,k) + lev(k,j) + 1, and entries with a
+ *      level above k are never created.  With no other dropping, this
+ *      is ILU(k), and ILU(0) reproduces PCILU0.
+ *    - threshold: entries smaller than tau times the 2-norm of the
+ *      original row are dropped, after which only the p largest entries
+ *      of each of the L and U parts of the row are kept.  This is
+ *      ILUT(p, tau).
+ *
+ *  The factors are stored exactly as for PCILU0, so the (level
+ *  scheduled) triangular solves are shared.
+ */
+
+class CALLOW_EXPORT PCILUT: public PCILU0
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef PCILU0                            Base;
+  typedef Base::SP_preconditioner           SP_preconditioner;
+  typedef Base::SP_matrix                   SP_matrix;
+  typedef Base::SP_matrixfull               SP_matrixfull;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param A          explicit matrix to factor
+   *  @param tolerance  relative drop tolerance tau (zero to keep all)
+   *  @param fill       maximum entries kept in each of L and U per row
+   *                    (negative for no limit)
+   *  @param level      maximum level of fill (negative for no limit)
+   */
+  PCILUT(SP_matrix    A,
+         const double tolerance = 1.0e-3,
+         const int    fill      = 10,
+         const int    level     = -1);
+
+  /// SP constructor
+  static SP_preconditioner
+  Create(SP_matrix A, const double tolerance = 1.0e-3,
+         const int fill = 10, const int level = -1);
+
+  /// Virtual destructor
+  virtual ~PCILUT(){};
+
+  /// Number of nonzeros in the combined factors
+  int number_nonzeros() const { return d_P->number_nonzeros(); }
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Relative drop tolerance
+  double d_tolerance;
+  /// Maximum entries per row in each factor
+  int d_fill;
+  /// Maximum level of fill
+  int d_level;
+
+};
+
+} // end namespace callow
+
+#endif // callow_PCILUT_HH_
+
+//----------------------------------------------------------------------------//
+//              end of file PCILUT.hh
+//----------------------------------------------------------------------------//
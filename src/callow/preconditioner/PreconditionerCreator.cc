@@ -0,0 +1,84 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  PreconditionerCreator.cc
+ *  @brief PreconditionerCreator member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "PreconditionerCreator.hh"
+// preconditioners
+#include "PCILU0.hh"
+#include "PCILUT.hh"
+#include "PCAMG.hh"
+#include "PCJacobi.hh"
+
+namespace callow
+{
+
+//----------------------------------------------------------------------------//
+PreconditionerCreator::SP_preconditioner
+PreconditionerCreator::Create(SP_matrix A, SP_db db)
+{
+  Require(A);
+  Require(db);
+
+  SP_preconditioner P;
+
+  std::string pc_type = "";
+  if (db->check("pc_type"))
+    pc_type = db->get<std::string>("pc_type");
+
+  if (pc_type == "ilu0")
+  {
+    P = new PCILU0(A);
+  }
+  else if (pc_type == "iluk")
+  {
+    int level = 1;
+    if (db->check("pc_ilu_level"))
+      level = db->get<int>("pc_ilu_level");
+    P = new PCILUT(A, 0.0, -1, level);
+  }
+  else if (pc_type == "ilut")
+  {
+    double tolerance = 1.0e-3;
+    int fill = 10;
+    if (db->check("pc_ilut_tolerance"))
+      tolerance = db->get<double>("pc_ilut_tolerance");
+    if (db->check("pc_ilut_fill"))
+      fill = db->get<int>("pc_ilut_fill");
+    P = new PCILUT(A, tolerance, fill);
+  }
+  else if (pc_type == "amg")
+  {
+    double strength = 0.08;
+    double omega = 2.0 / 3.0;
+    int sweeps = 2;
+    int coarse_size = 100;
+    int levels = 10;
+    if (db->check("pc_amg_strength"))
+      strength = db->get<double>("pc_amg_strength");
+    if (db->check("pc_amg_omega"))
+      omega = db->get<double>("pc_amg_omega");
+    if (db->check("pc_amg_sweeps"))
+      sweeps = db->get<int>("pc_amg_sweeps");
+    if (db->check("pc_amg_coarse_size"))
+      coarse_size = db->get<int>("pc_amg_coarse_size");
+    if (db->check("pc_amg_levels"))
+      levels = db->get<int>("pc_amg_levels");
+    P = new PCAMG(A, strength, sweeps, omega, coarse_size, levels);
+  }
+  else if (pc_type == "jacobi")
+  {
+    P = new PCJacobi(A);
+  }
+
+  return P;
+}
+
+} // end namespace callow
+
+//----------------------------------------------------------------------------//
+//              end of file PreconditionerCreator.cc
+//----------------------------------------------------------------------------//
@@ -0,0 +1,67 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  PreconditionerCreator.hh
+ *  @brief PreconditionerCreator class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef callow_PRECONDITIONERCREATOR_HH_
+#define callow_PRECONDITIONERCREATOR_HH_
+
+#include "Preconditioner.hh"
+#include "callow/matrix/MatrixBase.hh"
+#include "utilities/InputDB.hh"
+
+namespace callow
+{
+
+/**
+ *  @class PreconditionerCreator
+ *  @brief Creates a callow preconditioner from a parameter database
+ *
+ *  Relevant database entries:
+ *    - pc_type [str]               (ilu0, iluk, ilut, amg, or jacobi)
+ *    - pc_ilu_level [int]          (iluk level of fill; default 1)
+ *    - pc_ilut_tolerance [dbl]     (ilut drop tolerance; default 1e-3)
+ *    - pc_ilut_fill [int]          (ilut entries per row; default 10)
+ *    - pc_amg_strength [dbl]       (see PCAMG; default 0.08)
+ *    - pc_amg_sweeps [int]         (see PCAMG; default 2)
+ *    - pc_amg_omega [dbl]          (see PCAMG; default 2/3)
+ *    - pc_amg_coarse_size [int]    (see PCAMG; default 100)
+ *    - pc_amg_levels [int]         (see PCAMG; default 10)
+ */
+class CALLOW_EXPORT PreconditionerCreator
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef Preconditioner::SP_preconditioner     SP_preconditioner;
+  typedef MatrixBase::SP_matrix                 SP_matrix;
+  typedef detran_utilities::InputDB::SP_input   SP_db;
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC METHODS
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Create a preconditioner
+   *  @param  A   Operator to precondition
+   *  @param  db  Pointer to parameter database
+   *  @return     The preconditioner, or null if pc_type names none
+   */
+  static SP_preconditioner Create(SP_matrix A, SP_db db);
+
+};
+
+} // end namespace callow
+
+#endif // callow_PRECONDITIONERCREATOR_HH_
+
+//----------------------------------------------------------------------------//
+//              end of file PreconditionerCreator.hh
+//----------------------------------------------------------------------------//
@@ -159,10 +159,9 @@ void Davidson::solve_impl(Vector &u, Vector &x0)
       // update the subspace
       d_P->apply(r, u);
       //u.display(" V = P\R");
-      for (size_t j = 0; j < i+1; ++j)
-        y1[j] = V[j].dot(u); // V'*u
-      for (size_t j = 0; j < i+1; ++j)
-        u.add_a_times_x(-y1[j], V[j]);
+      u.multi_dot(V, i+1, &y1[0]); // V'*u
+      y1.scale(-1.0);
+      u.multi_add_a_times_x(&y1[0], V, i+1);
       u.scale(1.0/u.norm());
       //u.display(" V ");
 
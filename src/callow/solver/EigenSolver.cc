@@ -8,6 +8,7 @@
 
 #include "EigenSolver.hh"
 #include "preconditioner/PCILU0.hh"
+#include "callow/matrix/MatrixSELL.hh"
 
 namespace callow
 {
@@ -38,6 +39,15 @@ void EigenSolver::set_operators(SP_matrix    A,
   d_A = A;
   Ensure(d_A->number_rows() == d_A->number_columns());
 
+  // Optionally use a SELL copy of an explicit A for the action.  The copy
+  // is a snapshot of A, so later changes to A need set_operators again.
+  Matrix *explicit_A = dynamic_cast<Matrix*>(d_A.bp());
+  if (db && explicit_A && db->check("eigen_solver_matrix_format"))
+  {
+    if (db->get<std::string>("eigen_solver_matrix_format") == "sell")
+      d_A = new MatrixSELL(*explicit_A);
+  }
+
   // Setup linear system if this is a generalized eigenproblem
   if (B)
   {
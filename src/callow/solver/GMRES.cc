@@ -15,14 +15,19 @@ namespace callow
 GMRES::GMRES(const double  atol,
              const double  rtol,
              const int     maxit,
-             const int     restart)
+             const int     restart,
+             const int     orthog)
   : LinearSolver(atol, rtol, maxit, "solver_gmres")
   , d_restart(restart)
   , d_reorthog(1)
+  , d_orthog(orthog)
+  , d_h_0(restart + 1, 0.0)
+  , d_h_1(restart + 1, 0.0)
   , d_c(restart+1, 0.0)
   , d_s(restart+1, 0.0)
 {
   Insist(d_restart > 2, "Need a restart of > 2");
+  Require(d_orthog < END_ORTHOG_TYPES);
   d_H = new double*[(restart + 1)];
   for (int i = 0; i <= d_restart; i++)
   {
@@ -155,38 +160,58 @@ void GMRES::solve_impl(const Vector &b, Vector &x0)
       }
 
       //----------------------------------------------------------------------//
-      // use modified gram-schmidt to orthogonalize v(k+1)
+      // orthogonalize v(k+1) against the basis
       //----------------------------------------------------------------------//
 
-      double norm_Av = v[k+1].norm();
-      for (int j = 0; j <= k; ++j)
+      if (d_orthog == CGS2)
       {
-        d_H[j][k] = v[k+1].dot(v[j]);
-        v[k+1].add_a_times_x(-d_H[j][k], v[j]);
+        // classical gram-schmidt, twice.  h_0 = V'*v(k+1), then
+        // v(k+1) <-- v(k+1) - V*h_0
+        v[k+1].multi_dot(v, k + 1, &d_h_0[0]);
+        for (int j = 0; j <= k; ++j)
+          d_h_0[j] = -d_h_0[j];
+        v[k+1].multi_add_a_times_x(&d_h_0[0], v, k + 1);
+        // again, with the last update fused with the norm
+        v[k+1].multi_dot(v, k + 1, &d_h_1[0]);
+        for (int j = 0; j <= k; ++j)
+        {
+          d_H[j][k] = d_h_1[j] - d_h_0[j];
+          d_h_1[j]  = -d_h_1[j];
+        }
+        d_H[k+1][k] = v[k+1].multi_add_a_times_x_norm(&d_h_1[0], v, k + 1);
       }
-      d_H[k+1][k] = v[k+1].norm(L2);
-      double norm_Av_2 = d_H[k+1][k];
-
-      //----------------------------------------------------------------------//
-      // optional reorthogonalization
-      //----------------------------------------------------------------------//
-
-      if ( (d_reorthog == 1 && norm_Av + 0.001 * norm_Av_2 == norm_Av) ||
-           (d_reorthog == 2) )
+      else
       {
-        // summarized from kelley:
-        //  if the new vector (i.e. v[k+1]) is very small relative to
-        //  A*v[k], then information might be lost so reorthogonalize.  the
-        //  delta of 0.001 is what kelley uses in his test code.
-
-        if (d_monitor_level > 1) cout << " reorthog ... " << endl;
+        // modified gram-schmidt
+        double norm_Av = v[k+1].norm();
         for (int j = 0; j < k; ++j)
         {
-          double hr = v[j].dot(v[k+1]);
-          d_H[j][k] += hr;
-          v[k+1].add_a_times_x(-hr, v[j]);
+          d_H[j][k] = v[k+1].dot(v[j]);
+          v[k+1].add_a_times_x(-d_H[j][k], v[j]);
+        }
+        // the last update is fused with the norm
+        d_H[k][k] = v[k+1].dot(v[k]);
+        d_H[k+1][k] = v[k+1].add_a_times_x_norm(-d_H[k][k], v[k]);
+        double norm_Av_2 = d_H[k+1][k];
+
+        // optional reorthogonalization
+        if ( (d_reorthog == 1 && norm_Av + 0.001 * norm_Av_2 == norm_Av) ||
+             (d_reorthog == 2) )
+        {
+          // summarized from kelley:
+          //  if the new vector (i.e. v[k+1]) is very small relative to
+          //  A*v[k], then information might be lost so reorthogonalize.  the
+          //  delta of 0.001 is what kelley uses in his test code.
+
+          if (d_monitor_level > 1) cout << " reorthog ... " << endl;
+          for (int j = 0; j < k; ++j)
+          {
+            double hr = v[j].dot(v[k+1]);
+            d_H[j][k] += hr;
+            v[k+1].add_a_times_x(-hr, v[j]);
+          }
+          d_H[k+1][k] = v[k+1].norm();
         }
-        d_H[k+1][k] = v[k+1].norm();
       }
 
       //----------------------------------------------------------------------//
@@ -42,6 +42,15 @@ namespace callow
  *  rotation for incremental conversion of the upper Hessenberg
  *  matrix \f$ H \f$ to an upper triangle matrix \f$ R \f$.
  *
+ *  The new basis vector can be orthogonalized in one of two ways.
+ *  Modified Gram-Schmidt (MGS) needs a dot product and an update per
+ *  basis vector, i.e. 2(k+1) passes over memory at step k.  Classical
+ *  Gram-Schmidt with one full reorthogonalization (CGS2) computes all
+ *  the projections at once using the fused multi-vector kernels of
+ *  @ref Vector, so each step needs four passes regardless of k, and
+ *  "twice is enough" keeps it as stable as MGS.  MGS remains the default
+ *  so that existing results are reproduced exactly; CGS2 is selected with
+ *  the linear_solver_gmres_orthog key.
  */
 class GMRES: public LinearSolver
 {
@@ -50,12 +59,18 @@ public:
 
   typedef LinearSolver Base;
 
+  /// Orthogonalization schemes
+  enum ORTHOG_TYPES
+  {
+    MGS, CGS2, END_ORTHOG_TYPES
+  };
+
   //--------------------------------------------------------------------------//
   // CONSTRUCTOR & DESTRUCTOR
   //--------------------------------------------------------------------------//
 
   GMRES(const double atol, const double rtol, const int maxit,
-        const int restart = 20);
+        const int restart = 20, const int orthog = MGS);
 
   virtual ~GMRES();
 
@@ -63,6 +78,13 @@ public:
   // PUBLIC FUNCTIONS
   //--------------------------------------------------------------------------//
 
+  /// Set the orthogonalization scheme
+  void set_orthogonalization(const int orthog)
+  {
+    Require(orthog < END_ORTHOG_TYPES);
+    d_orthog = orthog;
+  }
+
 private:
 
   //--------------------------------------------------------------------------//
@@ -83,9 +105,16 @@ private:
   /// maximum size of krylov subspace
   int d_restart;
 
-  /// reorthogonalize flag [0 = none, 1 = formula, 2 = always]
+  /// reorthogonalize flag for MGS [0 = none, 1 = formula, 2 = always]
   int d_reorthog;
 
+  /// orthogonalization scheme
+  int d_orthog;
+
+  /// projections for the two CGS2 passes [m+1]
+  std::vector<double> d_h_0;
+  std::vector<double> d_h_1;
+
   /// upper hessenberg [m+1][m], treated as dense
   double** d_H;
 
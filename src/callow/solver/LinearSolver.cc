@@ -7,9 +7,9 @@
 //----------------------------------------------------------------------------//
 
 #include "LinearSolver.hh"
+#include "callow/matrix/MatrixSELL.hh"
 // preconditioners
-#include "callow/preconditioner/PCILU0.hh"
-#include "callow/preconditioner/PCJacobi.hh"
+#include "callow/preconditioner/PreconditionerCreator.hh"
 
 namespace callow
 {
@@ -47,23 +47,30 @@ void LinearSolver::set_operators(SP_matrix A, SP_db db)
   // lets us set new operators but maintain old parameters.
   if (db) d_db = db;
 
-  std::string pc_type = "";
   int pc_side = LEFT;
 
   if (d_db)
   {
-    if(d_db->check("pc_type"))
-      pc_type = d_db->get<std::string>("pc_type");
-    if (pc_type == "ilu0")
-    {
-      d_P = new PCILU0(d_A);
-    }
-    else if (pc_type == "jacobi")
-    {
-      d_P = new PCJacobi(d_A);
-    }
+    SP_preconditioner P = PreconditionerCreator::Create(d_A, d_db);
+    if (P) d_P = P;
     if(d_db->check("pc_side"))
       pc_side = d_db->get<int>("pc_side");
+    if (d_P) d_pc_side = pc_side;
+
+    // Optionally replace the CRS operator by a SELL copy for the action.
+    // The copy is a snapshot of A, so changes to A after set_operators
+    // are not seen until the operators are set again.  The
+    // preconditioner above keeps the original.  Jacobi and Gauss-Seidel
+    // index the CRS arrays directly and so always keep it.
+    std::string format = "csr";
+    if (d_db->check("linear_solver_matrix_format"))
+      format = d_db->get<std::string>("linear_solver_matrix_format");
+    Matrix *explicit_A = dynamic_cast<Matrix*>(d_A.bp());
+    if (format == "sell" && explicit_A &&
+        d_name != "jacobi" && d_name != "gauss-seidel")
+    {
+      d_A = new MatrixSELL(*explicit_A);
+    }
   }
 
 }
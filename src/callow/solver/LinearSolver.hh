@@ -142,6 +142,13 @@ public:
    */
   void set_tolerances(const double atol, const double rtol, const int maxit);
 
+  /// @name Tolerances
+  /// @{
+  double absolute_tolerance() const { return d_absolute_tolerance; }
+  double relative_tolerance() const { return d_relative_tolerance; }
+  int maximum_iterations() const { return d_maximum_iterations; }
+  /// @}
+
   /**
    *  Print residual norms and other diagonostic information.
    *
@@ -33,6 +33,7 @@ LinearSolverCreator::Create(SP_db db)
   bool monitor_diverge = false;
   double omega = 1.0;
   int restart = 30;
+  std::string orthog = "mgs";
 
   if (db)
   {
@@ -63,6 +64,11 @@ LinearSolverCreator::Create(SP_db db)
     {
       restart = db->get<int>("linear_solver_gmres_restart");
     }
+    if (solver_type == "gmres" &&
+        db->check("linear_solver_gmres_orthog"))
+    {
+      orthog = db->get<std::string>("linear_solver_gmres_orthog");
+    }
   }
 
 //  std::cout << " CALLOW:" << std::endl;
@@ -98,7 +104,10 @@ LinearSolverCreator::Create(SP_db db)
   //---------------------------------------------------------------------------//
   else if (solver_type == "gmres")
   {
-    solver = new GMRES(atol, rtol, maxit, restart);
+    Insist(orthog == "mgs" || orthog == "cgs2",
+           "Unsupported GMRES orthogonalization: " + orthog);
+    int type = orthog == "mgs" ? GMRES::MGS : GMRES::CGS2;
+    solver = new GMRES(atol, rtol, maxit, restart, type);
   }
 
   //---------------------------------------------------------------------------//
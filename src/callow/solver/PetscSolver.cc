@@ -79,10 +79,8 @@ void PetscSolver::set_operators(SP_matrix A, SP_db db)
     // Check for a callow pc type
     if (pc_type != "petsc_pc")
     {
-      if (pc_type == "ilu0")
-        d_P = new PCILU0(d_A);
-      else if (pc_type == "jacobi")
-        d_P = new PCJacobi(d_A);
+      SP_preconditioner P = PreconditionerCreator::Create(d_A, d_db);
+      if (P) d_P = P;
       // Set callow pc as a shell and set the shell operator
       if (d_P)
       {
@@ -13,8 +13,7 @@
 
 #include "LinearSolver.hh"
 // preconditioners
-#include "callow/preconditioner/PCILU0.hh"
-#include "callow/preconditioner/PCJacobi.hh"
+#include "callow/preconditioner/PreconditionerCreator.hh"
 
 namespace callow
 {
@@ -13,7 +13,8 @@
         FUNC(test_GaussSeidel) \
         FUNC(test_SOR)         \
         FUNC(test_GMRES)       \
-        FUNC(test_PetscSolver)
+        FUNC(test_PetscSolver) \
+        FUNC(test_GMRES_orthog)
 
 #include "utilities/TestDriver.hh"
 #include "callow/utils/Initialization.hh"
@@ -251,6 +252,27 @@ int test_PetscSolver(int argc, char *argv[])
 
 
 
+// MGS and CGS2 must give the same solution, including across restarts
+int test_GMRES_orthog(int argc, char *argv[])
+{
+  std::string orthog[] = {"mgs", "cgs2"};
+  for (int o = 0; o < 2; ++o)
+  {
+    Vector X(n, 0.0);
+    Vector B(n, 1.0);
+    db = get_db();
+    db->put<std::string>("linear_solver_type", "gmres");
+    db->put<int>("linear_solver_gmres_restart", 5);
+    db->put<std::string>("linear_solver_gmres_orthog", orthog[o]);
+    solver = LinearSolverCreator::Create(db);
+    solver->set_operators(test_matrix_1(n));
+    TEST(solver->solve(B, X) == SUCCESS);
+    for (int i = 0; i < n; ++i)
+      TEST(soft_equiv(X[i],  X_ref[i], 1e-9));
+  }
+  return 0;
+}
+
 //---------------------------------------------------------------------------//
 //              end of test_LinearSolver.cc
 //---------------------------------------------------------------------------//
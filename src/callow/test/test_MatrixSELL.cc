@@ -0,0 +1,112 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  test_MatrixSELL.cc
+ *  @brief Test of MatrixSELL class
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                \
+        FUNC(test_MatrixSELL)    \
+        FUNC(test_MatrixSELL_GMRES)
+
+#include "TestDriver.hh"
+#include "matrix/MatrixSELL.hh"
+#include "solver/LinearSolverCreator.hh"
+#include "utils/Initialization.hh"
+#include "matrix_fixture.hh"
+#include <iostream>
+#include <cmath>
+
+using namespace callow;
+using namespace detran_test;
+using detran_utilities::soft_equiv;
+using std::cout;
+using std::endl;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//----------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------------------------------------//
+
+int test_MatrixSELL(int argc, char *argv[])
+{
+  // the 2-D, 2-group diffusion operator has rows of varying length
+  Matrix::SP_matrix A = test_matrix_2(7);
+  int n = A->number_rows();
+
+  Vector x(n, 0.0), y(n, 0.0), z(n, 0.0);
+  for (int i = 0; i < n; ++i)
+    x[i] = std::sin(0.3 * i) + 2.0;
+
+  // no sorting, full sorting, and the default window
+  int sigma[] = {1, n, 32 * MatrixSELL::chunk_size};
+  for (int s = 0; s < 3; ++s)
+  {
+    MatrixSELL B(*A, sigma[s]);
+    TEST(B.number_rows() == n);
+    TEST(B.number_nonzeros() == A->number_nonzeros());
+    TEST(B.number_stored() >= B.number_nonzeros());
+    TEST(B.number_stored() % MatrixSELL::chunk_size == 0);
+
+    A->multiply(x, y);
+    B.multiply(x, z);
+    for (int i = 0; i < n; ++i)
+      TEST(soft_equiv(y[i], z[i]));
+
+    A->multiply_transpose(x, y);
+    B.multiply_transpose(x, z);
+    for (int i = 0; i < n; ++i)
+      TEST(soft_equiv(y[i], z[i]));
+  }
+
+  // sorting the whole matrix cannot pad more than no sorting
+  MatrixSELL B1(*A, 1);
+  MatrixSELL Bn(*A, n);
+  TEST(Bn.number_stored() <= B1.number_stored());
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_MatrixSELL_GMRES(int argc, char *argv[])
+{
+  Matrix::SP_matrix A = test_matrix_2(10);
+  int n = A->number_rows();
+
+  LinearSolver::SP_db db(new detran_utilities::InputDB("callow_db"));
+  db->put<std::string>("linear_solver_type", "gmres");
+  db->put<double>("linear_solver_atol", 1e-12);
+  db->put<double>("linear_solver_rtol", 1e-12);
+  db->put<int>("linear_solver_maxit", 1000);
+  db->put<int>("linear_solver_monitor_level", 0);
+  db->put<std::string>("pc_type", "ilu0");
+
+  Vector b(n, 1.0), x(n, 0.0), y(n, 0.0);
+
+  // reference with the CRS operator
+  LinearSolverCreator::SP_solver solver = LinearSolverCreator::Create(db);
+  solver->set_operators(A, db);
+  TEST(solver->solve(b, x) == SUCCESS);
+
+  // same solve with the SELL copy doing the action
+  db->put<std::string>("linear_solver_matrix_format", "sell");
+  solver = LinearSolverCreator::Create(db);
+  solver->set_operators(A, db);
+  TEST(solver->solve(b, y) == SUCCESS);
+  for (int i = 0; i < n; ++i)
+    TEST(soft_equiv(x[i], y[i], 1.0e-9));
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+//              end of test_MatrixSELL.cc
+//----------------------------------------------------------------------------//
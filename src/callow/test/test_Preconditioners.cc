@@ -9,16 +9,28 @@
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST            \
         FUNC(test_PCJacobi)  \
-        FUNC(test_PCILU0)
+        FUNC(test_PCILU0)    \
+        FUNC(test_PCILUT)    \
+        FUNC(test_PCILU0_levels) \
+        FUNC(test_PCAMG)     \
+        FUNC(test_PCILUT_fill) \
+        FUNC(test_PreconditionerCreator)
 
 #include "TestDriver.hh"
 #include "preconditioner/PCJacobi.hh"
 #include "preconditioner/PCILU0.hh"
+#include "preconditioner/PCILUT.hh"
+#include "preconditioner/PCAMG.hh"
+#include "preconditioner/PreconditionerCreator.hh"
+#include "solver/LinearSolverCreator.hh"
 
 #include "matrix_fixture.hh"
 #include "matrix/Matrix.hh"
 #include "utils/Initialization.hh"
 #include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
 
 using namespace callow;
 using namespace detran_test;
@@ -56,6 +68,220 @@ int test_PCILU0(int argc, char *argv[])
   PCILU0 P(A);
   P.display("pc_ilu0.out");
 
+  // a tridiagonal matrix has no fill, so ILU(0) is its exact LU
+  int n = A->number_rows();
+  Vector x_ref(n, 0.0), b(n, 0.0), x(n, 0.0);
+  for (int i = 0; i < n; ++i)
+    x_ref[i] = 1.0 + 0.1 * i;
+  A->multiply(x_ref, b);
+  P.apply(b, x);
+  for (int i = 0; i < n; ++i)
+    TEST(soft_equiv(x[i], x_ref[i]));
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_PCILUT(int argc, char *argv[])
+{
+  Matrix::SP_matrix A = test_matrix_2(10);
+  int n = A->number_rows();
+
+  Vector x_ref(n, 0.0), b(n, 0.0), x(n, 0.0), y(n, 0.0);
+  for (int i = 0; i < n; ++i)
+    x_ref[i] = 1.0 + 0.01 * i;
+  A->multiply(x_ref, b);
+
+  // with nothing dropped, the factorization is an exact LU
+  PCILUT LU(A, 0.0, -1, -1);
+  LU.apply(b, x);
+  for (int i = 0; i < n; ++i)
+    TEST(soft_equiv(x[i], x_ref[i], 1.0e-10));
+
+  // ILU(0) by level of fill must reproduce PCILU0
+  PCILU0 P0(A);
+  PCILUT PK(A, 0.0, -1, 0);
+  TEST(PK.number_nonzeros() == A->number_nonzeros());
+  P0.apply(b, x);
+  PK.apply(b, y);
+  for (int i = 0; i < n; ++i)
+    TEST(soft_equiv(x[i], y[i]));
+
+  // more fill means a (weakly) larger factorization
+  PCILUT P1(A, 0.0, -1, 1);
+  PCILUT PT(A, 1.0e-3, 10);
+  TEST(P1.number_nonzeros() > PK.number_nonzeros());
+  TEST(PT.number_nonzeros() <= LU.number_nonzeros());
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+// exposes the choice of serial or level scheduled solves
+class PCILU0Levels: public PCILU0
+{
+public:
+  PCILU0Levels(SP_matrix A) : PCILU0(A) {}
+  bool level_scheduled() const { return d_level_scheduled; }
+  void set_level_scheduled(bool v) { d_level_scheduled = v; }
+};
+
+int test_PCILU0_levels(int argc, char *argv[])
+{
+  Matrix::SP_matrix A = test_matrix_2(40);
+  int n = A->number_rows();
+
+  Vector b(n, 0.0), x(n, 0.0), y(n, 0.0);
+  for (int i = 0; i < n; ++i)
+    b[i] = 1.0 + std::sin(0.1 * i);
+
+  PCILU0Levels P(A);
+  P.set_level_scheduled(false);
+  P.apply(b, x);
+  P.set_level_scheduled(true);
+  P.apply(b, y);
+
+  // each row is computed identically, so the results match exactly
+  for (int i = 0; i < n; ++i)
+    TEST(x[i] == y[i]);
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_PCAMG(int argc, char *argv[])
+{
+  Matrix::SP_matrix A = test_matrix_2(30);
+  int n = A->number_rows();
+
+  PCAMG P(A);
+  P.display_hierarchy();
+  TEST(P.number_levels() > 1);
+  for (int l = 1; l < P.number_levels(); ++l)
+  {
+    TEST(P.level_operator(l)->number_rows() <
+         P.level_operator(l - 1)->number_rows());
+  }
+
+  // GMRES with and without AMG selected through the database
+  LinearSolver::SP_db db(new detran_utilities::InputDB("callow_db"));
+  db->put<std::string>("linear_solver_type", "gmres");
+  db->put<double>("linear_solver_atol", 1e-10);
+  db->put<double>("linear_solver_rtol", 1e-10);
+  db->put<int>("linear_solver_maxit", 2000);
+  db->put<int>("linear_solver_monitor_level", 0);
+
+  Vector b(n, 1.0), x(n, 0.0), y(n, 0.0);
+  LinearSolverCreator::SP_solver solver = LinearSolverCreator::Create(db);
+  solver->set_operators(A, db);
+  TEST(solver->solve(b, x) == SUCCESS);
+  int number_plain = solver->number_iterations();
+
+  db->put<std::string>("pc_type", "amg");
+  solver = LinearSolverCreator::Create(db);
+  solver->set_operators(A, db);
+  TEST(solver->solve(b, y) == SUCCESS);
+  int number_amg = solver->number_iterations();
+  TEST(number_plain > 50);
+  TEST(number_amg <= 12);
+  TEST(number_amg < number_plain / 4);
+  for (int i = 0; i < n; ++i)
+    TEST(soft_equiv(x[i], y[i], 1.0e-6));
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+// exposes the combined factors
+class PCILUTFactors: public PCILUT
+{
+public:
+  PCILUTFactors(SP_matrix A, double tolerance, int fill)
+    : PCILUT(A, tolerance, fill) {}
+  double factor(int i, int j) const
+  {
+    for (int p = d_P->start(i); p < d_P->end(i); ++p)
+      if (d_P->column(p) == j) return d_P->values()[p];
+    return 0.0;
+  }
+};
+
+// orders columns by decreasing magnitude, then by index
+struct larger_entry
+{
+  larger_entry(const std::vector<double> &w) : d_w(w) {}
+  bool operator()(int a, int b) const
+  {
+    double wa = std::abs(d_w[a]), wb = std::abs(d_w[b]);
+    return wa > wb || (wa == wb && a < b);
+  }
+  const std::vector<double> &d_w;
+};
+
+// zero all but the fill largest nonzeros of w in [b, e)
+void keep_largest(std::vector<double> &w, int b, int e, int fill)
+{
+  std::vector<int> cols;
+  for (int j = b; j < e; ++j)
+    if (w[j] != 0.0) cols.push_back(j);
+  std::sort(cols.begin(), cols.end(), larger_entry(w));
+  for (int c = fill; c < cols.size(); ++c)
+    w[cols[c]] = 0.0;
+}
+
+int test_PCILUT_fill(int argc, char *argv[])
+{
+  Matrix::SP_matrix A = test_matrix_2(4);
+  int n = A->number_rows();
+
+  // ILUT(p, 0) computed directly with dense rows
+  int fill = 1;
+  std::vector<std::vector<double> > LU(n, std::vector<double>(n, 0.0));
+  for (int i = 0; i < n; ++i)
+  {
+    std::vector<double> &w = LU[i];
+    for (int p = A->start(i); p < A->end(i); ++p)
+      w[A->column(p)] = A->values()[p];
+    for (int k = 0; k < i; ++k)
+    {
+      if (w[k] == 0.0) continue;
+      w[k] /= LU[k][k];
+      for (int j = k + 1; j < n; ++j)
+        w[j] -= w[k] * LU[k][j];
+    }
+    keep_largest(w, 0, i, fill);
+    keep_largest(w, i + 1, n, fill);
+  }
+
+  // entries dropped from one row must not leak into the next
+  PCILUTFactors P(A, 0.0, fill);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      TEST(soft_equiv(P.factor(i, j), LU[i][j]));
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_PreconditionerCreator(int argc, char *argv[])
+{
+  Matrix::SP_matrix A = test_matrix_1(5);
+  PreconditionerCreator::SP_db db(new detran_utilities::InputDB("callow_db"));
+
+  // no pc_type means no preconditioner
+  TEST(!PreconditionerCreator::Create(A, db));
+
+  const char *types[] = {"ilu0", "iluk", "ilut", "amg", "jacobi"};
+  const char *names[] = {"PCILU0", "PCILUT", "PCILUT", "PCAMG", "PCJacobi"};
+  for (int t = 0; t < 5; ++t)
+  {
+    db->put<std::string>("pc_type", types[t]);
+    PreconditionerCreator::SP_preconditioner P =
+      PreconditionerCreator::Create(A, db);
+    TEST(P);
+    TEST(P->name() == names[t]);
+  }
+
   return 0;
 }
 
@@ -10,13 +10,15 @@
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST               \
         FUNC(test_Vector)       \
-        FUNC(test_Vector_resize)
+        FUNC(test_Vector_resize) \
+        FUNC(test_Vector_blocked)
 
 #include "TestDriver.hh"
 #include "callow/vector/Vector.hh"
 #include "callow/utils/Initialization.hh"
 #include "utilities/Definitions.hh"
 #include <iostream>
+#include <cmath>
 
 using namespace callow;
 using namespace detran_test;
@@ -97,6 +99,57 @@ int test_Vector_resize(int argc, char *argv[])
   return 0;
 }
 
+// Test of the blocked (and possibly threaded) operations
+int test_Vector_blocked(int argc, char *argv[])
+{
+  // Several blocks plus a partial one
+  int n = 3 * Vector::block_size + 17;
+  Vector x(n, 0.0), y(n, 0.0);
+  double ref_dot = 0.0, ref_L1 = 0.0, ref_L2 = 0.0, ref_LI = 0.0;
+  for (int i = 0; i < n; ++i)
+  {
+    x[i] = std::sin(0.01 * i);
+    y[i] = std::cos(0.02 * i);
+    ref_dot += x[i] * y[i];
+    ref_L1  += std::abs(x[i]);
+    ref_L2  += x[i] * x[i];
+    ref_LI   = std::max(ref_LI, std::abs(x[i]));
+  }
+  TEST(soft_equiv(x.dot(y), ref_dot));
+  TEST(soft_equiv(x.norm(L1), ref_L1));
+  TEST(soft_equiv(x.norm(L2), std::sqrt(ref_L2)));
+  TEST(soft_equiv(x.norm(LINF), ref_LI));
+  TEST(soft_equiv(x.norm_residual(x, L2), 0.0));
+
+  // Fused update and norm matches the separate operations.
+  Vector z(x);
+  double nz = z.add_a_times_x_norm(0.5, y);
+  x.add_a_times_x(0.5, y);
+  TEST(soft_equiv(nz, x.norm(L2)));
+  TEST(soft_equiv(z.norm_residual(x, LINF), 0.0));
+
+  // Multiple inner products and updates
+  std::vector<Vector> V(3, y);
+  V[1].scale(2.0);
+  V[2].set(1.0);
+  double d[3], a[3] = {1.0, -0.5, 2.0};
+  x.multi_dot(V, 3, d);
+  for (int j = 0; j < 3; ++j)
+    TEST(soft_equiv(d[j], x.dot(V[j])));
+  z.copy(x);
+  x.multi_add_a_times_x(a, V, 3);
+  for (int j = 0; j < 3; ++j)
+    z.add_a_times_x(a[j], V[j]);
+  TEST(soft_equiv(z.norm_residual(x, LINF), 0.0));
+  double norm_x = x.multi_add_a_times_x_norm(a, V, 3);
+  for (int j = 0; j < 3; ++j)
+    z.add_a_times_x(a[j], V[j]);
+  TEST(soft_equiv(z.norm_residual(x, LINF), 0.0));
+  TEST(soft_equiv(norm_x, z.norm()));
+
+  return 0;
+}
+
 //---------------------------------------------------------------------------//
 //              end of test_Vector.cc
 //---------------------------------------------------------------------------//
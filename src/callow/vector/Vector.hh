@@ -20,6 +20,11 @@ namespace callow
 /**
  *  @class Vector
  *  @brief Dense vector object
+ *
+ *  The basic operations are threaded with OpenMP for vectors longer than
+ *  one block of block_size elements.  Reductions (inner products and
+ *  norms) are computed block by block, and the block results are summed
+ *  in order, so a result does not depend on the number of threads.
  */
 class CALLOW_EXPORT Vector
 {
@@ -32,6 +37,9 @@ public:
 
   typedef detran_utilities::SP<Vector>    SP_vector;
 
+  /// Number of elements in a block of a threaded operation
+  static const int block_size = 4096;
+
   //-------------------------------------------------------------------------//
   // CONSTRUCTOR & DESTRUCTOR
   //-------------------------------------------------------------------------//
@@ -123,6 +131,27 @@ public:
   /// Add a vector x times a scalar a to this vector
   void add_a_times_x(const double a, const Vector& x);
   void add_a_times_x(const double a, SP_vector x);
+  /// Add a vector x times a scalar a and return the L2 norm of the result
+  double add_a_times_x_norm(const double a, const Vector& x);
+  /**
+   *  @brief Inner products of this vector with the first n vectors of X
+   *
+   *  This is one pass over this vector, as is needed by classical
+   *  Gram-Schmidt.
+   *
+   *  @param X      Vectors
+   *  @param n      Number of vectors used
+   *  @param val    Resulting inner products (of length n)
+   */
+  void multi_dot(const std::vector<Vector> &X, const int n, double *val);
+  /// Add the first n vectors of X times the scalars a to this vector
+  void multi_add_a_times_x(const double *a,
+                           const std::vector<Vector> &X,
+                           const int n);
+  /// As multi_add_a_times_x, also returning the L2 norm of the result
+  double multi_add_a_times_x_norm(const double *a,
+                                  const std::vector<Vector> &X,
+                                  const int n);
 
   //-------------------------------------------------------------------------//
   // QUERY
@@ -158,6 +187,25 @@ protected:
   // Is this also temporary around an extant PETSC vector?
   bool d_temporary_petsc;
 
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Number of blocks in a threaded operation
+  int number_blocks() const
+  {
+    return (d_size + block_size - 1) / block_size;
+  }
+
+  /**
+   *  @brief Reduce over fixed blocks in a deterministic order.
+   *
+   *  The kernel K provides double operator()(i_begin, i_end) for a
+   *  block.  Block results are summed (or maximized) in block order.
+   */
+  template <class K>
+  double block_reduce(const K &kernel, const bool maximum = false) const;
+
 };
 
 CALLOW_TEMPLATE_EXPORT(detran_utilities::SP<Vector>);
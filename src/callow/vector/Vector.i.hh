@@ -11,6 +11,7 @@
 #define callow_VECTOR_I_HH_
 
 #include "utilities/DBC.hh"
+#include <algorithm>
 #include <cmath>
 #include <stdio.h>
 #include <iostream>
@@ -64,6 +65,111 @@ inline double& Vector::value(const int i)
   return d_value[i];
 }
 
+//---------------------------------------------------------------------------//
+// REDUCTION KERNELS
+//---------------------------------------------------------------------------//
+
+/**
+ *  @class VectorReduction
+ *  @brief Block kernel for the inner products and norms of a Vector.
+ *
+ *  If y is given, the norms are of x - y, and the relative norms divide
+ *  by x.  For DOT, y is required.
+ */
+struct VectorReduction
+{
+  enum TYPES {DOT, ABS, SQUARE, MAXABS, ABSREL, SQUAREREL};
+
+  VectorReduction(const int t, const double *x_in, const double *y_in = 0)
+    : type(t), x(x_in), y(y_in)
+  {/* ... */}
+
+  double operator()(const int i_begin, const int i_end) const
+  {
+    double val = 0.0;
+    int i;
+    if (type == DOT)
+    {
+      for (i = i_begin; i < i_end; ++i)
+        val += x[i] * y[i];
+    }
+    else if (!y)
+    {
+      if (type == ABS)
+        for (i = i_begin; i < i_end; ++i)
+          val += std::abs(x[i]);
+      else if (type == SQUARE)
+        for (i = i_begin; i < i_end; ++i)
+          val += x[i] * x[i];
+      else if (type == MAXABS)
+        for (i = i_begin; i < i_end; ++i)
+          val = std::max(val, std::abs(x[i]));
+    }
+    else
+    {
+      if (type == ABS)
+        for (i = i_begin; i < i_end; ++i)
+          val += std::abs(x[i] - y[i]);
+      else if (type == SQUARE)
+        for (i = i_begin; i < i_end; ++i)
+          val += (x[i] - y[i]) * (x[i] - y[i]);
+      else if (type == MAXABS)
+        for (i = i_begin; i < i_end; ++i)
+          val = std::max(val, std::abs(x[i] - y[i]));
+      else if (type == ABSREL)
+        for (i = i_begin; i < i_end; ++i)
+          val += std::abs((x[i] - y[i]) / x[i]);
+      else if (type == SQUAREREL)
+        for (i = i_begin; i < i_end; ++i)
+          val += ((x[i] - y[i]) / x[i]) * ((x[i] - y[i]) / x[i]);
+    }
+    return val;
+  }
+
+  const int type;
+  const double *x;
+  const double *y;
+};
+
+/// Block kernel for y <-- y + a*x returning the sum of squares of y
+struct VectorAXPYNorm
+{
+  VectorAXPYNorm(const double a_in, const double *x_in, double *y_in)
+    : a(a_in), x(x_in), y(y_in)
+  {/* ... */}
+
+  double operator()(const int i_begin, const int i_end) const
+  {
+    double val = 0.0;
+    for (int i = i_begin; i < i_end; ++i)
+    {
+      y[i] += a * x[i];
+      val += y[i] * y[i];
+    }
+    return val;
+  }
+
+  const double a;
+  const double *x;
+  double *y;
+};
+
+//---------------------------------------------------------------------------//
+template <class K>
+inline double Vector::block_reduce(const K &kernel, const bool maximum) const
+{
+  int nb = number_blocks();
+  if (nb <= 1) return kernel(0, d_size);
+  std::vector<double> partial(nb, 0.0);
+  #pragma omp parallel for schedule(static)
+  for (int b = 0; b < nb; ++b)
+    partial[b] = kernel(b * block_size, std::min((b + 1) * block_size, d_size));
+  double val = partial[0];
+  for (int b = 1; b < nb; ++b)
+    val = maximum ? std::max(val, partial[b]) : val + partial[b];
+  return val;
+}
+
 //---------------------------------------------------------------------------//
 // VECTOR OPERATIONS
 //---------------------------------------------------------------------------//
@@ -82,21 +188,18 @@ inline double Vector::norm(const int type)
   else
     THROW("Unsupported norm type");
 #else
+  typedef VectorReduction R;
   if (type == L1 || type == L1GRID)
   {
-    for (int i = 0; i < d_size; i++)
-      val += std::abs(d_value[i]);
+    val = block_reduce(R(R::ABS, d_value));
   }
   else if (type == L2 || type == L2GRID)
   {
-    for (int i = 0; i < d_size; i++)
-      val += d_value[i] * d_value[i];
-    val = std::sqrt(val);
+    val = std::sqrt(block_reduce(R(R::SQUARE, d_value)));
   }
   else if (type == LINF)
   {
-    for (int i = 0; i < d_size; i++)
-      val = std::max(val, std::abs(d_value[i]));
+    val = block_reduce(R(R::MAXABS, d_value), true);
   }
 #endif
   // divide by N or sqrt(N) for the grid norms
@@ -117,40 +220,21 @@ inline double Vector::norm_residual(const Vector& x, const int type)
   // and take its norm
   val = tmp.norm(type);
 #else
+  typedef VectorReduction R;
   // basic norms
   if (type == L1)
-  {
-    for (int i = 0; i < d_size; i++)
-      val += std::abs(d_value[i] - x[i]);
-  }
+    val = block_reduce(R(R::ABS, d_value, x.d_value));
   else if (type == L2)
-  {
-    for (int i = 0; i < d_size; i++)
-      val += (d_value[i] - x[i])*(d_value[i] - x[i]);
-    val = std::sqrt(val);
-  }
+    val = std::sqrt(block_reduce(R(R::SQUARE, d_value, x.d_value)));
   else if (type == LINF)
-  {
-    for (int i = 0; i < d_size; i++)
-      val = std::max(val, std::abs(d_value[i] - x[i]));
-  }
+    val = block_reduce(R(R::MAXABS, d_value, x.d_value), true);
   // relative norms
   else if (type == L1REL)
-  {
-    for (int i = 0; i < d_size; i++)
-      val += std::abs((d_value[i] - x[i])/d_value[i]);
-  }
+    val = block_reduce(R(R::ABSREL, d_value, x.d_value));
   else if (type == L2REL)
-  {
-    for (int i = 0; i < d_size; i++)
-      val += ((d_value[i] - x[i])/d_value[i])*((d_value[i] - x[i])/d_value[i]);
-    val = std::sqrt(val);
-  }
+    val = std::sqrt(block_reduce(R(R::SQUAREREL, d_value, x.d_value)));
   else if (type == LINFREL)
-  {
-    for (int i = 0; i < d_size; i++)
-      val = std::max(val, std::abs(d_value[i] - x[i]));
-  }
+    val = block_reduce(R(R::MAXABS, d_value, x.d_value), true);
   else
     THROW("Unsupported norm residual type");
 #endif
@@ -169,6 +253,7 @@ inline void Vector::set(const double v)
 #ifdef CALLOW_ENABLE_PETSC_OPS2
   VecSet(d_petsc_vector, v);
 #else
+  #pragma omp parallel for if (d_size > block_size)
   for (int i = 0; i < d_size; i++)
     d_value[i] = v;
 #endif
@@ -180,6 +265,7 @@ inline void Vector::scale(const double v)
 #ifdef CALLOW_ENABLE_PETSC_OPS
   VecScale(d_petsc_vector, v);
 #else
+  #pragma omp parallel for if (d_size > block_size)
   for (int i = 0; i < d_size; i++)
     d_value[i] *= v;
 #endif
@@ -193,8 +279,8 @@ inline double Vector::dot(const Vector& x)
 #ifdef CALLOW_ENABLE_PETSC_OPS
   VecDot(d_petsc_vector, const_cast<Vector* >(&x)->petsc_vector(), &val);
 #else
-  for (int i = 0; i < d_size; i++)
-    val += d_value[i] * x[i];
+  typedef VectorReduction R;
+  val = block_reduce(R(R::DOT, d_value, x.d_value));
 #endif
   return val;
 }
@@ -205,6 +291,37 @@ inline double Vector::dot(SP_vector x)
   return dot(*x);
 }
 
+//---------------------------------------------------------------------------//
+inline void Vector::multi_dot(const std::vector<Vector> &X,
+                              const int                  n,
+                              double                    *val)
+{
+  Require(n <= (int)X.size());
+  int nb = number_blocks();
+  std::vector<double> partial(nb * n, 0.0);
+  #pragma omp parallel for schedule(static) if (nb > 1)
+  for (int b = 0; b < nb; ++b)
+  {
+    int i_begin = b * block_size;
+    int i_end   = std::min(i_begin + block_size, d_size);
+    for (int j = 0; j < n; ++j)
+    {
+      Require(X[j].size() == d_size);
+      const double *x = X[j].d_value;
+      double v = 0.0;
+      for (int i = i_begin; i < i_end; ++i)
+        v += d_value[i] * x[i];
+      partial[b * n + j] = v;
+    }
+  }
+  for (int j = 0; j < n; ++j)
+  {
+    val[j] = 0.0;
+    for (int b = 0; b < nb; ++b)
+      val[j] += partial[b * n + j];
+  }
+}
+
 //---------------------------------------------------------------------------//
 inline void Vector::add(const Vector &x)
 {
@@ -212,8 +329,10 @@ inline void Vector::add(const Vector &x)
 #ifdef CALLOW_ENABLE_PETSC_OPS
   VecAXPY(d_petsc_vector, 1.0, const_cast<Vector* >(&x)->petsc_vector());
 #else
+  const double *x_v = x.d_value;
+  #pragma omp parallel for if (d_size > block_size)
   for (int i = 0; i < d_size; i++)
-    d_value[i] += x[i];
+    d_value[i] += x_v[i];
 #endif
 }
 
@@ -230,8 +349,10 @@ inline void Vector::add_a_times_x(const double a, const Vector& x)
 #ifdef CALLOW_ENABLE_PETSC_OPS2
   VecAXPY(d_petsc_vector, a, const_cast<Vector* >(&x)->petsc_vector());
 #else
+  const double *x_v = x.d_value;
+  #pragma omp parallel for if (d_size > block_size)
   for (int i = 0; i < d_size; i++)
-    d_value[i] += a*x[i];
+    d_value[i] += a * x_v[i];
 #endif
 }
 
@@ -241,6 +362,66 @@ inline void Vector::add_a_times_x(const double a, SP_vector x)
   add_a_times_x(a, *x);
 }
 
+//---------------------------------------------------------------------------//
+inline double Vector::add_a_times_x_norm(const double a, const Vector& x)
+{
+  Require(x.size() == d_size);
+  return std::sqrt(block_reduce(VectorAXPYNorm(a, x.d_value, d_value)));
+}
+
+//---------------------------------------------------------------------------//
+inline void Vector::multi_add_a_times_x(const double              *a,
+                                        const std::vector<Vector> &X,
+                                        const int                  n)
+{
+  Require(n <= (int)X.size());
+  int nb = number_blocks();
+  #pragma omp parallel for schedule(static) if (nb > 1)
+  for (int b = 0; b < nb; ++b)
+  {
+    int i_begin = b * block_size;
+    int i_end   = std::min(i_begin + block_size, d_size);
+    for (int j = 0; j < n; ++j)
+    {
+      Require(X[j].size() == d_size);
+      const double *x = X[j].d_value;
+      for (int i = i_begin; i < i_end; ++i)
+        d_value[i] += a[j] * x[i];
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+inline double Vector::multi_add_a_times_x_norm(const double              *a,
+                                               const std::vector<Vector> &X,
+                                               const int                  n)
+{
+  Require(n <= (int)X.size());
+  int nb = number_blocks();
+  std::vector<double> partial(nb, 0.0);
+  #pragma omp parallel for schedule(static) if (nb > 1)
+  for (int b = 0; b < nb; ++b)
+  {
+    int i_begin = b * block_size;
+    int i_end   = std::min(i_begin + block_size, d_size);
+    for (int j = 0; j < n; ++j)
+    {
+      Require(X[j].size() == d_size);
+      const double *x = X[j].d_value;
+      for (int i = i_begin; i < i_end; ++i)
+        d_value[i] += a[j] * x[i];
+    }
+    double v = 0.0;
+    for (int i = i_begin; i < i_end; ++i)
+      v += d_value[i] * d_value[i];
+    partial[b] = v;
+  }
+  double val = 0.0;
+  for (int b = 0; b < nb; ++b)
+    val += partial[b];
+  return std::sqrt(val);
+}
+
 //---------------------------------------------------------------------------//
 inline void Vector::subtract(const Vector &x)
 {
@@ -248,8 +429,10 @@ inline void Vector::subtract(const Vector &x)
 #ifdef CALLOW_ENABLE_PETSC_OPS
   VecAXPY(d_petsc_vector, -1.0, const_cast<Vector* >(&x)->petsc_vector());
 #else
+  const double *x_v = x.d_value;
+  #pragma omp parallel for if (d_size > block_size)
   for (int i = 0; i < d_size; i++)
-    d_value[i] -= x[i];
+    d_value[i] -= x_v[i];
 #endif
 }
 
@@ -267,8 +450,10 @@ inline void Vector::multiply(const Vector &x)
   Vector tmp(*this);
   VecPointwiseMult(d_petsc_vector, tmp.petsc_vector(), const_cast<Vector* >(&x)->petsc_vector());
 #else
+  const double *x_v = x.d_value;
+  #pragma omp parallel for if (d_size > block_size)
   for (int i = 0; i < d_size; i++)
-    d_value[i] *= x[i];
+    d_value[i] *= x_v[i];
 #endif
 }
 
@@ -286,8 +471,10 @@ inline void Vector::divide(const Vector &x)
   Vector tmp(*this);
   VecPointwiseDivide(d_petsc_vector, tmp.petsc_vector(), const_cast<Vector* >(&x)->petsc_vector());
 #else
+  const double *x_v = x.d_value;
+  #pragma omp parallel for if (d_size > block_size)
   for (int i = 0; i < d_size; i++)
-    d_value[i] /= x[i];
+    d_value[i] /= x_v[i];
 #endif
 }
 
@@ -304,8 +491,10 @@ inline void Vector::copy(const Vector &x)
 #ifdef CALLOW_ENABLE_PETSC_OPS
   VecCopy(const_cast<Vector* >(&x)->petsc_vector(), d_petsc_vector);
 #else
+  const double *x_v = x.d_value;
+  #pragma omp parallel for if (d_size > block_size)
   for (int i = 0; i < d_size; i++)
-    d_value[i] = x[i];
+    d_value[i] = x_v[i];
 #endif
 }
 
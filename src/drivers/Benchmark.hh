@@ -0,0 +1,169 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  Benchmark.hh
+ *  @brief Benchmark class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_BENCHMARK_HH_
+#define detran_BENCHMARK_HH_
+
+#include "detran_config.hh"
+#include "geometry/Mesh.hh"
+#include "material/Material.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/InputDB.hh"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace detran
+{
+
+/**
+ *  @class Benchmark
+ *  @brief Time the core kernels over a range of problem sizes
+ *
+ *  Each case is run a number of times after one warm-up run, and the
+ *  fastest run is recorded.  The cases are
+ *    - sweep:   one space-angle sweep of every group, for each sweeper
+ *               and equation (1D dd/sd/sc, 2D dd/sd/sc/scmoc, 3D dd)
+ *    - matvec:  Matrix::multiply for a 5-point Laplacian
+ *    - pcilu0:  PCILU0::apply for the same matrix
+ *    - gmres:   a fixed number of GMRES(20) iterations on the same matrix
+ *    - power:   a fixed number of power iterations on the same matrix
+ *
+ *  Every combination of the requested mesh sizes (cells per dimension),
+ *  group counts, quadrature orders (angles per octant per direction),
+ *  and thread counts is run; the matrix cases ignore groups and orders.
+ *
+ *  Work is counted in cells x angles x groups for sweeps (segments x
+ *  polar angles x groups for MOC) and in nonzeros for the matrix cases.
+ *  The bandwidth is the bytes a kernel must move at least once per unit
+ *  of work divided by the time, which gives the roofline position of the
+ *  kernel.  For a sweep, each unit reads the source and the incident
+ *  edge fluxes and writes the outgoing edge fluxes and the scalar flux.
+ *  For CSR kernels, each nonzero reads an 8-byte value and a 4-byte
+ *  column index, and each row reads a row pointer and writes one value.
+ */
+class Benchmark
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::InputDB::SP_input       SP_input;
+  typedef detran_geometry::Mesh::SP_mesh            SP_mesh;
+  typedef detran_material::Material::SP_material    SP_material;
+  typedef detran_utilities::vec_int                 vec_int;
+  typedef detran_utilities::size_t                  size_t;
+
+  /// One timed case
+  struct Record
+  {
+    std::string kernel;
+    std::string equation;
+    int         dimension;
+    int         cells;
+    int         groups;
+    int         angles;
+    int         threads;
+    /// Units of work per run and what they count
+    double      work;
+    std::string work_unit;
+    /// Modeled bytes moved per run
+    double      bytes;
+    /// Fastest time per run in seconds
+    double      seconds;
+  };
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param argc   command line count
+   *  @param argv   command line values
+   *
+   *  Options are -cells, -groups, -orders, and -threads, each followed by
+   *  a comma-separated list; -repeat n; -kernels followed by a list of
+   *  sweep, matvec, pcilu0, gmres, power; and -o file for the output.
+   */
+  Benchmark(int argc, char *argv[]);
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /// Run all requested cases
+  void run();
+
+  /// Write the records as JSON
+  void write(std::ostream &out) const;
+
+  /// Output file name (empty for standard output)
+  const std::string& output() const { return d_output; }
+
+  /// Wall clock time in seconds
+  static double wall_time();
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  vec_int d_cells;
+  vec_int d_groups;
+  vec_int d_orders;
+  vec_int d_threads;
+  int d_repeat;
+  std::vector<std::string> d_kernels;
+  std::string d_output;
+  std::vector<Record> d_records;
+
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  bool requested(const std::string &kernel) const;
+  void set_threads(const int n) const;
+  SP_mesh build_mesh(const int dimension, const int cells) const;
+  SP_material build_material(const int groups) const;
+  SP_input build_input(const std::string &equation,
+                       const int groups,
+                       const int order) const;
+
+  /// Time one sweep of all groups
+  template <class D, class SWEEPER>
+  double time_sweep(SP_input input, SP_mesh mesh, SP_material material);
+
+  /// Time all sweepers of one dimension
+  template <class D>
+  void run_sweeps(const int cells, const int groups,
+                  const int order, const int threads);
+
+  /// Time the matrix and solver kernels
+  void run_matrix(const int cells, const int threads);
+
+  /// Add a record
+  void record(const std::string &kernel, const std::string &equation,
+              const int dimension, const int cells, const int groups,
+              const int angles, const int threads,
+              const double work, const std::string &work_unit,
+              const double bytes, const double seconds);
+
+};
+
+} // end namespace detran
+
+#endif /* detran_BENCHMARK_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of Benchmark.hh
+//----------------------------------------------------------------------------//
@@ -0,0 +1,59 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  detran_bench.cc
+ *  @brief Detran kernel benchmark driver
+ *  @note  Copyright (C) Jeremy Roberts 2012-2013
+ *
+ *  Usage:
+ *  @verbatim
+     detran_bench [-cells 16,32] [-groups 1,4] [-orders 2,4]
+                  [-threads 1,2] [-repeat 3] [-kernels sweep,matvec]
+                  [-o results.json]
+    @endverbatim
+ *
+ *  The results are written as JSON to the file or to standard output,
+ *  and progress is echoed to standard error.
+ */
+//----------------------------------------------------------------------------//
+
+#include "Benchmark.hh"
+#include "solvers/Manager.hh"
+#include "utilities/DBC.hh"
+#include <fstream>
+#include <iostream>
+
+//----------------------------------------------------------------------------//
+int main(int argc, char **argv)
+{
+  // The benchmark options are not passed on to the solver packages.
+  detran::Manager::initialize(1, argv);
+
+  try
+  {
+    detran::Benchmark bench(argc, argv);
+    bench.run();
+    if (bench.output().empty())
+    {
+      bench.write(std::cout);
+    }
+    else
+    {
+      std::ofstream out(bench.output().c_str());
+      Insist(out, "Cannot open " + bench.output());
+      bench.write(out);
+    }
+  }
+  catch (detran_utilities::GenException &e)
+  {
+    std::cerr << e.what() << std::endl;
+    detran::Manager::finalize();
+    return 1;
+  }
+
+  detran::Manager::finalize();
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+//              end of detran_bench.cc
+//----------------------------------------------------------------------------//
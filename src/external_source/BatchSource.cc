@@ -0,0 +1,50 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  BatchSource.cc
+ *  @brief BatchSource member definitions
+ *  @note  Copyright (C) Jeremy Roberts 2012-2013
+ */
+//----------------------------------------------------------------------------//
+
+#include "BatchSource.hh"
+
+namespace detran_external_source
+{
+
+//----------------------------------------------------------------------------//
+BatchSource::BatchSource(const vec_externalsource &sources,
+                         SP_mesh                   mesh,
+                         SP_quadrature             quadrature)
+  : ExternalSource(sources.empty() ? 1 : sources[0]->number_groups(),
+                   mesh,
+                   quadrature,
+                   sources.empty() ? false : sources[0]->is_discrete())
+  , d_sources(sources)
+  , d_selected(0)
+{
+  Insist(!d_sources.empty(), "A batch source needs at least one source.");
+  for (size_t i = 0; i < d_sources.size(); ++i)
+  {
+    Insist(d_sources[i], "A batch source cannot hold a null source.");
+    Insist(d_sources[i]->number_groups() == d_number_groups,
+           "All sources in a batch must have the same number of groups.");
+    Insist(d_sources[i]->is_discrete() == d_discrete,
+           "All sources in a batch must be discrete or all moment sources.");
+  }
+}
+
+//----------------------------------------------------------------------------//
+BatchSource::SP_batchsource
+BatchSource::Create(const vec_externalsource &sources,
+                    SP_mesh                   mesh,
+                    SP_quadrature             quadrature)
+{
+  SP_batchsource p(new BatchSource(sources, mesh, quadrature));
+  return p;
+}
+
+} // end namespace detran_external_source
+
+//----------------------------------------------------------------------------//
+//              end of BatchSource.cc
+//----------------------------------------------------------------------------//
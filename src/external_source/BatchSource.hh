@@ -0,0 +1,114 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  BatchSource.hh
+ *  @brief BatchSource class definition
+ *  @note  Copyright (C) Jeremy Roberts 2012-2013
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_external_source_BATCHSOURCE_HH_
+#define detran_external_source_BATCHSOURCE_HH_
+
+#include "ExternalSource.hh"
+
+namespace detran_external_source
+{
+
+//----------------------------------------------------------------------------//
+/**
+ *  @class BatchSource
+ *  @brief Forwards to one of several sources selected by the client
+ *
+ *  A batch of fixed source problems shares everything but the external
+ *  source.  The solvers hold on to their sources and evaluate them on
+ *  each sweep or solve, so handing them a batch source once and
+ *  changing the selection between solves lets one set of solvers,
+ *  operators, and preconditioners serve every source in the batch.
+ *
+ *  All sources in the batch must have the same number of groups and
+ *  must be either all discrete or all moment sources.
+ */
+//----------------------------------------------------------------------------//
+
+class EXTERNAL_SOURCE_EXPORT BatchSource: public ExternalSource
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<BatchSource>   SP_batchsource;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param sources        Sources in the batch
+   *  @param mesh           Pointer to mesh
+   *  @param quadrature     Pointer to quadrature (optional)
+   */
+  BatchSource(const vec_externalsource &sources,
+              SP_mesh                   mesh,
+              SP_quadrature             quadrature = SP_quadrature(0));
+
+  /// SP constructor
+  static SP_batchsource
+  Create(const vec_externalsource &sources,
+         SP_mesh                   mesh,
+         SP_quadrature             quadrature = SP_quadrature(0));
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /// Number of sources in the batch
+  size_t number_sources() const { return d_sources.size(); }
+
+  /// Select the source to which all evaluations are forwarded
+  void select(const size_t i)
+  {
+    Require(i < d_sources.size());
+    d_selected = i;
+  }
+
+  /// Index of the selected source
+  size_t selected() const { return d_selected; }
+
+  //--------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL EXTERNAL SOURCES MUST IMPLEMENT THESE
+  //--------------------------------------------------------------------------//
+
+  double source(const size_t cell, const size_t group)
+  {
+    return d_sources[d_selected]->source(cell, group);
+  }
+
+  double source(const size_t cell, const size_t group, const size_t angle)
+  {
+    return d_sources[d_selected]->source(cell, group, angle);
+  }
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Sources in the batch
+  vec_externalsource d_sources;
+  /// Selected source
+  size_t d_selected;
+
+};
+
+} // end namespace detran_external_source
+
+#endif /* detran_external_source_BATCHSOURCE_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of BatchSource.hh
+//----------------------------------------------------------------------------//
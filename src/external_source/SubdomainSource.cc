@@ -0,0 +1,47 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  SubdomainSource.cc
+ *  @brief SubdomainSource member definitions
+ *  @note  Copyright (C) Jeremy Roberts 2012-2013
+ */
+//----------------------------------------------------------------------------//
+
+#include "SubdomainSource.hh"
+
+namespace detran_external_source
+{
+
+//----------------------------------------------------------------------------//
+SubdomainSource::SubdomainSource(SP_externalsource source,
+                                 SP_mesh           mesh,
+                                 const vec_int    &global_cells,
+                                 SP_quadrature     quadrature)
+  : ExternalSource(source ? source->number_groups() : 1,
+                   mesh,
+                   quadrature,
+                   source ? source->is_discrete() : false)
+  , d_source(source)
+  , d_global_cells(global_cells)
+{
+  Insist(d_source, "A subdomain source needs a global source.");
+  Insist(d_global_cells.size() == mesh->number_cells(),
+         "A subdomain source needs one global cell per subdomain cell.");
+}
+
+//----------------------------------------------------------------------------//
+SubdomainSource::SP_subdomainsource
+SubdomainSource::Create(SP_externalsource source,
+                        SP_mesh           mesh,
+                        const vec_int    &global_cells,
+                        SP_quadrature     quadrature)
+{
+  SP_subdomainsource p(new SubdomainSource(source, mesh,
+                                           global_cells, quadrature));
+  return p;
+}
+
+} // end namespace detran_external_source
+
+//----------------------------------------------------------------------------//
+//              end of SubdomainSource.cc
+//----------------------------------------------------------------------------//
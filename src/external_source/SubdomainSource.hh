@@ -0,0 +1,98 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  SubdomainSource.hh
+ *  @brief SubdomainSource class definition
+ *  @note  Copyright (C) Jeremy Roberts 2012-2013
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_external_source_SUBDOMAINSOURCE_HH_
+#define detran_external_source_SUBDOMAINSOURCE_HH_
+
+#include "ExternalSource.hh"
+
+namespace detran_external_source
+{
+
+//----------------------------------------------------------------------------//
+/**
+ *  @class SubdomainSource
+ *  @brief Restricts a source defined on a global mesh to a subdomain
+ *
+ *  When a mesh is decomposed, the external sources are still defined
+ *  on the global mesh.  This source forwards each evaluation on a
+ *  subdomain cell to the corresponding cell of the global mesh.
+ */
+//----------------------------------------------------------------------------//
+
+class EXTERNAL_SOURCE_EXPORT SubdomainSource: public ExternalSource
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<SubdomainSource>   SP_subdomainsource;
+  typedef detran_utilities::vec_int               vec_int;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param source         Source on the global mesh
+   *  @param mesh           Subdomain mesh
+   *  @param global_cells   Global cell of each subdomain cell
+   *  @param quadrature     Pointer to quadrature (optional)
+   */
+  SubdomainSource(SP_externalsource source,
+                  SP_mesh           mesh,
+                  const vec_int    &global_cells,
+                  SP_quadrature     quadrature = SP_quadrature(0));
+
+  /// SP constructor
+  static SP_subdomainsource
+  Create(SP_externalsource source,
+         SP_mesh           mesh,
+         const vec_int    &global_cells,
+         SP_quadrature     quadrature = SP_quadrature(0));
+
+  //--------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL EXTERNAL SOURCES MUST IMPLEMENT THESE
+  //--------------------------------------------------------------------------//
+
+  double source(const size_t cell, const size_t group)
+  {
+    Require(cell < d_global_cells.size());
+    return d_source->source(d_global_cells[cell], group);
+  }
+
+  double source(const size_t cell, const size_t group, const size_t angle)
+  {
+    Require(cell < d_global_cells.size());
+    return d_source->source(d_global_cells[cell], group, angle);
+  }
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Source on the global mesh
+  SP_externalsource d_source;
+  /// Global cell indices
+  vec_int d_global_cells;
+
+};
+
+} // end namespace detran_external_source
+
+#endif /* detran_external_source_SUBDOMAINSOURCE_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of SubdomainSource.hh
+//----------------------------------------------------------------------------//
@@ -13,6 +13,8 @@
 #include "external_source/ConstantSource.hh"
 #include "external_source/DiscreteSource.hh"
 #include "external_source/IsotropicSource.hh"
+#include "external_source/BatchSource.hh"
+#include "external_source/SubdomainSource.hh"
 %}
 
 %feature("autodoc", "3");
@@ -34,11 +36,15 @@
 %include "ConstantSource.hh"
 %include "DiscreteSource.hh"
 %include "IsotropicSource.hh"
+%include "BatchSource.hh"
+%include "SubdomainSource.hh"
 
 %template(ExternalSourceSP)  detran_utilities::SP<detran_external_source::ExternalSource>;
 %template(ConstantSourceSP)  detran_utilities::SP<detran_external_source::ConstantSource>;
 %template(DiscreteSourceSP)  detran_utilities::SP<detran_external_source::DiscreteSource>;
 %template(IsotropicSourceSP) detran_utilities::SP<detran_external_source::IsotropicSource>;
+%template(BatchSourceSP)     detran_utilities::SP<detran_external_source::BatchSource>;
+%template(SubdomainSourceSP) detran_utilities::SP<detran_external_source::SubdomainSource>;
 
 %template(vec_source) std::vector<detran_utilities::SP<detran_external_source::ExternalSource> >;
 
@@ -37,6 +37,14 @@ CSG_Primitive::intersections(c_Ray &r, c_dbl t_max)
   return d_surface->intersections(r, t_max);
 }
 
+//----------------------------------------------------------------------------//
+void CSG_Primitive::signature(vec_dbl &s) const
+{
+  s.push_back(PRIMITIVE_NODE);
+  s.push_back(d_sense);
+  d_surface->signature(s);
+}
+
 //----------------------------------------------------------------------------//
 // OPERATOR
 //----------------------------------------------------------------------------//
@@ -82,6 +90,14 @@ bool CSG_Union::contains(const Point &r) const
   return d_L->contains(r) || d_R->contains(r);
 }
 
+//----------------------------------------------------------------------------//
+void CSG_Union::signature(vec_dbl &s) const
+{
+  s.push_back(UNION_NODE);
+  d_L->signature(s);
+  d_R->signature(s);
+}
+
 //----------------------------------------------------------------------------//
 // INTERSECTION
 //----------------------------------------------------------------------------//
@@ -99,6 +115,14 @@ bool CSG_Intersection::contains(const Point &r) const
   return d_L->contains(r) && d_R->contains(r);
 }
 
+//----------------------------------------------------------------------------//
+void CSG_Intersection::signature(vec_dbl &s) const
+{
+  s.push_back(INTERSECTION_NODE);
+  d_L->signature(s);
+  d_R->signature(s);
+}
+
 //----------------------------------------------------------------------------//
 // DIFFERENCE
 //----------------------------------------------------------------------------//
@@ -118,6 +142,14 @@ bool CSG_Difference::contains(const Point &r) const
   return d_L->contains(r) && !d_R->contains(r);
 }
 
+//----------------------------------------------------------------------------//
+void CSG_Difference::signature(vec_dbl &s) const
+{
+  s.push_back(DIFFERENCE_NODE);
+  d_L->signature(s);
+  d_R->signature(s);
+}
+
 //----------------------------------------------------------------------------//
 // TRANSLATION
 //----------------------------------------------------------------------------//
@@ -147,6 +179,16 @@ bool CSG_Translation::contains(const Point &r) const
   return d_node->contains(r - d_translation);
 }
 
+//----------------------------------------------------------------------------//
+void CSG_Translation::signature(vec_dbl &s) const
+{
+  s.push_back(TRANSLATION_NODE);
+  s.push_back(d_translation.x());
+  s.push_back(d_translation.y());
+  s.push_back(d_translation.z());
+  d_node->signature(s);
+}
+
 } // namespace detran_geometry
 
 //----------------------------------------------------------------------------//
@@ -21,6 +21,13 @@ enum NODE_OPERATORS
   UNION, INTERSECTION, SUBSTRACTION, END_NODE_OPERATORS
 };
 
+/// Node types, as recorded in a node signature
+enum NODE_TYPES
+{
+  PRIMITIVE_NODE, UNION_NODE, INTERSECTION_NODE, DIFFERENCE_NODE,
+  TRANSLATION_NODE, RPP_NODE, RCC_NODE, RHP_NODE, END_NODE_TYPES
+};
+
 /**
  *  @class CSG_Node
  *  @brief Base class for nodes in a CSG tree
@@ -37,6 +44,7 @@ public:
   typedef detran_utilities::SP<CSG_Node>    SP_node;
   typedef detran_utilities::size_t          size_t;
   typedef std::vector<Point>                vec_point;
+  typedef detran_utilities::vec_dbl         vec_dbl;
   typedef const Ray                         c_Ray;
   typedef const Point                       c_Point;
   typedef const double                      c_dbl;
@@ -51,6 +59,14 @@ public:
   virtual bool contains(c_Point &r) const = 0;
   /// Where does the node intersect the ray?
   virtual vec_point intersections(c_Ray &r, c_dbl t_max) = 0;
+  /**
+   *  @brief Append numbers that identify the node exactly to s
+   *
+   *  The signature records the type of every node in the tree, the
+   *  sense of each primitive, and the coefficients of its surface, so
+   *  two nodes with equal signatures describe the same set of points.
+   */
+  virtual void signature(vec_dbl &s) const = 0;
 
 };
 
@@ -88,6 +104,7 @@ public:
   CSG_Primitive(SP_surface surface, bool sense);
   bool contains(c_Point &r) const;
   vec_point intersections(c_Ray &r, c_dbl t_max);
+  void signature(vec_dbl &s) const;
 
 private:
 
@@ -118,6 +135,7 @@ class CSG_Union: public CSG_Operator
 public:
   CSG_Union(SP_node L, SP_node R);
   bool contains(c_Point &r) const;
+  void signature(vec_dbl &s) const;
 };
 
 /// Intersection of two nodes
@@ -126,6 +144,7 @@ class CSG_Intersection: public CSG_Operator
 public:
   CSG_Intersection(SP_node L, SP_node R);
   bool contains(c_Point &r) const;
+  void signature(vec_dbl &s) const;
 };
 
 /// Difference of two nodes (specifically, L - R)
@@ -134,6 +153,7 @@ class CSG_Difference: public CSG_Operator
 public:
   CSG_Difference(SP_node L, SP_node R);
   bool contains(c_Point &r) const;
+  void signature(vec_dbl &s) const;
 };
 
 /**
@@ -147,6 +167,7 @@ public:
   CSG_Translation(SP_node node, c_Point &translation);
   vec_point intersections(c_Ray &r, c_dbl t_max);
   bool contains(c_Point &r) const;
+  void signature(vec_dbl &s) const;
 private:
   /// Node to be translated
   SP_node d_node;
@@ -39,6 +39,17 @@ Macrobody::intersections(const Ray &r, c_dbl t_max)
   return surface_points;
 }
 
+//----------------------------------------------------------------------------//
+void Macrobody::signature(vec_dbl &s) const
+{
+  s.push_back(d_origin.x());
+  s.push_back(d_origin.y());
+  s.push_back(d_origin.z());
+  s.push_back(d_surfaces.size());
+  for (size_t i = 0; i < d_surfaces.size(); ++i)
+    d_surfaces[i]->signature(s);
+}
+
 //----------------------------------------------------------------------------//
 // RPP
 //----------------------------------------------------------------------------//
@@ -72,6 +83,16 @@ RightParallelpiped::intersections(const Ray &r, c_dbl t_max)
   // \todo Implement this
 }
 
+//----------------------------------------------------------------------------//
+void RightParallelpiped::signature(vec_dbl &s) const
+{
+  s.push_back(RPP_NODE);
+  s.push_back(d_width);
+  s.push_back(d_length);
+  s.push_back(d_depth);
+  Macrobody::signature(s);
+}
+
 //----------------------------------------------------------------------------//
 // RCC
 //----------------------------------------------------------------------------//
@@ -93,6 +114,15 @@ RightCircularCylinder::intersections(const Ray &r, c_dbl t_max)
   // \todo Implement this
 }
 
+//----------------------------------------------------------------------------//
+void RightCircularCylinder::signature(vec_dbl &s) const
+{
+  s.push_back(RCC_NODE);
+  s.push_back(d_radius);
+  s.push_back(d_height);
+  Macrobody::signature(s);
+}
+
 //----------------------------------------------------------------------------//
 // RHP
 //----------------------------------------------------------------------------//
@@ -114,6 +144,15 @@ RightHexagonalPrism::intersections(const Ray &r, c_dbl t_max)
   // \todo Implement this
 }
 
+//----------------------------------------------------------------------------//
+void RightHexagonalPrism::signature(vec_dbl &s) const
+{
+  s.push_back(RHP_NODE);
+  s.push_back(d_length);
+  s.push_back(d_height);
+  Macrobody::signature(s);
+}
+
 } // namespace detran_geometry
 
 //----------------------------------------------------------------------------//
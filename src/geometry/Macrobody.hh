@@ -46,6 +46,8 @@ public:
   bool contains(c_Point &r) const;
   /// Where does the node intersect the ray?
   virtual vec_point intersections(const Ray &r, c_dbl t_max) = 0;
+  /// Append the origin and the surfaces to s
+  virtual void signature(vec_dbl &s) const;
 
 protected:
 
@@ -91,6 +93,8 @@ public:
   bool contains(c_Point &r) const;
   /// Where does the node intersect the ray?
   vec_point intersections(const Ray &r, c_dbl t_max);
+  /// Append the type, dimensions, origin, and surfaces to s
+  void signature(vec_dbl &s) const;
 
 private:
 
@@ -140,6 +144,8 @@ public:
   bool contains(c_Point &r) const;
   /// Where does the node intersect the ray?
   vec_point intersections(const Ray &r, c_dbl t_max);
+  /// Append the type, dimensions, origin, and surfaces to s
+  void signature(vec_dbl &s) const;
 
 private:
 
@@ -189,6 +195,8 @@ public:
   bool contains(c_Point &r) const;
   /// Where does the node intersect the ray?
   vec_point intersections(const Ray &r, c_dbl t_max);
+  /// Append the type, dimensions, origin, and surfaces to s
+  void signature(vec_dbl &s) const;
 
 private:
 
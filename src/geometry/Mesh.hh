@@ -246,6 +246,12 @@ public:
     d_tracks = tracks;
   }
 
+  /// Get the tracks (null if the mesh is not tracked)
+  SP_trackdb tracks() const
+  {
+    return d_tracks;
+  }
+
 protected:
 
   /// Mesh spatial dimension
@@ -0,0 +1,180 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  MeshPartitioner.cc
+ *  @brief MeshPartitioner member definitions
+ *  @note  Copyright (C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "MeshPartitioner.hh"
+#include "Mesh1D.hh"
+#include "Mesh2D.hh"
+#include "Mesh3D.hh"
+
+namespace detran_geometry
+{
+
+//----------------------------------------------------------------------------//
+MeshPartitioner::MeshPartitioner(SP_mesh        mesh,
+                                 const vec_int &number_parts,
+                                 const vec_int &subdomains)
+  : d_mesh(mesh)
+  , d_number_parts(3, 1)
+  , d_bounds(3)
+{
+  Require(d_mesh);
+  size_t dim = d_mesh->dimension();
+  Insist(number_parts.size() >= dim,
+         "The number of subdomains is needed for each dimension.");
+
+  // Split the cells of each dimension into nearly equal blocks.  Global
+  // edges are accumulated from zero.
+  std::vector<vec_dbl> edges(3);
+  for (size_t d = 0; d < 3; ++d)
+  {
+    size_t n = d_mesh->number_cells(d);
+    if (d < dim) d_number_parts[d] = number_parts[d];
+    Insist(d_number_parts[d] > 0 && d_number_parts[d] <= n,
+           "Each dimension needs between one and its number of cells "
+           "subdomains.");
+    d_bounds[d].resize(d_number_parts[d] + 1, 0);
+    for (size_t p = 0; p <= d_number_parts[d]; ++p)
+      d_bounds[d][p] = (p * n) / d_number_parts[d];
+    edges[d].resize(n + 1, 0.0);
+    for (size_t i = 0; i < n; ++i)
+      edges[d][i + 1] = edges[d][i] + d_mesh->width(d, i);
+  }
+
+  size_t number_subdomains = d_number_parts[0] *
+                             d_number_parts[1] *
+                             d_number_parts[2];
+  d_meshes.resize(number_subdomains);
+  d_neighbors.resize(number_subdomains, vec_int(2 * dim, -1));
+
+  const Mesh::mesh_map_type &maps = d_mesh->get_mesh_map();
+  Insist(maps.find("MATERIAL") != maps.end(),
+         "The mesh to be partitioned needs a material map.");
+
+  // Neighbors
+  int stride[] = {1, d_number_parts[0], d_number_parts[0] * d_number_parts[1]};
+  for (size_t s = 0; s < number_subdomains; ++s)
+  {
+    size_t p[3];
+    block(s, p);
+    for (size_t d = 0; d < dim; ++d)
+    {
+      if (p[d] > 0)
+        d_neighbors[s][2 * d] = s - stride[d];
+      if (p[d] + 1 < d_number_parts[d])
+        d_neighbors[s][2 * d + 1] = s + stride[d];
+    }
+  }
+
+  // Subdomain meshes
+  if (subdomains.empty())
+  {
+    for (size_t s = 0; s < number_subdomains; ++s)
+      build_mesh(s, edges);
+  }
+  for (size_t i = 0; i < subdomains.size(); ++i)
+  {
+    Insist(subdomains[i] >= 0 && (size_t)subdomains[i] < number_subdomains,
+           "Subdomain to be built is out of range.");
+    build_mesh(subdomains[i], edges);
+  }
+}
+
+//----------------------------------------------------------------------------//
+MeshPartitioner::SP_partitioner
+MeshPartitioner::Create(SP_mesh        mesh,
+                        const vec_int &number_parts,
+                        const vec_int &subdomains)
+{
+  SP_partitioner p(new MeshPartitioner(mesh, number_parts, subdomains));
+  return p;
+}
+
+//----------------------------------------------------------------------------//
+MeshPartitioner::size_t MeshPartitioner::number_cells(const size_t s) const
+{
+  Require(s < d_meshes.size());
+  size_t p[3];
+  block(s, p);
+  size_t n = 1;
+  for (size_t d = 0; d < 3; ++d)
+    n *= d_bounds[d][p[d] + 1] - d_bounds[d][p[d]];
+  return n;
+}
+
+//----------------------------------------------------------------------------//
+MeshPartitioner::vec_int MeshPartitioner::global_cells(const size_t s) const
+{
+  Require(s < d_meshes.size());
+  size_t p[3];
+  block(s, p);
+  vec_int cells;
+  cells.reserve(number_cells(s));
+  for (int k = d_bounds[2][p[2]]; k < d_bounds[2][p[2] + 1]; ++k)
+    for (int j = d_bounds[1][p[1]]; j < d_bounds[1][p[1] + 1]; ++j)
+      for (int i = d_bounds[0][p[0]]; i < d_bounds[0][p[0] + 1]; ++i)
+        cells.push_back(d_mesh->index(i, j, k));
+  return cells;
+}
+
+//----------------------------------------------------------------------------//
+void MeshPartitioner::block(const size_t s, size_t p[3]) const
+{
+  Require(s < d_meshes.size());
+  p[0] = s % d_number_parts[0];
+  p[1] = (s / d_number_parts[0]) % d_number_parts[1];
+  p[2] = s / (d_number_parts[0] * d_number_parts[1]);
+}
+
+//----------------------------------------------------------------------------//
+void MeshPartitioner::build_mesh(const size_t                 s,
+                                 const std::vector<vec_dbl>  &edges)
+{
+  size_t dim = d_mesh->dimension();
+  size_t p[3];
+  block(s, p);
+
+  // Subdomain edges and global cells
+  std::vector<vec_dbl> e(3);
+  for (size_t d = 0; d < dim; ++d)
+  {
+    e[d].assign(edges[d].begin() + d_bounds[d][p[d]],
+                edges[d].begin() + d_bounds[d][p[d] + 1] + 1);
+  }
+  vec_int cells = global_cells(s);
+
+  // Restrict the fine mesh maps, including the materials
+  const Mesh::mesh_map_type &maps = d_mesh->get_mesh_map();
+  std::vector<std::pair<std::string, vec_int> > local_maps;
+  Mesh::mesh_map_type::const_iterator it = maps.begin();
+  for (; it != maps.end(); ++it)
+  {
+    vec_int m(cells.size(), 0);
+    for (size_t c = 0; c < cells.size(); ++c)
+      m[c] = it->second[cells[c]];
+    local_maps.push_back(std::make_pair(it->first, m));
+  }
+  vec_int mat = local_maps[0].second;
+  for (size_t m = 0; m < local_maps.size(); ++m)
+    if (local_maps[m].first == "MATERIAL") mat = local_maps[m].second;
+
+  // Build the subdomain mesh
+  if (dim == 1)
+    d_meshes[s] = Mesh1D::Create(e[0], mat);
+  else if (dim == 2)
+    d_meshes[s] = Mesh2D::Create(e[0], e[1], mat);
+  else
+    d_meshes[s] = Mesh3D::Create(e[0], e[1], e[2], mat);
+  for (size_t m = 0; m < local_maps.size(); ++m)
+    d_meshes[s]->add_mesh_map(local_maps[m].first, local_maps[m].second);
+}
+
+} // end namespace detran_geometry
+
+//----------------------------------------------------------------------------//
+//              end of file MeshPartitioner.cc
+//----------------------------------------------------------------------------//
@@ -0,0 +1,147 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  MeshPartitioner.hh
+ *  @brief MeshPartitioner class definition
+ *  @note  Copyright (C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_geometry_MESHPARTITIONER_HH_
+#define detran_geometry_MESHPARTITIONER_HH_
+
+#include "Mesh.hh"
+#include "utilities/DBC.hh"
+#include "utilities/SP.hh"
+#include <vector>
+
+namespace detran_geometry
+{
+
+/**
+ *  @class MeshPartitioner
+ *  @brief Partition a Cartesian mesh into a logical grid of subdomains
+ *
+ *  The cells along each dimension are split into contiguous blocks
+ *  whose sizes differ by at most one, and each subdomain is one
+ *  block in each dimension.  Subdomains are numbered like cells,
+ *  i.e. with x varying fastest.  Each subdomain mesh has one coarse
+ *  region per fine cell and carries all fine mesh maps of the global
+ *  mesh restricted to its cells.
+ *
+ *  Only the meshes of the subdomains given at construction are built,
+ *  so a process can hold just its own.  The cells and neighbors of any
+ *  subdomain follow from the blocks and are always available.
+ *
+ *  Neighbors are indexed by side using the ordering of Mesh::SIDES.
+ */
+class GEOMETRY_EXPORT MeshPartitioner
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<MeshPartitioner>   SP_partitioner;
+  typedef Mesh::SP_mesh                           SP_mesh;
+  typedef detran_utilities::vec_int               vec_int;
+  typedef detran_utilities::vec2_int              vec2_int;
+  typedef detran_utilities::vec_dbl               vec_dbl;
+  typedef detran_utilities::size_t                size_t;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param mesh           Global mesh
+   *  @param number_parts   Subdomains along each dimension of the mesh
+   *  @param subdomains     Subdomains whose meshes are built (all if empty)
+   */
+  MeshPartitioner(SP_mesh        mesh,
+                  const vec_int &number_parts,
+                  const vec_int &subdomains = vec_int());
+
+  /// SP constructor
+  static SP_partitioner Create(SP_mesh        mesh,
+                               const vec_int &number_parts,
+                               const vec_int &subdomains = vec_int());
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /// Global mesh
+  SP_mesh global_mesh() const { return d_mesh; }
+
+  /// Total number of subdomains
+  size_t number_subdomains() const { return d_meshes.size(); }
+
+  /// Number of subdomains along a dimension
+  size_t number_subdomains(const size_t dim) const
+  {
+    Require(dim < 3);
+    return d_number_parts[dim];
+  }
+
+  /// Was the mesh of a subdomain built?
+  bool has_mesh(const size_t s) const
+  {
+    Require(s < d_meshes.size());
+    return d_meshes[s];
+  }
+
+  /// Mesh of a subdomain, which must have been built
+  SP_mesh mesh(const size_t s) const
+  {
+    Require(has_mesh(s));
+    return d_meshes[s];
+  }
+
+  /// Number of cells of a subdomain
+  size_t number_cells(const size_t s) const;
+
+  /// Global cell of each cell of a subdomain
+  vec_int global_cells(const size_t s) const;
+
+  /// Neighbor of a subdomain across a side, or -1 on the global boundary
+  int neighbor(const size_t s, const size_t side) const
+  {
+    Require(s < d_neighbors.size());
+    Require(side < 2 * d_mesh->dimension());
+    return d_neighbors[s][side];
+  }
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Global mesh
+  SP_mesh d_mesh;
+  /// Subdomains along each dimension (unity for unused dimensions)
+  vec_int d_number_parts;
+  /// First global cell index of each block, by dimension
+  vec2_int d_bounds;
+  /// Subdomain meshes, null unless built
+  std::vector<SP_mesh> d_meshes;
+  /// Neighbors of each subdomain by side
+  vec2_int d_neighbors;
+
+  /// Block index along each dimension of a subdomain
+  void block(const size_t s, size_t p[3]) const;
+  /// Build the mesh of a subdomain
+  void build_mesh(const size_t s, const std::vector<vec_dbl> &edges);
+
+};
+
+} // end namespace detran_geometry
+
+#endif /* detran_geometry_MESHPARTITIONER_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of file MeshPartitioner.hh
+//----------------------------------------------------------------------------//
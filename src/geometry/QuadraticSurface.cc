@@ -83,6 +83,13 @@ QuadraticSurface::intersections(const Ray     &r,
   return points;
 }
 
+//----------------------------------------------------------------------------//
+void QuadraticSurface::signature(vec_dbl &s) const
+{
+  double c[] = {d_A, d_B, d_C, d_D, d_E, d_F, d_G, d_H, d_I, d_J};
+  s.insert(s.end(), c, c + 10);
+}
+
 } // end namespace detran_geometry
 
 //----------------------------------------------------------------------------//
@@ -104,6 +104,9 @@ public:
   virtual vec_point intersections(const Ray &ray,
                                   c_double   t_max = -1);
 
+  /// Append the ten coefficients to s
+  virtual void signature(vec_dbl &s) const;
+
 
 protected:
 
@@ -84,6 +84,12 @@ public:
   /// Return lower bound
   Point bound_max() const;
 
+  /// Was a bounding box given?
+  bool has_bounding_box() const {return d_have_bound;}
+
+  /// Is the bounding box bounded in z (i.e. not a 2-D box)?
+  bool has_bounding_box_z() const {return d_have_bound_z;}
+
 private:
 
   //--------------------------------------------------------------------------//
@@ -0,0 +1,198 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  RegionBVH.cc
+ *  @brief RegionBVH member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "RegionBVH.hh"
+#include <algorithm>
+
+namespace detran_geometry
+{
+
+//----------------------------------------------------------------------------//
+// orders region indices by one coordinate of their box centers
+struct CenterCompare
+{
+  CenterCompare(const std::vector<Point> &c, const int d)
+    : d_center(c), d_dim(d) {/* ... */}
+  bool operator()(const RegionBVH::size_t a, const RegionBVH::size_t b) const
+  {
+    return d_center[a][d_dim] < d_center[b][d_dim];
+  }
+  const std::vector<Point> &d_center;
+  int d_dim;
+};
+
+//----------------------------------------------------------------------------//
+RegionBVH::RegionBVH(SP_geometry geo, const size_t leaf_size)
+  : d_geometry(geo)
+  , d_leaf_size(leaf_size)
+{
+  Require(d_geometry);
+  Require(d_leaf_size > 0);
+
+  size_t nr = d_geometry->number_regions();
+  d_center.resize(nr);
+  for (size_t r = 0; r < nr; ++r)
+  {
+    Region::SP_region region = d_geometry->region(r);
+    if (region->has_bounding_box())
+    {
+      d_index.push_back(r);
+      d_center[r] = 0.5 * (region->bound_min() + region->bound_max());
+    }
+    else
+    {
+      d_unbounded.push_back(r);
+    }
+  }
+
+  if (!d_index.empty())
+  {
+    d_nodes.reserve(2 * d_index.size() / d_leaf_size + 1);
+    build(0, d_index.size());
+  }
+
+  // Centers are only needed to build the tree.
+  std::vector<Point>().swap(d_center);
+}
+
+//----------------------------------------------------------------------------//
+RegionBVH::SP_bvh RegionBVH::Create(SP_geometry geo, const size_t leaf_size)
+{
+  SP_bvh p(new RegionBVH(geo, leaf_size));
+  return p;
+}
+
+//----------------------------------------------------------------------------//
+void RegionBVH::intersect(const Ray         &ray,
+                          const double       max_length,
+                          vec_size_t        &regions) const
+{
+  regions = d_unbounded;
+  if (d_nodes.empty()) return;
+
+  std::vector<int> stack(1, 0);
+  while (!stack.empty())
+  {
+    const Node &node = d_nodes[stack.back()];
+    stack.pop_back();
+    if (!intersects(node, ray, max_length)) continue;
+    if (node.left < 0)
+    {
+      // Leaves test each region's own box, which may be tighter.
+      for (size_t i = node.begin; i < node.end; ++i)
+      {
+        if (d_geometry->region(d_index[i])->
+              intersects_bounding_box(ray, max_length))
+        {
+          regions.push_back(d_index[i]);
+        }
+      }
+    }
+    else
+    {
+      stack.push_back(node.right);
+      stack.push_back(node.left);
+    }
+  }
+
+  // Keep the order of a loop over all regions.
+  std::sort(regions.begin(), regions.end());
+}
+
+//----------------------------------------------------------------------------//
+int RegionBVH::build(const size_t begin, const size_t end)
+{
+  Require(end > begin);
+
+  int n = d_nodes.size();
+  d_nodes.push_back(Node());
+
+  // Enclosing box, and the spread of the centers
+  Region::SP_region region = d_geometry->region(d_index[begin]);
+  Point lower = region->bound_min(), upper = region->bound_max();
+  Point c_lower = d_center[d_index[begin]], c_upper = c_lower;
+  bool has_z = region->has_bounding_box_z();
+  for (size_t i = begin + 1; i < end; ++i)
+  {
+    region = d_geometry->region(d_index[i]);
+    has_z = has_z && region->has_bounding_box_z();
+    for (int d = 0; d < 3; ++d)
+    {
+      lower[d]   = std::min(lower[d],   region->bound_min()[d]);
+      upper[d]   = std::max(upper[d],   region->bound_max()[d]);
+      c_lower[d] = std::min(c_lower[d], d_center[d_index[i]][d]);
+      c_upper[d] = std::max(c_upper[d], d_center[d_index[i]][d]);
+    }
+  }
+  d_nodes[n].lower = lower;
+  d_nodes[n].upper = upper;
+  d_nodes[n].has_z = has_z;
+  d_nodes[n].left  = -1;
+  d_nodes[n].right = -1;
+  d_nodes[n].begin = begin;
+  d_nodes[n].end   = end;
+
+  // Split at the median center along the axis of greatest spread.  Many
+  // regions (e.g. the rings of a pin) share a box, so stop if the centers
+  // cannot be separated.
+  int axis = 0;
+  for (int d = 1; d < 3; ++d)
+    if (c_upper[d] - c_lower[d] > c_upper[axis] - c_lower[axis]) axis = d;
+  if (end - begin <= d_leaf_size || c_upper[axis] == c_lower[axis])
+    return n;
+
+  size_t middle = begin + (end - begin) / 2;
+  std::nth_element(d_index.begin() + begin,
+                   d_index.begin() + middle,
+                   d_index.begin() + end,
+                   CenterCompare(d_center, axis));
+  int left  = build(begin, middle);
+  int right = build(middle, end);
+  d_nodes[n].left  = left;
+  d_nodes[n].right = right;
+  return n;
+}
+
+//----------------------------------------------------------------------------//
+bool RegionBVH::intersects(const Node   &node,
+                           const Ray    &r,
+                           const double  max_length)
+{
+  // Same slab test as Region::intersects_bounding_box, so a node's box
+  // passes whenever one of the boxes it encloses does.
+  const Point *b[2] = {&node.lower, &node.upper};
+  double tmin, tmax, tymin, tymax, tzmin, tzmax;
+  tmin  = (b[    r.sign[0]]->x() - r.origin.x()) * r.inv_direction.x();
+  tmax  = (b[1 - r.sign[0]]->x() - r.origin.x()) * r.inv_direction.x();
+  tymin = (b[    r.sign[1]]->y() - r.origin.y()) * r.inv_direction.y();
+  tymax = (b[1 - r.sign[1]]->y() - r.origin.y()) * r.inv_direction.y();
+  if ((tmin > tymax) || (tymin > tmax))
+    return false;
+  if (tymin > tmin)
+    tmin = tymin;
+  if (tymax < tmax)
+    tmax = tymax;
+  if (node.has_z)
+  {
+    tzmin = (b[    r.sign[2]]->z() - r.origin.z()) * r.inv_direction.z();
+    tzmax = (b[1 - r.sign[2]]->z() - r.origin.z()) * r.inv_direction.z();
+    if ((tmin > tzmax) || (tzmin > tmax))
+      return false;
+    if (tzmin > tmin)
+      tmin = tzmin;
+    if (tzmax < tmax)
+      tmax = tzmax;
+  }
+  return ((tmin < max_length) && (tmax > 0.0));
+}
+
+} // end namespace detran_geometry
+
+//----------------------------------------------------------------------------//
+//              end of file RegionBVH.cc
+//----------------------------------------------------------------------------//
@@ -0,0 +1,132 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  RegionBVH.hh
+ *  @brief RegionBVH class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_geometry_REGIONBVH_HH_
+#define detran_geometry_REGIONBVH_HH_
+
+#include "Geometry.hh"
+#include "Ray.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/SP.hh"
+#include <vector>
+
+namespace detran_geometry
+{
+
+/**
+ *  @class RegionBVH
+ *  @brief Bounding volume hierarchy over the region bounding boxes
+ *
+ *  The boxes of the regions in a geometry are split recursively at the
+ *  median of their centers along the axis of greatest spread, and each
+ *  node keeps the box enclosing its children.  A ray query descends
+ *  only into nodes whose boxes the ray crosses, so finding the regions
+ *  along a track costs about the log of the number of regions plus the
+ *  number of regions actually crossed, rather than the total number of
+ *  regions.
+ *
+ *  The regions returned are exactly those whose own boxes pass
+ *  Region::intersects_bounding_box, in increasing index order, plus all
+ *  regions that have no bounding box and so cannot be culled.
+ */
+class GEOMETRY_EXPORT RegionBVH
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<RegionBVH>     SP_bvh;
+  typedef Geometry::SP_geometry               SP_geometry;
+  typedef detran_utilities::size_t            size_t;
+  typedef detran_utilities::vec_size_t        vec_size_t;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param geo          Geometry whose regions are indexed
+   *  @param leaf_size    Maximum number of regions in a leaf
+   */
+  RegionBVH(SP_geometry geo, const size_t leaf_size = 4);
+
+  /// SP constructor
+  static SP_bvh Create(SP_geometry geo, const size_t leaf_size = 4);
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Find the regions whose bounding boxes a ray crosses
+   *  @param ray          Ray to trace
+   *  @param max_length   Length of the ray
+   *  @param regions      Indices of the candidate regions (overwritten)
+   */
+  void intersect(const Ray &ray, const double max_length,
+                 vec_size_t &regions) const;
+
+  /// Number of tree nodes
+  size_t number_nodes() const { return d_nodes.size(); }
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Tree node; a leaf has no children and owns d_index[begin, end)
+  struct Node
+  {
+    Point lower;
+    Point upper;
+    /// Whether the box is bounded in z (otherwise a 2-D box)
+    bool  has_z;
+    int   left;
+    int   right;
+    size_t begin;
+    size_t end;
+  };
+
+  /// Geometry whose regions are indexed
+  SP_geometry d_geometry;
+  /// Nodes, with the root first
+  std::vector<Node> d_nodes;
+  /// Region indices ordered so that each leaf is contiguous
+  vec_size_t d_index;
+  /// Regions that have no bounding box
+  vec_size_t d_unbounded;
+  /// Region box centers used during the build
+  std::vector<Point> d_center;
+  /// Maximum regions per leaf
+  size_t d_leaf_size;
+
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  /// Build the subtree over d_index[begin, end) and return its node
+  int build(const size_t begin, const size_t end);
+
+  /// Does a ray cross a box within the given length?
+  static bool intersects(const Node &node, const Ray &ray,
+                         const double max_length);
+
+};
+
+} // end namespace detran_geometry
+
+#endif /* detran_geometry_REGIONBVH_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of file RegionBVH.hh
+//----------------------------------------------------------------------------//
@@ -10,6 +10,7 @@
 #define detran_geometry_SURFACE_HH_
 
 #include "geometry/Ray.hh"
+#include "utilities/Definitions.hh"
 #include "utilities/SP.hh"
 
 namespace detran_geometry
@@ -31,6 +32,7 @@ public:
   typedef detran_utilities::SP<Surface>   SP_surface;
   typedef std::vector<SP_surface>         vec_surface;
   typedef std::vector<Point>              vec_point;
+  typedef detran_utilities::vec_dbl       vec_dbl;
 
   //--------------------------------------------------------------------------//
   // CONSTRUCTOR AND DESTRUCTOR
@@ -73,6 +75,9 @@ public:
   virtual vec_point intersections(const Ray    &ray,
                                   const double  t_max = -1) = 0;
 
+  /// Append the numbers that define the surface exactly to s
+  virtual void signature(vec_dbl &s) const = 0;
+
 };
 
 
@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------//
 
 #include "TrackDB.hh"
+#include "TrackFile.hh"
 #include "utilities/TinyVector.hh"
 #include <iostream>
 
@@ -14,13 +15,25 @@ namespace detran_geometry
 {
 #define COUT(c) std::cout << c << std::endl;
 //----------------------------------------------------------------------------//
-TrackDB::TrackDB(SP_quadrature q)
+TrackDB::TrackDB(SP_quadrature q, const size_t dimension)
   : d_quadrature(q)
   , d_number_polar(1)
+  , d_released(false)
+  , d_flat_angle_offset(0)
+  , d_flat_track_offset(0)
+  , d_flat_track_width(0)
+  , d_flat_segment_region(0)
+  , d_flat_segment_length(0)
+  , d_flat_number_tracks(0)
+  , d_flat_number_segments(0)
+  , d_flat_exit_side(0)
+  , d_flat_link(0)
 {
   Require(d_quadrature);
+  Require(dimension == 0 || dimension == 2 ||
+          dimension == d_quadrature->dimension());
 
-  d_dimension = d_quadrature->dimension();
+  d_dimension = dimension ? dimension : d_quadrature->dimension();
   if (d_dimension == 2)
   {
     d_number_azimuths = d_quadrature->number_azimuths_octant() * 2;
@@ -36,9 +49,16 @@ TrackDB::TrackDB(SP_quadrature q)
   Ensure(d_number_azimuths > 0);
 }
 
+//----------------------------------------------------------------------------//
+TrackDB::~TrackDB()
+{
+  /* ... */
+}
+
 //----------------------------------------------------------------------------//
 TrackDB::SP_track TrackDB::track(c_size_t a, c_size_t p, c_size_t t)
 {
+  Insist(!d_released, "The Track objects have been released.");
   Require(a < d_tracks.size());
   Require(p < d_tracks[a].size());
   Require(t < d_tracks[a][p].size());
@@ -72,6 +92,11 @@ TrackDB::size_t TrackDB::number_tracks(c_size_t a, c_size_t p) const
 {
   Require(a < d_tracks.size());
   Require(p < d_tracks[a].size());
+  if (d_released)
+  {
+    size_t i = a * d_number_polar + p;
+    return d_flat_angle_offset[i + 1] - d_flat_angle_offset[i];
+  }
   return d_tracks[a][p].size();
 }
 
@@ -82,6 +107,7 @@ void TrackDB::add_track(c_size_t a, c_size_t p, SP_track t)
   Requirev(a < d_tracks.size(), AsString(a)+" !< "+AsString(d_tracks.size()));
   Require(p < d_tracks[a].size());
   Require(t);
+  Insist(!is_flat(), "Tracks cannot be added after flattening.");
   d_tracks[a][p].push_back(t);
 }
 
@@ -96,6 +122,21 @@ void TrackDB::normalize(const vec_dbl &volume)
     for (size_t p = 0; p < d_tracks[a].size(); ++p)
     {
       if (d_dimension == 3) a_wt *= d_quadrature->polar_weight(p)/2.0;
+      if (d_released)
+      {
+        size_t t0 = d_flat_angle_offset[a * d_number_polar + p];
+        size_t t1 = d_flat_angle_offset[a * d_number_polar + p + 1];
+        for (size_t t = t0; t < t1; ++t)
+        {
+          for (size_t s = segment_begin(t); s < segment_end(t); ++s)
+          {
+            size_t region = segment_region(s);
+            Assert(region < volume.size());
+            volume_appx[region] += segment_length(s) * track_width(t) * a_wt;
+          }
+        }
+        continue;
+      }
       for (size_t t = 0; t < d_tracks[a][p].size(); t++)
       {
         SP_track trk =  d_tracks[a][p][t];
@@ -129,6 +170,19 @@ void TrackDB::normalize(const vec_dbl &volume)
       }
     }
   }
+  // Keep the flat lengths consistent.  Mapped lengths are read only, so
+  // they are copied first.
+  if (d_file)
+  {
+    d_segment_length.assign(d_flat_segment_length,
+                            d_flat_segment_length + d_flat_number_segments);
+    d_flat_segment_length = &d_segment_length[0];
+  }
+  for (size_t s = 0; s < d_segment_length.size(); ++s)
+  {
+    size_t r = d_flat_segment_region[s];
+    d_segment_length[s] *= volume[r] / volume_appx[r];
+  }
 }
 
 //----------------------------------------------------------------------------//
@@ -197,13 +251,15 @@ struct TrackEntranceCompare
 //----------------------------------------------------------------------------//
 void TrackDB::sort()
 {
+  Insist(!is_flat(), "Tracks cannot be sorted after flattening.");
   size_t nq = (d_dimension == 2) ? 2 : 4;
   size_t na = d_quadrature->number_azimuths_octant();
   for (size_t q = 0; q < nq; ++q)
   {
     for (size_t a = 0; a < na; ++a)
     {
-      for (size_t p = 0; p < d_quadrature->number_polar_octant(); ++p)
+      // In 2D, the tracks are shared by all polar angles.
+      for (size_t p = 0; p < d_number_polar; ++p)
       {
         std::sort(d_tracks[a+na*q][p].begin(),
                   d_tracks[a+na*q][p].end(),
@@ -213,6 +269,78 @@ void TrackDB::sort()
   }
 }
 
+//----------------------------------------------------------------------------//
+void TrackDB::flatten(const bool release)
+{
+  Insist(!is_flat(), "Tracks have already been flattened.");
+
+  // Count so that every array is allocated exactly once.
+  size_t number_tracks = 0, number_segments = 0;
+  for (size_t a = 0; a < d_number_azimuths; ++a)
+  {
+    for (size_t p = 0; p < d_number_polar; ++p)
+    {
+      number_tracks += d_tracks[a][p].size();
+      for (size_t t = 0; t < d_tracks[a][p].size(); ++t)
+        number_segments += d_tracks[a][p][t]->number_segments();
+    }
+  }
+  d_angle_offset.resize(d_number_azimuths * d_number_polar + 1, 0);
+  d_track_offset.resize(number_tracks + 1, 0);
+  d_track_width.resize(number_tracks, 0.0);
+  d_segment_region.resize(number_segments, 0);
+  d_segment_length.resize(number_segments, 0.0);
+
+  size_t track = 0, segment = 0;
+  for (size_t a = 0; a < d_number_azimuths; ++a)
+  {
+    for (size_t p = 0; p < d_number_polar; ++p)
+    {
+      d_angle_offset[a * d_number_polar + p] = track;
+      for (size_t t = 0; t < d_tracks[a][p].size(); ++t, ++track)
+      {
+        const Track &trk = *d_tracks[a][p][t];
+        d_track_offset[track] = segment;
+        d_track_width[track] = trk.width();
+        for (size_t s = 0; s < trk.number_segments(); ++s, ++segment)
+        {
+          d_segment_region[segment] = trk.segment(s).region();
+          d_segment_length[segment] = trk.segment(s).length();
+        }
+      }
+    }
+  }
+  d_angle_offset.back() = track;
+  d_track_offset.back() = segment;
+
+  d_flat_angle_offset    = &d_angle_offset[0];
+  d_flat_track_offset    = &d_track_offset[0];
+  d_flat_track_width     = number_tracks   ? &d_track_width[0]    : 0;
+  d_flat_segment_region  = number_segments ? &d_segment_region[0] : 0;
+  d_flat_segment_length  = number_segments ? &d_segment_length[0] : 0;
+  d_flat_number_tracks   = number_tracks;
+  d_flat_number_segments = number_segments;
+
+  if (release)
+  {
+    for (size_t a = 0; a < d_number_azimuths; ++a)
+      for (size_t p = 0; p < d_number_polar; ++p)
+        vec_track().swap(d_tracks[a][p]);
+    d_released = true;
+  }
+}
+
+//----------------------------------------------------------------------------//
+void TrackDB::set_links(const vec_int &exit_side, const vec_int &link)
+{
+  Require(!exit_side.empty());
+  Require(link.size() == END_LINKS * exit_side.size());
+  d_exit_side      = exit_side;
+  d_link           = link;
+  d_flat_exit_side = &d_exit_side[0];
+  d_flat_link      = &d_link[0];
+}
+
 //----------------------------------------------------------------------------//
 void TrackDB::display() const
 {
@@ -231,6 +359,19 @@ void TrackDB::display() const
     for (size_t p = 0; p < d_tracks[a].size(); ++p)
     {
       cout << "      polar = " << p << endl;
+      if (d_released)
+      {
+        size_t t0 = d_flat_angle_offset[a * d_number_polar + p];
+        size_t t1 = d_flat_angle_offset[a * d_number_polar + p + 1];
+        for (size_t t = t0; t < t1; ++t)
+        {
+          cout << "        track = " << t - t0
+               << " width = " << track_width(t) << endl;
+          for (size_t s = segment_begin(t); s < segment_end(t); ++s)
+            cout << "          region = " << segment_region(s)
+                 << " length = " << segment_length(s) << endl;
+        }
+      }
       for (size_t t = 0; t < d_tracks[a][p].size(); ++t)
       {
         Assert(d_tracks[a][p][t]);
@@ -21,6 +21,8 @@
 namespace detran_geometry
 {
 
+class TrackFile;
+
 /**
  *  @class TrackDB
  *  @brief Database of tracks.
@@ -35,6 +37,23 @@ namespace detran_geometry
  *  an angle.  The client needs to post process to obtain proper indexing,
  *  e.g. for boundary conditions.
  *
+ *  Tracks are built as individual Track objects, but sweeping them that
+ *  way chases a pointer and a separate segment vector for every track.
+ *  Once tracking is complete, flatten() copies all segments into one
+ *  contiguous structure of arrays (region indices and lengths), with
+ *  per-track segment offsets and widths.  Tracks are numbered angle by
+ *  angle, so track t of angle (a, p) is flat track first_track(a, p) + t,
+ *  and t is also its boundary flux index.  The Track objects can then be
+ *  released to save memory.  The flat arrays can also be mapped from a
+ *  track file written by an earlier run (see TrackFile), in which case
+ *  there are no Track objects at all.
+ *
+ *  With cyclic tracking, every track ends where others begin, and the
+ *  database also records, for each track and direction, the side it
+ *  leaves through and the track it leads into if that side reflects or
+ *  is periodic.  Links are given as directed flat tracks, i.e.
+ *  2 * track + direction.
+ *
  */
 /**
  *  @example geometry/test/test_TrackDB.cc
@@ -55,6 +74,12 @@ public:
     BACKWARD, FORWARD, END_DIRECTIONS
   };
 
+  /// Kinds of boundary crossing between linked tracks
+  enum LINKS
+  {
+    REFLECT, PERIODIC, END_LINKS
+  };
+
   //--------------------------------------------------------------------------//
   // TYPEDEFS
   //--------------------------------------------------------------------------//
@@ -80,9 +105,16 @@ public:
 
   /**
    *  @brief Constructor
-   *  @param    q   product quadrature
+   *  @param    q           product quadrature
+   *  @param    dimension   dimension of the tracks, which defaults to that
+   *                        of the quadrature; 2-D tracks of a 3-D
+   *                        quadrature are the radial projections of
+   *                        axially extruded 3-D tracks
    */
-  TrackDB(SP_quadrature q);
+  TrackDB(SP_quadrature q, const size_t dimension = 0);
+
+  /// Destructor
+  ~TrackDB();
 
   //--------------------------------------------------------------------------//
   // PUBLIC FUNCTIONS
@@ -144,8 +176,75 @@ public:
   /// Pretty display of all track
   void display() const;
 
+  //--------------------------------------------------------------------------//
+  // FLAT STORAGE
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Build the flat track and segment arrays
+   *  @param    release   Drop the Track objects afterwards
+   */
+  void flatten(const bool release = false);
+
+  /// Have the flat arrays been built?
+  bool is_flat() const { return d_flat_track_offset != 0; }
+
+  /// Are the Track objects still available?
+  bool has_tracks() const { return !d_released; }
+
+  /// Flat index of the first track for angle (a, p)
+  inline size_t first_track(c_size_t a, c_size_t p = 0) const;
+
+  /// Total number of tracks
+  inline size_t total_number_tracks() const;
+
+  /// Total number of segments
+  inline size_t total_number_segments() const;
+
+  /// Flat index of the first segment of a flat track
+  inline size_t segment_begin(c_size_t track) const;
+
+  /// One past the flat index of the last segment of a flat track
+  inline size_t segment_end(c_size_t track) const;
+
+  /// Width (or area) of a flat track
+  inline double track_width(c_size_t track) const;
+
+  /// Region of a flat segment
+  inline int segment_region(c_size_t segment) const;
+
+  /// Length of a flat segment
+  inline double segment_length(c_size_t segment) const;
+
+  /// Quadrature
+  SP_quadrature quadrature() const { return d_quadrature; }
+
+  //--------------------------------------------------------------------------//
+  // LINKS
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Set the links between flat tracks
+   *  @param    exit_side   Side left through by [2 * track + direction]
+   *  @param    link        Directed track entered next, or -1, by
+   *                        [(2 * track + direction) * END_LINKS + kind]
+   */
+  void set_links(const vec_int &exit_side, const vec_int &link);
+
+  /// Are the tracks linked?
+  bool is_linked() const { return d_flat_exit_side != 0; }
+
+  /// Side through which a flat track leaves in a direction
+  inline int exit_side(c_size_t track, c_size_t direction) const;
+
+  /// Directed flat track entered next across a side of a given kind
+  inline int link(c_size_t track, c_size_t direction, c_size_t kind) const;
+
 private:
 
+  /// The track file points the flat arrays into its mapping
+  friend class TrackFile;
+
   //--------------------------------------------------------------------------//
   // DATA
   //--------------------------------------------------------------------------//
@@ -160,6 +259,37 @@ private:
   size_t d_number_polar;
   /// Tracks by [azimuth][polar][space]
   vec3_track d_tracks;
+  /// Track objects have been released
+  bool d_released;
+  /// Flat index of the first track by [azimuth * number_polar + polar]
+  std::vector<size_t> d_angle_offset;
+  /// Flat index of the first segment of each track (plus the end)
+  std::vector<size_t> d_track_offset;
+  /// Track widths
+  vec_dbl d_track_width;
+  /// Segment regions
+  vec_int d_segment_region;
+  /// Segment lengths
+  vec_dbl d_segment_length;
+  //@{
+  /// Flat arrays in use: the vectors above or a mapped track file
+  const size_t *d_flat_angle_offset;
+  const size_t *d_flat_track_offset;
+  const double *d_flat_track_width;
+  const int    *d_flat_segment_region;
+  const double *d_flat_segment_length;
+  size_t        d_flat_number_tracks;
+  size_t        d_flat_number_segments;
+  //@}
+  //@{
+  /// Exit sides and links of directed tracks, and those in use
+  vec_int    d_exit_side;
+  vec_int    d_link;
+  const int *d_flat_exit_side;
+  const int *d_flat_link;
+  //@}
+  /// Track file that owns the mapped arrays, if any
+  detran_utilities::SP<TrackFile> d_file;
 
 };
 
@@ -167,6 +297,12 @@ GEOMETRY_TEMPLATE_EXPORT(detran_utilities::SP<TrackDB>)
 
 } // end namespace detran_geometry
 
+//----------------------------------------------------------------------------//
+// INLINE FUNCTIONS
+//----------------------------------------------------------------------------//
+
+#include "TrackDB.i.hh"
+
 #endif // detran_geometry_TRACKDB_HH_
 
 //----------------------------------------------------------------------------//
@@ -0,0 +1,100 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  TrackDB.i.hh
+ *  @brief TrackDB inline member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_geometry_TRACKDB_I_HH_
+#define detran_geometry_TRACKDB_I_HH_
+
+namespace detran_geometry
+{
+
+//----------------------------------------------------------------------------//
+inline TrackDB::size_t TrackDB::first_track(c_size_t a, c_size_t p) const
+{
+  Require(is_flat());
+  Require(a < d_number_azimuths);
+  Require(p < d_number_polar);
+  return d_flat_angle_offset[a * d_number_polar + p];
+}
+
+//----------------------------------------------------------------------------//
+inline TrackDB::size_t TrackDB::total_number_tracks() const
+{
+  Require(is_flat());
+  return d_flat_number_tracks;
+}
+
+//----------------------------------------------------------------------------//
+inline TrackDB::size_t TrackDB::total_number_segments() const
+{
+  Require(is_flat());
+  return d_flat_number_segments;
+}
+
+//----------------------------------------------------------------------------//
+inline TrackDB::size_t TrackDB::segment_begin(c_size_t track) const
+{
+  Require(track < d_flat_number_tracks);
+  return d_flat_track_offset[track];
+}
+
+//----------------------------------------------------------------------------//
+inline TrackDB::size_t TrackDB::segment_end(c_size_t track) const
+{
+  Require(track < d_flat_number_tracks);
+  return d_flat_track_offset[track + 1];
+}
+
+//----------------------------------------------------------------------------//
+inline double TrackDB::track_width(c_size_t track) const
+{
+  Require(track < d_flat_number_tracks);
+  return d_flat_track_width[track];
+}
+
+//----------------------------------------------------------------------------//
+inline int TrackDB::segment_region(c_size_t segment) const
+{
+  Require(segment < d_flat_number_segments);
+  return d_flat_segment_region[segment];
+}
+
+//----------------------------------------------------------------------------//
+inline double TrackDB::segment_length(c_size_t segment) const
+{
+  Require(segment < d_flat_number_segments);
+  return d_flat_segment_length[segment];
+}
+
+//----------------------------------------------------------------------------//
+inline int TrackDB::exit_side(c_size_t track, c_size_t direction) const
+{
+  Require(is_linked());
+  Require(track < d_flat_number_tracks);
+  Require(direction < END_DIRECTIONS);
+  return d_flat_exit_side[2 * track + direction];
+}
+
+//----------------------------------------------------------------------------//
+inline int TrackDB::link(c_size_t track,
+                         c_size_t direction,
+                         c_size_t kind) const
+{
+  Require(is_linked());
+  Require(track < d_flat_number_tracks);
+  Require(direction < END_DIRECTIONS);
+  Require(kind < END_LINKS);
+  return d_flat_link[(2 * track + direction) * END_LINKS + kind];
+}
+
+} // end namespace detran_geometry
+
+#endif /* detran_geometry_TRACKDB_I_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of file TrackDB.i.hh
+//----------------------------------------------------------------------------//
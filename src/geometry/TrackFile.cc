@@ -0,0 +1,364 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  TrackFile.cc
+ *  @brief TrackFile member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "TrackFile.hh"
+#include "utilities/DBC.hh"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#ifndef _WIN32
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+namespace detran_geometry
+{
+
+//----------------------------------------------------------------------------//
+// fixed header at the start of a track file
+struct TrackFileHeader
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t key;
+  uint32_t dimension;
+  uint32_t number_azimuths;
+  uint32_t number_polar;
+  uint32_t offset_bytes;
+  uint64_t number_tracks;
+  uint64_t number_segments;
+  uint64_t linked;
+  uint64_t offset[7];
+  uint64_t file_bytes;
+};
+
+static const char     track_file_magic[8] = "DTRNTRK";
+static const uint32_t track_file_byte_order = 0x01020304;
+
+//----------------------------------------------------------------------------//
+// round a byte count up to the next 8-byte boundary
+inline uint64_t track_file_align(const uint64_t bytes)
+{
+  return (bytes + 7) & ~uint64_t(7);
+}
+
+//----------------------------------------------------------------------------//
+// remove a temporary file on scope exit unless it was kept, so a failed
+// write leaves nothing behind
+struct TrackFileTemporary
+{
+  TrackFileTemporary(const std::string &name) : name(name), keep(false) {}
+  ~TrackFileTemporary() { if (!keep) std::remove(name.c_str()); }
+  std::string name;
+  bool keep;
+};
+
+//----------------------------------------------------------------------------//
+// HASH
+//----------------------------------------------------------------------------//
+
+//----------------------------------------------------------------------------//
+TrackFile::Hash::Hash()
+  : d_value(14695981039346656037ULL)
+{
+  /* ... */
+}
+
+//----------------------------------------------------------------------------//
+void TrackFile::Hash::add(const void *data, const size_t bytes)
+{
+  const unsigned char *b = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < bytes; ++i)
+  {
+    d_value ^= b[i];
+    d_value *= 1099511628211ULL;
+  }
+}
+
+//----------------------------------------------------------------------------//
+void TrackFile::Hash::add(const int value)
+{
+  add(&value, sizeof(value));
+}
+
+//----------------------------------------------------------------------------//
+void TrackFile::Hash::add(const double value)
+{
+  add(&value, sizeof(value));
+}
+
+//----------------------------------------------------------------------------//
+void TrackFile::Hash::add(const std::string &value)
+{
+  add(int(value.size()));
+  add(value.data(), value.size());
+}
+
+//----------------------------------------------------------------------------//
+void TrackFile::Hash::add(SP_quadrature q)
+{
+  Require(q);
+  add(int(q->dimension()));
+  add(int(q->number_azimuths_octant()));
+  add(int(q->number_polar_octant()));
+  for (size_t a = 0; a < q->number_azimuths_octant(); ++a)
+  {
+    add(q->cos_phi(a));
+    add(q->sin_phi(a));
+  }
+  for (size_t p = 0; p < q->number_polar_octant(); ++p)
+    add(q->cos_theta(p));
+}
+
+//----------------------------------------------------------------------------//
+void TrackFile::Hash::add(SP_geometry geo)
+{
+  Require(geo);
+  add(geo->width_x());
+  add(geo->width_y());
+  add(geo->width_z());
+  add(int(geo->number_regions()));
+
+  // Each region is identified exactly by its CSG tree: the node types,
+  // the senses, and the surface coefficients.  Its bounding box is kept
+  // as well, since the tracker uses it to skip regions.
+  Region::vec_dbl signature;
+  for (size_t r = 0; r < geo->number_regions(); ++r)
+  {
+    Region::SP_region region = geo->region(r);
+    add(int(region->has_bounding_box()));
+    if (region->has_bounding_box())
+    {
+      for (int d = 0; d < 3; ++d)
+      {
+        add(region->bound_min()[d]);
+        add(region->bound_max()[d]);
+      }
+    }
+    signature.clear();
+    if (region->top_node()) region->top_node()->signature(signature);
+    add(int(signature.size()));
+    if (signature.size())
+      add(&signature[0], signature.size() * sizeof(double));
+  }
+}
+
+//----------------------------------------------------------------------------//
+// TRACK FILE
+//----------------------------------------------------------------------------//
+
+//----------------------------------------------------------------------------//
+TrackFile::TrackFile(const std::string &filename)
+  : d_data(0)
+  , d_bytes(0)
+{
+#ifndef _WIN32
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return;
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0)
+  {
+    void *data = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED)
+    {
+      d_data  = static_cast<const char*>(data);
+      d_bytes = info.st_size;
+    }
+  }
+  close(fd);
+#else
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  if (!in) return;
+  in.seekg(0, std::ios::end);
+  d_buffer.resize(in.tellg());
+  in.seekg(0, std::ios::beg);
+  if (d_buffer.empty() || !in.read(&d_buffer[0], d_buffer.size())) return;
+  d_data  = &d_buffer[0];
+  d_bytes = d_buffer.size();
+#endif
+}
+
+//----------------------------------------------------------------------------//
+TrackFile::~TrackFile()
+{
+#ifndef _WIN32
+  if (d_data) munmap(const_cast<char*>(d_data), d_bytes);
+#endif
+}
+
+//----------------------------------------------------------------------------//
+void TrackFile::write(const std::string &filename,
+                      const TrackDB     &tracks,
+                      const key_t        key)
+{
+  Require(tracks.is_flat());
+
+  TrackFileHeader h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, track_file_magic, sizeof(h.magic));
+  h.version         = VERSION;
+  h.byte_order      = track_file_byte_order;
+  h.key             = key;
+  h.dimension       = tracks.dimension();
+  h.number_azimuths = tracks.number_azimuths();
+  h.number_polar    = tracks.number_polar();
+  h.offset_bytes    = sizeof(size_t);
+  h.number_tracks   = tracks.total_number_tracks();
+  h.number_segments = tracks.total_number_segments();
+  h.linked          = tracks.is_linked();
+
+  const void *array[7] =
+    {tracks.d_flat_angle_offset,  tracks.d_flat_track_offset,
+     tracks.d_flat_track_width,   tracks.d_flat_segment_region,
+     tracks.d_flat_segment_length,
+     tracks.d_flat_exit_side,     tracks.d_flat_link};
+  uint64_t bytes[7] =
+    {(h.number_azimuths * h.number_polar + 1) * sizeof(size_t),
+     (h.number_tracks + 1) * sizeof(size_t),
+     h.number_tracks   * sizeof(double),
+     h.number_segments * sizeof(int),
+     h.number_segments * sizeof(double),
+     h.linked * h.number_tracks * TrackDB::END_DIRECTIONS * sizeof(int),
+     h.linked * h.number_tracks * TrackDB::END_DIRECTIONS *
+       TrackDB::END_LINKS * sizeof(int)};
+  uint64_t offset = track_file_align(sizeof(h));
+  for (int i = 0; i < 7; ++i)
+  {
+    h.offset[i] = offset;
+    offset = track_file_align(offset + bytes[i]);
+  }
+  h.file_bytes = offset;
+
+  // Write to a temporary unique to this process and call, then rename.
+  std::ostringstream name;
+#ifndef _WIN32
+  name << filename << "." << getpid() << ".XXXXXX";
+  std::string pattern = name.str();
+  std::vector<char> buffer(pattern.begin(), pattern.end());
+  buffer.push_back('\0');
+  int fd = mkstemp(&buffer[0]);
+  Insist(fd >= 0, "Cannot create a temporary for track file " + filename);
+  fchmod(fd, 0644);
+  close(fd);
+  std::string temporary(&buffer[0]);
+#else
+  name << filename << "." << _getpid() << ".tmp";
+  std::string temporary = name.str();
+#endif
+  TrackFileTemporary guard(temporary);
+  {
+    std::ofstream out(temporary.c_str(), std::ios::binary);
+    Insist(out, "Cannot open track file " + temporary);
+    const char zero[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    uint64_t position = sizeof(h);
+    for (int i = 0; i < 7; ++i)
+    {
+      out.write(zero, h.offset[i] - position);
+      if (bytes[i]) out.write(static_cast<const char*>(array[i]), bytes[i]);
+      position = h.offset[i] + bytes[i];
+    }
+    out.write(zero, h.file_bytes - position);
+    Insist(out, "Failed writing track file " + temporary);
+  }
+  Insist(std::rename(temporary.c_str(), filename.c_str()) == 0,
+         "Cannot rename track file " + temporary + " to " + filename);
+  guard.keep = true;
+}
+
+//----------------------------------------------------------------------------//
+TrackFile::SP_trackdb TrackFile::read(const std::string &filename,
+                                      SP_quadrature      quadrature,
+                                      const key_t        key,
+                                      const size_t       dimension)
+{
+  Require(quadrature);
+
+  SP_trackfile file(new TrackFile(filename));
+  if (!file->d_data || file->d_bytes < sizeof(TrackFileHeader))
+    return SP_trackdb(0);
+
+  // A stale or foreign file is not an error; the caller just retracks.
+  TrackFileHeader h;
+  std::memcpy(&h, file->d_data, sizeof(h));
+  SP_trackdb tracks(new TrackDB(quadrature, dimension));
+  size_t number_angles = tracks->number_azimuths() * tracks->number_polar();
+  if (std::memcmp(h.magic, track_file_magic, sizeof(h.magic)) != 0 ||
+      h.version         != VERSION ||
+      h.byte_order      != track_file_byte_order ||
+      h.key             != key ||
+      h.dimension       != tracks->dimension() ||
+      h.number_azimuths != tracks->number_azimuths() ||
+      h.number_polar    != tracks->number_polar() ||
+      h.offset_bytes    != sizeof(size_t) ||
+      h.linked          >  1 ||
+      h.file_bytes      != file->d_bytes)
+  {
+    return SP_trackdb(0);
+  }
+  uint64_t bytes[7] =
+    {(number_angles + 1)   * sizeof(size_t),
+     (h.number_tracks + 1) * sizeof(size_t),
+     h.number_tracks       * sizeof(double),
+     h.number_segments     * sizeof(int),
+     h.number_segments     * sizeof(double),
+     h.linked * h.number_tracks * TrackDB::END_DIRECTIONS * sizeof(int),
+     h.linked * h.number_tracks * TrackDB::END_DIRECTIONS *
+       TrackDB::END_LINKS * sizeof(int)};
+  for (int i = 0; i < 7; ++i)
+  {
+    if (h.offset[i] % 8 || h.offset[i] + bytes[i] > h.file_bytes)
+      return SP_trackdb(0);
+  }
+
+  const char *data = file->d_data;
+  const size_t *angle_offset =
+    reinterpret_cast<const size_t*>(data + h.offset[0]);
+  const size_t *track_offset =
+    reinterpret_cast<const size_t*>(data + h.offset[1]);
+  if (angle_offset[number_angles] != h.number_tracks ||
+      track_offset[h.number_tracks] != h.number_segments)
+  {
+    return SP_trackdb(0);
+  }
+
+  tracks->d_flat_angle_offset    = angle_offset;
+  tracks->d_flat_track_offset    = track_offset;
+  tracks->d_flat_track_width     =
+    reinterpret_cast<const double*>(data + h.offset[2]);
+  tracks->d_flat_segment_region  =
+    reinterpret_cast<const int*>(data + h.offset[3]);
+  tracks->d_flat_segment_length  =
+    reinterpret_cast<const double*>(data + h.offset[4]);
+  tracks->d_flat_number_tracks   = h.number_tracks;
+  tracks->d_flat_number_segments = h.number_segments;
+  if (h.linked && h.number_tracks)
+  {
+    tracks->d_flat_exit_side =
+      reinterpret_cast<const int*>(data + h.offset[5]);
+    tracks->d_flat_link      =
+      reinterpret_cast<const int*>(data + h.offset[6]);
+  }
+  tracks->d_released             = true;
+  tracks->d_file                 = file;
+  return tracks;
+}
+
+} // end namespace detran_geometry
+
+//----------------------------------------------------------------------------//
+//              end of file TrackFile.cc
+//----------------------------------------------------------------------------//
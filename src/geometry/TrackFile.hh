@@ -0,0 +1,175 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  TrackFile.hh
+ *  @brief TrackFile class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_geometry_TRACKFILE_HH_
+#define detran_geometry_TRACKFILE_HH_
+
+#include "geometry/geometry_export.hh"
+#include "geometry/Geometry.hh"
+#include "geometry/TrackDB.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/SP.hh"
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace detran_geometry
+{
+
+/**
+ *  @class TrackFile
+ *  @brief Binary file of the flat track arrays for reuse across runs
+ *
+ *  Tracking a geometry can cost more than the transport solve it feeds,
+ *  and depletion or branch calculations track the same geometry many
+ *  times.  The flat arrays of a TrackDB are therefore written once and
+ *  later mapped into memory, where the sweepers read them in place with
+ *  no Track objects ever built.
+ *
+ *  The file is a fixed header followed by the flat arrays, each starting
+ *  on an 8-byte boundary, in the byte order and type sizes of the writer:
+ *  @verbatim
+      char[8]   magic "DTRNTRK"
+      uint32    version
+      uint32    byte order mark 0x01020304
+      uint64    key
+      uint32    dimension, number of azimuths, number of polar angles
+      uint32    bytes per offset (sizeof(detran_utilities::size_t))
+      uint64    number of tracks, number of segments
+      uint64    1 if the tracks are linked, otherwise 0
+      uint64[7] byte offsets of the arrays below
+      uint64    file size in bytes
+      offset    angle offsets    [number_azimuths * number_polar + 1]
+      offset    track offsets    [number_tracks + 1]
+      double    track widths     [number_tracks]
+      int32     segment regions  [number_segments]
+      double    segment lengths  [number_segments]
+      int32     exit sides       [2 * number_tracks, or 0 if not linked]
+      int32     links            [4 * number_tracks, or 0 if not linked]
+    @endverbatim
+ *  The arrays are exactly those described in TrackDB.  A file is used
+ *  only if its key matches the one computed for the problem at hand;
+ *  otherwise (or if the file is missing, truncated, or from a machine
+ *  with a different layout) read returns null and the caller retracks.
+ *  The python module pydetranutils.track_file reads the same format.
+ *
+ *  The key hashes the tracking parameters, the quadrature angles, and
+ *  the geometry.  A geometry contributes its extent and, for each
+ *  region, its bounding box and the signature of its CSG tree (see
+ *  CSG_Node::signature), which holds every surface coefficient, sense,
+ *  and operator exactly.
+ *
+ *  A file is written to a uniquely named temporary in the same directory
+ *  and then renamed, so concurrent writers never see a partial file.
+ */
+class GEOMETRY_EXPORT TrackFile
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<TrackFile>             SP_trackfile;
+  typedef TrackDB::SP_trackdb                         SP_trackdb;
+  typedef TrackDB::SP_quadrature                      SP_quadrature;
+  typedef Geometry::SP_geometry                       SP_geometry;
+  typedef detran_utilities::size_t                    size_t;
+  typedef uint64_t                                    key_t;
+
+  /// Current format version
+  enum { VERSION = 2 };
+
+  /**
+   *  @class Hash
+   *  @brief 64-bit FNV-1a hash used to build file keys
+   */
+  class GEOMETRY_EXPORT Hash
+  {
+  public:
+    Hash();
+    void add(const void *data, const size_t bytes);
+    void add(const int value);
+    void add(const double value);
+    void add(const std::string &value);
+    void add(SP_quadrature quadrature);
+    void add(SP_geometry geometry);
+    key_t value() const { return d_value; }
+  private:
+    key_t d_value;
+  };
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /// Destructor releases the mapping
+  ~TrackFile();
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Write the flat arrays of a track database
+   *  @param filename   Name of the file
+   *  @param tracks     Flattened track database
+   *  @param key        Key of the problem tracked
+   *
+   *  The file is written under a temporary name and then renamed, so
+   *  runs sharing a file never see a partial one.
+   */
+  static void write(const std::string &filename,
+                    const TrackDB     &tracks,
+                    const key_t        key);
+
+  /**
+   *  @brief Map a track file into a new track database
+   *  @param filename   Name of the file
+   *  @param quadrature Quadrature of the problem
+   *  @param key        Key of the problem
+   *  @param dimension  Dimension of the tracks (see TrackDB)
+   *  @return           Database using the mapped arrays, or null if the
+   *                    file cannot be used
+   */
+  static SP_trackdb read(const std::string &filename,
+                         SP_quadrature      quadrature,
+                         const key_t        key,
+                         const size_t       dimension = 0);
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Mapped file contents
+  const char *d_data;
+  /// Size of the mapping in bytes
+  std::size_t d_bytes;
+  /// Contents read into memory where mapping is unavailable
+  std::vector<char> d_buffer;
+
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  /// Open and map a file; the data is null if it cannot be opened
+  explicit TrackFile(const std::string &filename);
+
+};
+
+} // end namespace detran_geometry
+
+#endif /* detran_geometry_TRACKFILE_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of file TrackFile.hh
+//----------------------------------------------------------------------------//
@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------//
 
 #include "Tracker.hh"
+#include "TrackFile.hh"
 #include "QuadraticSurfaceFactory.hh"
 #include "angle/QuadratureFactory.hh"
 #include "utilities/SoftEquivalence.hh"
@@ -14,12 +15,58 @@
 #include <iostream>
 #include <cmath>
 #include <cfloat>
+#include <algorithm>
+#ifdef DETRAN_ENABLE_OPENMP
+#include <omp.h>
+#endif
 
-#define COUT(c) std::cout << c << std::endl;
 
 namespace detran_geometry
 {
 
+//----------------------------------------------------------------------------//
+// contain a segment with its midpoint along the track
+struct MidpointSegment
+{
+  MidpointSegment(const Point &p, const size_t reg, const double length)
+    : midpoint(p), segment(reg, length) {/* ... */}
+  Point   midpoint;
+  Segment segment;
+};
+
+//----------------------------------------------------------------------------//
+// compares two segments based on their midpoints w/r to the track origin
+struct MidpointSegmentCompare
+{
+  MidpointSegmentCompare(const Point &o) : d_origin(o) {/* ... */}
+  bool operator() (const MidpointSegment &r0, const MidpointSegment &r1)
+  {
+    return distance(r0.midpoint, d_origin) < distance(r1.midpoint, d_origin);
+  }
+  const Point &d_origin;
+};
+
+//----------------------------------------------------------------------------//
+// a directed track entering through a side, ordered along the side
+struct TrackEntry
+{
+  TrackEntry(const double c, const int t) : coordinate(c), track(t) {/* ... */}
+  bool operator<(const TrackEntry &other) const
+  {
+    return coordinate < other.coordinate;
+  }
+  double coordinate;
+  int    track;
+};
+
+//----------------------------------------------------------------------------//
+// buffers reused by one thread over all the tracks it segmentizes
+struct Tracker::Workspace
+{
+  vec_size_t                   candidates;
+  std::vector<MidpointSegment> segments;
+};
+
 //----------------------------------------------------------------------------//
 Tracker::Tracker(SP_db db, SP_quadrature q)
   : d_db(db)
@@ -29,6 +76,12 @@ Tracker::Tracker(SP_db db, SP_quadrature q)
   , d_Z(0)
   , d_maximum_spacing(0.1)
   , d_spatial_quad_type("uniform")
+  , d_symmetric_tracks(false)
+  , d_release_tracks(false)
+  , d_use_bvh(true)
+  , d_number_threads(1)
+  , d_cyclic(false)
+  , d_extruded(false)
 {
   Require(d_db);
   Require(d_quadrature);
@@ -46,6 +99,45 @@ Tracker::Tracker(SP_db db, SP_quadrature q)
   {
     d_symmetric_tracks = 0 != d_db->get<int>("tracker_symmetric_tracks");
   }
+  if (d_db->check("tracker_release_tracks"))
+  {
+    d_release_tracks = 0 != d_db->get<int>("tracker_release_tracks");
+  }
+  if (d_db->check("tracker_use_bvh"))
+  {
+    d_use_bvh = 0 != d_db->get<int>("tracker_use_bvh");
+  }
+#ifdef DETRAN_ENABLE_OPENMP
+  d_number_threads = omp_get_max_threads();
+#endif
+  if (d_db->check("tracker_number_threads"))
+  {
+    d_number_threads = d_db->get<int>("tracker_number_threads");
+    Insist(d_number_threads > 0, "The tracker needs at least one thread.");
+  }
+  if (d_db->check("tracker_track_file"))
+  {
+    d_track_file = d_db->get<std::string>("tracker_track_file");
+  }
+  if (d_db->check("tracker_cyclic"))
+  {
+    d_cyclic = 0 != d_db->get<int>("tracker_cyclic");
+    Insist(!d_cyclic || d_quadrature->dimension() == 2,
+           "Cyclic tracking is for 2-D only.");
+  }
+  if (d_db->check("tracker_extruded"))
+  {
+    d_extruded = 0 != d_db->get<int>("tracker_extruded");
+    Insist(!d_extruded || d_quadrature->dimension() == 3,
+           "Extruded tracking needs a 3-D quadrature.");
+  }
+  // Keep the given azimuths, since the corrected ones depend on the
+  // geometry tracked.
+  if (d_cyclic)
+  {
+    for (size_t a = 0; a < d_quadrature->number_azimuths_octant(); ++a)
+      d_phi.push_back(d_quadrature->phi(a));
+  }
 }
 
 //----------------------------------------------------------------------------//
@@ -61,6 +153,16 @@ void Tracker::normalize()
   vec_dbl volume(d_mesh->number_cells(), 0.0);
   for (size_t i = 0; i < volume.size(); i++)
     volume[i] = d_mesh->volume(i);
+  // Extruded tracks cross the bottom layer, so use its cell areas.
+  if (d_extruded)
+  {
+    size_t nx = d_mesh->number_cells_x();
+    size_t ny = d_mesh->number_cells_y();
+    volume.resize(nx * ny);
+    for (size_t j = 0; j < ny; ++j)
+      for (size_t i = 0; i < nx; ++i)
+        volume[i + j * nx] = d_mesh->width(0, i) * d_mesh->width(1, j);
+  }
   // Normalize track lengths by volume.
   d_tracks->normalize(volume);
 }
@@ -86,11 +188,6 @@ Tracker::size_t Tracker::number_points(const double  phi,
   double tmp = std::min(d_maximum_spacing, trig_phi * L);
 
 
-  COUT("phi " << phi)
-  COUT("L " << L)
-  COUT("flat " << flag)
-  COUT("trig_phi " << trig_phi)
-  COUT("max_d " << tmp)
 
   if (d_spatial_quad_type == "gl")
   {
@@ -115,12 +212,35 @@ void Tracker::trackit(SP_geometry geo)
   d_X = d_geometry->width_x();
   d_Y = d_geometry->width_y();
   d_Z = d_geometry->width_z();
+  if (d_cyclic) correct_azimuths();
+
+  // Reuse the tracks of an earlier run of the same problem if possible
+  TrackFile::key_t key = 0;
+  if (!d_track_file.empty())
+  {
+    TrackFile::Hash hash;
+    hash.add(d_quadrature);
+    hash.add(d_maximum_spacing);
+    hash.add(d_spatial_quad_type);
+    hash.add(int(d_cyclic));
+    hash.add(int(d_extruded));
+    hash.add(d_geometry);
+    key = hash.value();
+    d_tracks = TrackFile::read(d_track_file, d_quadrature, key,
+                               d_extruded ? 2 : 0);
+    if (d_tracks) return;
+  }
+
+  // Index the regions so each track visits only those it crosses
+  d_bvh = d_use_bvh ? RegionBVH::Create(d_geometry) : RegionBVH::SP_bvh(0);
 
   // Create database
-  d_tracks = new TrackDB(d_quadrature);
+  d_tracks = new TrackDB(d_quadrature, d_extruded ? 2 : 0);
 
 
-  if (d_quadrature->dimension() == 2)
+  // Gather the tracks so they can be segmentized in parallel
+  std::vector<SP_track> tracks;
+  if (d_tracks->dimension() == 2)
   {
     // Generate all track entrances and exits
     generate_points_2D_cartesian();
@@ -128,10 +248,9 @@ void Tracker::trackit(SP_geometry geo)
     // Sort the points.
     d_tracks->sort();
 
-    // Segmentize all the tracks
     for (size_t a = 0; a < 2 * d_quadrature->number_azimuths_octant(); ++a)
       for (size_t t = 0; t < d_tracks->number_tracks(a); ++t)
-        segmentize(d_tracks->track(a, 0, t));
+        tracks.push_back(d_tracks->track(a, 0, t));
   }
   else
   {
@@ -141,12 +260,33 @@ void Tracker::trackit(SP_geometry geo)
     // Sort the points.
     d_tracks->sort();
 
-    // Segmentize all the tracks
     for (size_t a = 0; a < 4 * d_quadrature->number_azimuths_octant(); ++a)
       for (size_t p = 0; p < d_quadrature->number_polar_octant(); ++p)
-        for (size_t t = 0; t < d_tracks->number_tracks(a); ++t)
-          segmentize(d_tracks->track(a, 0, t));
+        for (size_t t = 0; t < d_tracks->number_tracks(a, p); ++t)
+          tracks.push_back(d_tracks->track(a, p, t));
+  }
+
+  // Segmentize all the tracks.  Each track's segments depend only on
+  // the track, so the result does not depend on the number of threads.
+  int number_tracks = tracks.size();
+  #pragma omp parallel num_threads(d_number_threads)
+  {
+    Workspace workspace;
+    #pragma omp for schedule(dynamic, 16)
+    for (int t = 0; t < number_tracks; ++t)
+      segmentize(tracks[t], workspace);
   }
+
+  // Link the tracks while the Track objects are still around.
+  vec_int exit_side, link;
+  if (d_cyclic) link_tracks(exit_side, link);
+
+  // Build the contiguous track layout used for sweeping.
+  d_tracks->flatten(d_release_tracks);
+  if (d_cyclic) d_tracks->set_links(exit_side, link);
+
+  if (!d_track_file.empty())
+    TrackFile::write(d_track_file, *d_tracks, key);
 }
 
 //----------------------------------------------------------------------------//
@@ -187,8 +327,10 @@ Tracker::SP_geometry Tracker::mesh_to_geometry(SP_mesh mesh)
     }
   }
 
+  // Extruded tracking needs only the bottom layer.
+  size_t nz = d_extruded ? 1 : d_mesh->number_cells_z();
   const vec_int &mat_map = d_mesh->mesh_map("MATERIAL");
-  for (size_t k = 0; k < d_mesh->number_cells_z(); ++k)
+  for (size_t k = 0; k < nz; ++k)
   {
     for (size_t j = 0; j < d_mesh->number_cells_y(); ++j)
     {
@@ -203,8 +345,11 @@ Tracker::SP_geometry Tracker::mesh_to_geometry(SP_mesh mesh)
         r->append(surfaces[0][i+1], false);
         r->append(surfaces[1][j  ], true);
         r->append(surfaces[1][j+1], false);
-        if (d_mesh->dimension() == 3) r->append(surfaces[2][k  ], true);
-        if (d_mesh->dimension() == 3) r->append(surfaces[2][k+1], false);
+        if (d_mesh->dimension() == 3 && !d_extruded)
+        {
+          r->append(surfaces[2][k  ], true);
+          r->append(surfaces[2][k+1], false);
+        }
         geo->add_region(r);
       }
     }
@@ -214,6 +359,28 @@ Tracker::SP_geometry Tracker::mesh_to_geometry(SP_mesh mesh)
 }
 
 
+//----------------------------------------------------------------------------//
+void Tracker::correct_azimuths()
+{
+  // Tracks a distance d apart cross the bottom every d / sin(phi) and the
+  // left side every d / cos(phi).  Rounding the number of crossings up
+  // keeps the spacing about the maximum, and the angle whose crossings
+  // evenly divide both sides is the one used.
+  size_t na = d_quadrature->number_azimuths_octant();
+  d_number_x.resize(na);
+  d_number_y.resize(na);
+  vec_dbl phi(na, 0.0);
+  for (size_t a = 0; a < na; ++a)
+  {
+    d_number_x[a] = 1 +
+      (int)std::floor(d_X * std::sin(d_phi[a]) / d_maximum_spacing);
+    d_number_y[a] = 1 +
+      (int)std::floor(d_Y * std::cos(d_phi[a]) / d_maximum_spacing);
+    phi[a] = std::atan((d_Y * d_number_x[a]) / (d_X * d_number_y[a]));
+  }
+  d_quadrature->set_azimuths(phi);
+}
+
 //----------------------------------------------------------------------------//
 void Tracker::generate_points_2D_cartesian()
 {
@@ -235,6 +402,30 @@ void Tracker::generate_points_2D_cartesian()
     double tan_phi = sin_phi / cos_phi;
     double cot_phi = cos_phi / sin_phi;
 
+    if (d_cyclic)
+    {
+      // Tracks start at the middle of nx cells along the bottom and ny
+      // along the left side, and the corrected angle makes each end at
+      // the middle of a cell on the top or right side.
+      int nx = d_number_x[a], ny = d_number_y[a];
+      double dx = d_X / nx, dy = d_Y / ny, wt = dx * sin_phi;
+      for (int j = 0; j < ny; ++j)
+      {
+        Point P0(0.0, (j + 0.5) * dy);
+        Point P1 = ny - j <= nx ? Point((ny - j - 0.5) * dx, d_Y)
+                                : Point(d_X, (j + nx + 0.5) * dy);
+        d_tracks->add_track(a, 0, SP_track(new Track(P0, P1, wt)));
+      }
+      for (int i = 0; i < nx; ++i)
+      {
+        Point P0((i + 0.5) * dx, 0.0);
+        Point P1 = nx - i <= ny ? Point(d_X, (nx - i - 0.5) * dy)
+                                : Point((i + ny + 0.5) * dx, d_Y);
+        d_tracks->add_track(a, 0, SP_track(new Track(P0, P1, wt)));
+      }
+      continue;
+    }
+
     size_t dim[] = { 0, 1 };        // the "full" dimension
     double width[] = { d_X, d_Y };  // bounding box
 
@@ -347,6 +538,90 @@ void Tracker::generate_points_2D_cartesian()
 
 }
 
+//----------------------------------------------------------------------------//
+void Tracker::link_tracks(vec_int &exit_side, vec_int &link)
+{
+  size_t na = d_quadrature->number_azimuths_octant();
+  double tol = 1.0e-9 * (d_X + d_Y);
+
+  // First flat track of each azimuth, as numbered by TrackDB::flatten
+  vec_int first(2 * na + 1, 0);
+  for (size_t a = 0; a < 2 * na; ++a)
+    first[a + 1] = first[a] + d_tracks->number_tracks(a);
+  exit_side.assign(TrackDB::END_DIRECTIONS * first[2 * na], -1);
+  link.assign(TrackDB::END_LINKS * exit_side.size(), -1);
+
+  // Octants reached by reflection from a vertical or horizontal side
+  const int reflect[2][4] = {{1, 0, 3, 2}, {3, 2, 1, 0}};
+  const int opposite[4] = {Mesh::EAST, Mesh::WEST, Mesh::NORTH, Mesh::SOUTH};
+
+  // A track only links to tracks of its own or the mirrored azimuth.
+  for (size_t a = 0; a < na; ++a)
+  {
+    // Entries of the directed tracks by side and octant, and their exits
+    std::vector<TrackEntry> entries[4][4];
+    std::vector<TrackEntry> exits;
+    vec_int exit_octant;
+    for (size_t az = a; az < 2 * na; az += na)
+    {
+      for (size_t t = 0; t < d_tracks->number_tracks(az); ++t)
+      {
+        SP_track track = d_tracks->track(az, 0, t);
+        for (int d = 0; d < TrackDB::END_DIRECTIONS; ++d)
+        {
+          Point P0 = track->enter(), P1 = track->exit();
+          if (d == TrackDB::BACKWARD) std::swap(P0, P1);
+          int o = (P1.x() > P0.x()) ? (P1.y() > P0.y() ? 0 : 3)
+                                    : (P1.y() > P0.y() ? 1 : 2);
+          int side[2];
+          double coordinate[2];
+          const Point *P[2] = {&P0, &P1};
+          for (int e = 0; e < 2; ++e)
+          {
+            const Point &p = *P[e];
+            if (std::abs(p.x()) < tol)
+              side[e] = Mesh::WEST;
+            else if (std::abs(p.x() - d_X) < tol)
+              side[e] = Mesh::EAST;
+            else if (std::abs(p.y()) < tol)
+              side[e] = Mesh::SOUTH;
+            else
+              side[e] = Mesh::NORTH;
+            coordinate[e] = side[e] < Mesh::SOUTH ? p.y() : p.x();
+          }
+          int directed = TrackDB::END_DIRECTIONS * (first[az] + t) + d;
+          entries[side[0]][o].push_back(TrackEntry(coordinate[0], directed));
+          exits.push_back(TrackEntry(coordinate[1], directed));
+          exit_octant.push_back(o);
+          exit_side[directed] = side[1];
+        }
+      }
+    }
+    for (int s = 0; s < 4; ++s)
+      for (int o = 0; o < 4; ++o)
+        std::sort(entries[s][o].begin(), entries[s][o].end());
+
+    // Each exit is the entry of one track of the reflected octant on the
+    // same side and of one track of the same octant on the opposite side.
+    for (size_t i = 0; i < exits.size(); ++i)
+    {
+      int directed = exits[i].track;
+      int s = exit_side[directed], o = exit_octant[i];
+      const std::vector<TrackEntry> *e[TrackDB::END_LINKS] =
+        {&entries[s][reflect[s / 2][o]], &entries[opposite[s]][o]};
+      for (int k = 0; k < TrackDB::END_LINKS; ++k)
+      {
+        double c = exits[i].coordinate;
+        std::vector<TrackEntry>::const_iterator it =
+          std::lower_bound(e[k]->begin(), e[k]->end(), TrackEntry(c - tol, -1));
+        Insist(it != e[k]->end() && it->coordinate < c + tol,
+               "Cyclic tracks failed to link.");
+        link[TrackDB::END_LINKS * directed + k] = it->track;
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------//
 /**
  *   For 3-D, we use ray tracing on the bounding box.  For each incident
@@ -377,10 +652,8 @@ void Tracker::generate_points_3D_cartesian()
   // loop over all first octant angles
   for (size_t a = 0; a < d_quadrature->number_azimuths_octant(); ++a)
   {
-    COUT("a = " << a)
     for (size_t p = 0; p < d_quadrature->number_polar_octant(); ++p)
     {
-      COUT("p = " << p)
 
       // generate points along x, y, and z (assuming even spacing for defining
       // the number of points to use; for g-l, use larger spacing)
@@ -471,29 +744,7 @@ void Tracker::generate_points_3D_cartesian()
 //----------------------------------------------------------------------------//
 
 //----------------------------------------------------------------------------//
-// contain a segment with its midpoint along the track
-struct MidpointSegment
-{
-  MidpointSegment(const Point &p, const size_t reg, const double length)
-    : midpoint(p), segment(reg, length) {/* ... */}
-  Point   midpoint;
-  Segment segment;
-};
-
-//----------------------------------------------------------------------------//
-// compares two segments based on their midpoints w/r to the track origin
-struct MidpointSegmentCompare
-{
-  MidpointSegmentCompare(const Point &o) : d_origin(o) {/* ... */}
-  bool operator() (const MidpointSegment &r0, const MidpointSegment &r1)
-  {
-    return distance(r0.midpoint, d_origin) < distance(r1.midpoint, d_origin);
-  }
-  const Point &d_origin;
-};
-
-//----------------------------------------------------------------------------//
-void Tracker::segmentize(SP_track track)
+void Tracker::segmentize(SP_track track, Workspace &workspace)
 {
   using detran_utilities::soft_equiv;
   typedef CSG_Node::vec_point vec_point;
@@ -501,7 +752,6 @@ void Tracker::segmentize(SP_track track)
   // starting point, end point, track length, and direction
   Point P0 = track->enter();
   Point P1 = track->exit();
-  COUT("enter=" << P0 << " exit=" << P1)
   double L = distance(P0, P1);
   Point  D = (P1 - P0) * (1.0 / L);
 
@@ -513,27 +763,36 @@ void Tracker::segmentize(SP_track track)
   double ray_length = L + 2.0*eps;
 
   // vector of segments with their midpoints
-  std::vector<MidpointSegment> segments;
+  std::vector<MidpointSegment> &segments = workspace.segments;
+  segments.clear();
 
-  // loop through all the regions
+  // regions whose bounding boxes the ray crosses
+  vec_size_t &candidates = workspace.candidates;
+  candidates.clear();
+  if (d_bvh)
+  {
+    d_bvh->intersect(ray, ray_length, candidates);
+  }
+  else
+  {
+    for (size_t r = 0; r < d_geometry->number_regions(); ++r)
+    {
+      Region::SP_region region = d_geometry->region(r);
+      if (!region->has_bounding_box() ||
+          region->intersects_bounding_box(ray, ray_length))
+      {
+        candidates.push_back(r);
+      }
+    }
+  }
+
+  // loop through the candidate regions
   bool found = false;
-  for (size_t r = 0; r < d_geometry->number_regions(); ++r)
+  for (size_t c = 0; c < candidates.size(); ++c)
   {
+    size_t r = candidates[c];
     Region::SP_region region = d_geometry->region(r);
 
-    if (!region->intersects_bounding_box(ray, ray_length))
-    {
-      COUT("I'm a fucking piece of shit.  Fuck this box:"
-            << region->bound_min() << region->bound_max())
-      continue;
-    }
-    COUT("In BBox so need points"
-          << " P0="   << P0
-          << " D=" << D
-          << " ray = " << ray.origin << " " << ray.direction
-          << " min=" << region->bound_min()
-          << " max=" << region->bound_max())
-    COUT(" ")
     // get all intersections with the node constituents
     vec_point points = region->top_node()->intersections(ray, ray_length);
 
@@ -542,7 +801,6 @@ void Tracker::segmentize(SP_track track)
     // loop through all points (skipping the pathological case of one point)
     for (size_t i = 0; i < points.size() - 1; ++i)
     {
-      COUT(points[i])
       if (soft_equiv(std::abs(distance(points[i], points[i+1])), 0.0)) continue;
 
       // make sure we have proper order
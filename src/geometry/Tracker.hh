@@ -13,6 +13,7 @@
 #include "TrackDB.hh"
 #include "Mesh.hh"
 #include "Geometry.hh"
+#include "RegionBVH.hh"
 #include "angle/ProductQuadrature.hh"
 #include "utilities/DBC.hh"
 #include "utilities/InputDB.hh"
@@ -31,7 +32,33 @@ namespace detran_geometry
  *    - tracker_spatial_quad_type [string]
  *    - tracker_normalize_lengths [int]
  *    - tracker_symmetric_tracks  [int]
+ *    - tracker_release_tracks    [int]  (keep only the flat track arrays)
+ *    - tracker_use_bvh           [int]  (find crossed regions with a
+ *                                        bounding volume hierarchy; default 1)
+ *    - tracker_number_threads    [int]  (threads used to segmentize;
+ *                                        default all available)
+ *    - tracker_track_file        [str]  (map the tracks from this file if
+ *                                        it matches the problem, or else
+ *                                        track and write it; see TrackFile)
+ *    - tracker_cyclic            [int]  (2-D cyclic tracking; default 0)
+ *    - tracker_extruded          [int]  (track only the x-y projection of
+ *                                        a 3-D mesh; default 0)
  *
+ *  With cyclic (or modular) tracking, each azimuth is corrected so that
+ *  a whole number nx of tracks cross the bottom and ny the left side,
+ *  all a common distance apart.  Every track then ends where another
+ *  begins, whether the side it leaves through reflects or is periodic,
+ *  and the database records these links (see TrackDB) so the sweeper
+ *  can follow whole chains of tracks.  The quadrature's azimuths (and
+ *  their weights) are replaced by the corrected ones, and the tracks
+ *  are always uniformly spaced.
+ *
+ *  With extruded tracking, a 3-D quadrature and a 3-D mesh are tracked
+ *  as though the mesh were its bottom layer of cells, giving 2-D tracks
+ *  whose segments index the cells of that layer.  Each 3-D track lies
+ *  over one of these, and its segments follow from those of the 2-D
+ *  track and the axial mesh (see Sweeper3DMOC), so they need never be
+ *  stored.
  */
 class GEOMETRY_EXPORT Tracker
 {
@@ -52,6 +79,7 @@ public:
   typedef detran_utilities::vec_dbl                       vec_dbl;
   typedef detran_utilities::vec2_dbl                      vec2_dbl;
   typedef detran_utilities::vec_int                       vec_int;
+  typedef detran_utilities::vec_size_t                    vec_size_t;
   typedef detran_utilities::size_t                        size_t;
   typedef Region::SP_region                               SP_region;
 
@@ -109,10 +137,31 @@ private:
   std::string d_spatial_quad_type;
   /// Flag to indicate symmetric tracking is to be done in 3-D
   bool d_symmetric_tracks;
+  /// Flag to drop the Track objects once the flat arrays are built
+  bool d_release_tracks;
+  /// Flag to find the regions crossed by a track with a BVH
+  bool d_use_bvh;
+  /// Number of threads used to segmentize
+  int d_number_threads;
+  /// Track file to reuse or write
+  std::string d_track_file;
+  /// Flag for cyclic tracking
+  bool d_cyclic;
+  /// Flag for extruded tracking
+  bool d_extruded;
+  /// Azimuths given before correction for cyclic tracking
+  vec_dbl d_phi;
+  //@{
+  /// Tracks per azimuth entering the bottom and left sides when cyclic
+  vec_int d_number_x;
+  vec_int d_number_y;
+  //@}
   /// Mesh to be tracked
   SP_mesh d_mesh;
   /// Geometry to be tracked
   SP_geometry d_geometry;
+  /// Hierarchy over the region bounding boxes
+  RegionBVH::SP_bvh d_bvh;
   //@{
   ///  Bounding box dimensions
   double d_X;
@@ -134,14 +183,23 @@ private:
                        const double L,
                        const size_t flag = 0);
 
+  /// correct the azimuths so tracks link across the sides
+  void correct_azimuths();
+
   /// generate track points for a 2D cartesian geometry
   void generate_points_2D_cartesian();
 
+  /// find the sides and links of the cyclic tracks, indexed as in TrackDB
+  void link_tracks(vec_int &exit_side, vec_int &link);
+
   /// generate track points for a 3D cartesian geometry
   void generate_points_3D_cartesian();
 
+  /// Per-thread buffers for segmentize
+  struct Workspace;
+
   /// cast a track across the domain and segmentize it
-  void segmentize(SP_track track);
+  void segmentize(SP_track track, Workspace &workspace);
 
 };
 
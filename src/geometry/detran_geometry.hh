@@ -19,6 +19,7 @@
 #include "Segment.hh"
 #include "Track.hh"
 #include "TrackDB.hh"
+#include "TrackFile.hh"
 #include "Tracker.hh"
 #include "Point.hh"
 
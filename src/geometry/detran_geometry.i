@@ -16,6 +16,7 @@
 #include "geometry/Mesh1D.hh" 
 #include "geometry/Mesh2D.hh" 
 #include "geometry/Mesh3D.hh"   
+#include "geometry/MeshPartitioner.hh"
 #include "geometry/PinCell.hh"
 #include "geometry/Segment.hh"
 #include "geometry/Track.hh"
@@ -58,6 +59,7 @@
 %include "Mesh1D.hh"
 %include "Mesh2D.hh"
 %include "Mesh3D.hh"
+%include "MeshPartitioner.hh"
 %include "PinCell.hh"
 %include "Assembly.hh"
 %include "Core.hh"
@@ -83,6 +85,7 @@
 %template(Mesh1DSP)   detran_utilities::SP<detran_geometry::Mesh1D>;
 %template(Mesh2DSP)   detran_utilities::SP<detran_geometry::Mesh2D>;
 %template(Mesh3DSP)   detran_utilities::SP<detran_geometry::Mesh3D>;
+%template(MeshPartitionerSP) detran_utilities::SP<detran_geometry::MeshPartitioner>;
 
 %template(PinCellSP)  detran_utilities::SP<detran_geometry::PinCell>;
 %template(AssemblySP) detran_utilities::SP<detran_geometry::Assembly>;
@@ -0,0 +1,126 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  test_RegionBVH.cc
+ *  @brief Test of RegionBVH class
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                       \
+        FUNC(test_RegionBVH_candidates) \
+        FUNC(test_RegionBVH_tracker)
+
+#include "TestDriver.hh"
+#include "geometry/RegionBVH.hh"
+#include "geometry/Tracker.hh"
+#include "geometry/Mesh2D.hh"
+#include "angle/QuadratureFactory.hh"
+#include "callow/utils/Initialization.hh"
+#include <cmath>
+#include <cstdlib>
+
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace detran_test;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//----------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------------------------------------//
+
+int test_RegionBVH_candidates(int argc, char *argv[])
+{
+  // A 20 x 20 lattice of 2-D boxes, a box bounded in z, and a region
+  // without a bounding box
+  int n = 20;
+  Geometry::SP_geometry geo = Geometry::Create(n, n, 1);
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      geo->add_region(Region::Create(0, Point(i, j, 0) - 1e-5,
+                                        Point(i + 1, j + 1, 0) + 1e-5));
+    }
+  }
+  geo->add_region(Region::Create(0, Point(5, 5, -1), Point(7, 7, 1)));
+  geo->add_region(Region::Create(0, Point(0, 0, 0), Point(0, 0, 0)));
+  TEST(!geo->region(geo->number_regions() - 1)->has_bounding_box());
+
+  RegionBVH bvh(geo);
+  TEST(bvh.number_nodes() > 1);
+
+  std::srand(1234);
+  for (int k = 0; k < 200; ++k)
+  {
+    double x = n * double(std::rand()) / RAND_MAX;
+    double y = n * double(std::rand()) / RAND_MAX;
+    double phi = 6.283185307179586 * double(std::rand()) / RAND_MAX;
+    Ray ray(Point(x, y, 0), Point(std::cos(phi), std::sin(phi), 0));
+    double length = n * double(std::rand()) / RAND_MAX;
+
+    // Candidates must match a brute-force loop over all regions
+    RegionBVH::vec_size_t ref, regions;
+    for (int r = 0; r < geo->number_regions(); ++r)
+    {
+      Region::SP_region region = geo->region(r);
+      if (!region->has_bounding_box() ||
+          region->intersects_bounding_box(ray, length))
+      {
+        ref.push_back(r);
+      }
+    }
+    bvh.intersect(ray, length, regions);
+    TEST(regions.size() == ref.size());
+    for (int i = 0; i < ref.size(); ++i)
+      TEST(regions[i] == ref[i]);
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_RegionBVH_tracker(int argc, char *argv[])
+{
+  // Tracking with and without the hierarchy gives identical segments
+  vec_dbl cm(2, 0.0);
+  cm[1] = 3.0;
+  vec_int fm(1, 7);
+  vec_int mt(1, 0);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mt));
+
+  TrackDB::SP_trackdb tracks[2];
+  for (int b = 0; b < 2; ++b)
+  {
+    InputDB::SP_input db = InputDB::Create();
+    db->put<double>("tracker_maximum_spacing", 0.1);
+    db->put<std::string>("quad_type", "u-dgl");
+    db->put<int>("quad_number_azimuth_octant", 3);
+    db->put<int>("tracker_use_bvh", b);
+    Tracker::SP_quadrature q = detran_angle::QuadratureFactory::build(db, 2);
+    Tracker tracker(db, q);
+    tracker.trackit(mesh);
+    tracks[b] = tracker.trackdb();
+  }
+
+  TEST(tracks[0]->total_number_segments() > 0);
+  TEST(tracks[0]->total_number_segments() ==
+       tracks[1]->total_number_segments());
+  for (int s = 0; s < tracks[0]->total_number_segments(); ++s)
+  {
+    TEST(tracks[0]->segment_region(s) == tracks[1]->segment_region(s));
+    TEST(tracks[0]->segment_length(s) == tracks[1]->segment_length(s));
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+//              end of test_RegionBVH.cc
+//----------------------------------------------------------------------------//
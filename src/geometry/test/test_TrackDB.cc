@@ -9,11 +9,13 @@
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST             \
         FUNC(test_TrackDB_2D) \
-        FUNC(test_TrackDB_3D)
+        FUNC(test_TrackDB_3D) \
+        FUNC(test_TrackDB_flat)
 
 #include "TestDriver.hh"
 #include "TrackDB.hh"
 #include "angle/QuadratureFactory.hh"
+#include "utilities/SoftEquivalence.hh"
 
 using namespace detran_angle;
 using namespace detran_geometry;
@@ -118,6 +120,53 @@ int test_TrackDB_3D(int argc, char *argv[])
   return 0;
 }
 
+//----------------------------------------------------------------------------//
+int test_TrackDB_flat(int argc, char *argv[])
+{
+  InputDB::SP_input db = InputDB::Create();
+  db->put<string>("quad_type", "u-dgl");
+  db->put<int>("quad_number_azimuth_octant", 2);
+  db->put<int>("quad_number_polar_octant",   1);
+  QF::SP_quadrature q = QF::build(db, 2);
+
+  TrackDB trackdb(q);
+  for (int a = 0; a < 4; ++a)
+  {
+    for (int t = 0; t < a + 1; ++t)
+    {
+      TrackDB::SP_track track(new Track(Point(0, t), Point(1, t+1), 0.1*(t+1)));
+      for (int s = 0; s <= t; ++s)
+        track->add_segment(Segment(a + s, 0.5 * (s + 1)));
+      trackdb.add_track(a, 0, track);
+    }
+  }
+  trackdb.flatten(true);
+  TEST(trackdb.is_flat());
+  TEST(!trackdb.has_tracks());
+  TEST(trackdb.total_number_tracks() == 10);
+  TEST(trackdb.total_number_segments() == 20);
+
+  // Tracks and segments are stored contiguously by angle.
+  for (int a = 0; a < 4; ++a)
+  {
+    TEST(trackdb.number_tracks(a, 0) == a + 1);
+    TEST(trackdb.first_track(a) == a * (a + 1) / 2);
+    for (int t = 0; t < a + 1; ++t)
+    {
+      TrackDB::size_t track = trackdb.first_track(a) + t;
+      TEST(soft_equiv(trackdb.track_width(track), 0.1 * (t + 1)));
+      TrackDB::size_t s0 = trackdb.segment_begin(track);
+      TEST(trackdb.segment_end(track) - s0 == t + 1);
+      for (int s = 0; s <= t; ++s)
+      {
+        TEST(trackdb.segment_region(s0 + s) == a + s);
+        TEST(soft_equiv(trackdb.segment_length(s0 + s), 0.5 * (s + 1)));
+      }
+    }
+  }
+  return 0;
+}
+
 //---------------------------------------------------------------------------//
 //              end of test_TrackDB.cc
 //---------------------------------------------------------------------------//
@@ -0,0 +1,194 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  test_TrackFile.cc
+ *  @brief Test of TrackFile class
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                       \
+        FUNC(test_TrackFile_reuse)      \
+        FUNC(test_TrackFile_stale)      \
+        FUNC(test_TrackFile_failed)
+
+#include "TestDriver.hh"
+#include "geometry/TrackFile.hh"
+#include "geometry/Tracker.hh"
+#include "geometry/Mesh2D.hh"
+#include "geometry/QuadraticSurfaceFactory.hh"
+#include "angle/QuadratureFactory.hh"
+#include "callow/utils/Initialization.hh"
+#include <cstdio>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace detran_test;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//----------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------------------------------------//
+
+Mesh::SP_mesh test_mesh()
+{
+  vec_dbl cm(3, 0.0);
+  cm[1] = 1.0;
+  cm[2] = 3.0;
+  vec_int fm(2, 3);
+  vec_int mt(4, 0);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mt));
+  return mesh;
+}
+
+TrackDB::SP_trackdb test_track(const std::string &file,
+                               const double       spacing,
+                               const int          cyclic = 0)
+{
+  InputDB::SP_input db = InputDB::Create();
+  db->put<double>("tracker_maximum_spacing", spacing);
+  db->put<std::string>("quad_type", "u-dgl");
+  db->put<int>("quad_number_azimuth_octant", 3);
+  db->put<std::string>("tracker_track_file", file);
+  db->put<int>("tracker_cyclic", cyclic);
+  Tracker::SP_quadrature q = detran_angle::QuadratureFactory::build(db, 2);
+  Tracker tracker(db, q);
+  tracker.trackit(test_mesh());
+  return tracker.trackdb();
+}
+
+//----------------------------------------------------------------------------//
+int test_TrackFile_reuse(int argc, char *argv[])
+{
+  // The first run tracks and writes the file, and the second maps it.
+  std::string file = "test_TrackFile_reuse.trk";
+  for (int c = 0; c < 2; ++c)
+  {
+    std::remove(file.c_str());
+    TrackDB::SP_trackdb tracked = test_track(file, 0.1, c);
+    TrackDB::SP_trackdb mapped  = test_track(file, 0.1, c);
+    TEST(tracked->has_tracks());
+    TEST(!mapped->has_tracks());
+    TEST(mapped->is_flat());
+
+    TEST(mapped->total_number_tracks() == tracked->total_number_tracks());
+    TEST(mapped->total_number_segments() == tracked->total_number_segments());
+    for (int a = 0; a < tracked->number_azimuths(); ++a)
+    {
+      TEST(mapped->number_tracks(a) == tracked->number_tracks(a));
+      TEST(mapped->first_track(a) == tracked->first_track(a));
+    }
+    for (int t = 0; t < tracked->total_number_tracks(); ++t)
+    {
+      TEST(mapped->track_width(t) == tracked->track_width(t));
+      TEST(mapped->segment_begin(t) == tracked->segment_begin(t));
+      TEST(mapped->segment_end(t) == tracked->segment_end(t));
+    }
+    for (int s = 0; s < tracked->total_number_segments(); ++s)
+    {
+      TEST(mapped->segment_region(s) == tracked->segment_region(s));
+      TEST(mapped->segment_length(s) == tracked->segment_length(s));
+    }
+
+    // Cyclic tracks keep their links.
+    TEST(mapped->is_linked() == (c == 1));
+    for (int t = 0; c && t < tracked->total_number_tracks(); ++t)
+    {
+      for (int d = 0; d < 2; ++d)
+      {
+        TEST(mapped->exit_side(t, d) == tracked->exit_side(t, d));
+        TEST(mapped->link(t, d, 0) == tracked->link(t, d, 0));
+        TEST(mapped->link(t, d, 1) == tracked->link(t, d, 1));
+      }
+    }
+  }
+
+  std::remove(file.c_str());
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_TrackFile_stale(int argc, char *argv[])
+{
+  // A file for other tracking parameters is ignored and replaced.
+  std::string file = "test_TrackFile_stale.trk";
+  std::remove(file.c_str());
+  TrackDB::SP_trackdb coarse = test_track(file, 0.2);
+  TrackDB::SP_trackdb fine   = test_track(file, 0.1);
+  TEST(fine->has_tracks());
+  TEST(fine->total_number_tracks() > coarse->total_number_tracks());
+  TEST(!test_track(file, 0.1)->has_tracks());
+  TEST(test_track(file, 0.2)->has_tracks());
+
+  // Geometries that differ only within a region's box have other keys,
+  // however small the difference in a surface or however the sense.
+  TrackFile::key_t key[5];
+  double radius[5] = {0.2, 0.45, 0.2, 0.2 + 1.0e-12, 0.2};
+  bool   sense[5]  = {false, false, false, false, true};
+  for (int i = 0; i < 5; ++i)
+  {
+    Geometry::SP_geometry geo = Geometry::Create(1, 1, 1);
+    Region::SP_region pin = Region::Create(0, Point(0, 0, 0), Point(1, 1, 0));
+    pin->append(QuadraticSurfaceFactory::CreateCylinderZ(0.5, 0.5, radius[i]),
+                sense[i]);
+    geo->add_region(pin);
+    TrackFile::Hash hash;
+    hash.add(geo);
+    key[i] = hash.value();
+  }
+  TEST(key[0] != key[1]);
+  TEST(key[0] == key[2]);
+  TEST(key[0] != key[3]);
+  TEST(key[0] != key[4]);
+
+  std::remove(file.c_str());
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_TrackFile_failed(int argc, char *argv[])
+{
+  // A write that fails, here because a directory holds the name, throws
+  // and leaves no temporary behind.
+  std::string source = "test_TrackFile_failed_source.trk";
+  std::string file   = "test_TrackFile_failed.trk";
+  std::remove(source.c_str());
+  TrackDB::SP_trackdb tracks = test_track(source, 0.2);
+  rmdir(file.c_str());
+  mkdir(file.c_str(), 0755);
+  bool thrown = false;
+  try
+  {
+    TrackFile::write(file, *tracks, 0);
+  }
+  catch (...)
+  {
+    thrown = true;
+  }
+  TEST(thrown);
+  std::string prefix = file + ".";
+  int number_left = 0;
+  DIR *dir = opendir(".");
+  TEST(dir);
+  for (dirent *entry = readdir(dir); entry; entry = readdir(dir))
+    if (std::string(entry->d_name).compare(0, prefix.size(), prefix) == 0)
+      ++number_left;
+  closedir(dir);
+  TEST(number_left == 0);
+  rmdir(file.c_str());
+  std::remove(source.c_str());
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+//              end of test_TrackFile.cc
+//----------------------------------------------------------------------------//
@@ -11,7 +11,9 @@
         FUNC(test_Tracker_2d_mesh)    \
         FUNC(test_Tracker_3d_mesh)    \
         FUNC(test_Tracker_pin_2d)     \
-        FUNC(test_Tracker_box_3d)
+        FUNC(test_Tracker_box_3d)     \
+        FUNC(test_Tracker_threads)    \
+        FUNC(test_Tracker_cyclic)
 
 #include "TestDriver.hh"
 #include "Tracker.hh"
@@ -248,6 +250,98 @@ int test_Tracker_box_3d(int argc, char *argv[])
   return 0;
 }
 
+//----------------------------------------------------------------------------//
+int test_Tracker_threads(int argc, char *argv[])
+{
+  // Threaded tracking must reproduce serial tracking exactly
+  vec_dbl cm(2, 0.0);
+  cm[1] = 2.0;
+  vec_int fm(1,  9);
+  vec_int mt(1,  0);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mt));
+
+  TrackDB::SP_trackdb tracks[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    InputDB::SP_input db = InputDB::Create();
+    db->put<double>("tracker_maximum_spacing", 0.05);
+    db->put<std::string>("quad_type", "u-dgl");
+    db->put<int>("quad_number_azimuth_octant", 3);
+    db->put<int>("tracker_number_threads", 1 + 3 * i);
+    Tracker::SP_quadrature q = detran_angle::QuadratureFactory::build(db, 2);
+    Tracker tracker(db, q);
+    tracker.trackit(mesh);
+    tracks[i] = tracker.trackdb();
+  }
+
+  TEST(tracks[0]->total_number_tracks() == tracks[1]->total_number_tracks());
+  for (int t = 0; t < tracks[0]->total_number_tracks(); ++t)
+  {
+    TEST(tracks[0]->track_width(t)   == tracks[1]->track_width(t));
+    TEST(tracks[0]->segment_begin(t) == tracks[1]->segment_begin(t));
+    TEST(tracks[0]->segment_end(t)   == tracks[1]->segment_end(t));
+  }
+  for (int s = 0; s < tracks[0]->total_number_segments(); ++s)
+  {
+    TEST(tracks[0]->segment_region(s) == tracks[1]->segment_region(s));
+    TEST(tracks[0]->segment_length(s) == tracks[1]->segment_length(s));
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Tracker_cyclic(int argc, char *argv[])
+{
+  // Every track leads into another at each side, and following a link
+  // backward leads back to where it came from.
+  vec_dbl cm(2, 0.0);
+  cm[1] = 2.0;
+  vec_dbl cm_y(2, 0.0);
+  cm_y[1] = 3.0;
+  vec_int fm(1, 4);
+  vec_int mt(1, 0);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm_y, mt));
+
+  InputDB::SP_input db = InputDB::Create();
+  db->put<double>("tracker_maximum_spacing", 0.2);
+  db->put<std::string>("quad_type", "u-dgl");
+  db->put<int>("quad_number_azimuth_octant", 3);
+  db->put<int>("tracker_cyclic", 1);
+  Tracker::SP_quadrature q = QuadratureFactory::build(db, 2);
+  Tracker tracker(db, q);
+  tracker.trackit(mesh);
+  TrackDB::SP_trackdb tracks = tracker.trackdb();
+  TEST(tracks->is_linked());
+
+  for (int a = 0; a < 3; ++a)
+  {
+    // The corrected azimuth fits whole numbers of tracks on both sides.
+    double width = tracks->track_width(tracks->first_track(a));
+    double nx = 2.0 * q->sin_phi(a) / width;
+    double ny = 3.0 * q->cos_phi(a) / width;
+    TEST(soft_equiv(nx, std::floor(nx + 0.5)));
+    TEST(soft_equiv(ny, std::floor(ny + 0.5)));
+    TEST(tracks->number_tracks(a) == int(nx + 0.5) + int(ny + 0.5));
+  }
+  for (int t = 0; t < tracks->total_number_tracks(); ++t)
+  {
+    for (int d = 0; d < 2; ++d)
+    {
+      for (int k = 0; k < 2; ++k)
+      {
+        int link = tracks->link(t, d, k);
+        TEST(link >= 0 && link < 2 * tracks->total_number_tracks());
+        // Reversing the linked track leads back to this one reversed.
+        int back = tracks->link(link / 2, 1 - link % 2, k);
+        TEST(back == 2 * t + 1 - d);
+      }
+    }
+  }
+
+  return 0;
+}
+
 //----------------------------------------------------------------------------//
 //              end of test_Tracker.cc
 //----------------------------------------------------------------------------//
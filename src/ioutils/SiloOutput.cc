@@ -191,8 +191,9 @@ bool SiloOutput::write_angular_flux(SP_state state, SP_quadrature quad)
         char buffer[14];
         sprintf(buffer, "g%i_o%i_a%i", g, o, a);
 
-        // Get a pointer to the group flux
-        double *psi = &state->psi(g, o, a)[0];
+        // Get a copy of the group flux
+        State::angular_flux_type psi_ga = state->psi(g, o, a);
+        double *psi = &psi_ga[0];
 
         // Write to silo
         DBPutQuadvar1(d_silofile, buffer, "mesh", psi,
@@ -105,11 +105,10 @@ inline void SyntheticDiscreteSource::build(const double dt,
           size_t angle = d_quadrature->index(o, a);
 
           // Add flux
+          const State::angular_flux_type psi = states[j]->psi(g, o, a);
           for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
           {
-            d_source[g][angle][cell] +=
-              psi_factor * states[j]->psi(g, o, a)[cell];
-            //std::cout << " j = " << j << " psi = " << states[j]->psi(g, o, a)[cell] << std::endl;
+            d_source[g][angle][cell] += psi_factor * psi[cell];
           }
 
           // Add the precursor concentration, if applicable
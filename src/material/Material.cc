@@ -39,6 +39,9 @@ Material::Material(const size_t number_materials,
  , d_diff_coef(number_groups, vec_dbl(number_materials, 0.0))
  , d_scatter_bounds(number_groups, vec_size_t(4, 0))
  , d_finalized(false)
+ , d_stride(8 * ((number_materials + 7) / 8))
+ , d_xs_table(END_XS_TYPES * number_groups * d_stride, 0.0)
+ , d_zero(d_stride, 0.0)
 {
   Ensure(d_sigma_t.size() == number_groups);
   Ensure(d_sigma_t[0].size() == number_materials);
@@ -46,6 +49,7 @@ Material::Material(const size_t number_materials,
   d_downscatter[1] = false;
   d_upscatter_cutoff[0] = d_number_groups;
   d_upscatter_cutoff[1] = 0;
+  build_xs_table();
 }
 
 //---------------------------------------------------------------------------//
@@ -71,6 +75,7 @@ void Material::set_sigma_t(size_t m, size_t g, double v)
   Require(g < d_number_groups);
   Require(v >= 0.0);
   d_sigma_t[g][m] = v;
+  d_xs_table[xs_index(SIGMA_T, g, m)] = v;
 }
 
 //---------------------------------------------------------------------------//
@@ -80,6 +85,7 @@ void Material::set_sigma_a(size_t m, size_t g, double v)
   Require(g < d_number_groups);
   Require(v >= 0.0);
   d_sigma_a[g][m] = v;
+  d_xs_table[xs_index(SIGMA_A, g, m)] = v;
 }
 
 //---------------------------------------------------------------------------//
@@ -89,6 +95,7 @@ void Material::set_nu_sigma_f(size_t m, size_t g, double v)
   Require(g < d_number_groups);
   Require(v >= 0.0);
   d_nu_sigma_f[g][m] = v;
+  d_xs_table[xs_index(NU_SIGMA_F, g, m)] = v;
 }
 
 //---------------------------------------------------------------------------//
@@ -98,6 +105,7 @@ void Material::set_sigma_f(size_t m, size_t g, double v)
   Require(g < d_number_groups);
   Require(v >= 0.0);
   d_sigma_f[g][m] = v;
+  d_xs_table[xs_index(SIGMA_F, g, m)] = v;
 }
 
 //---------------------------------------------------------------------------//
@@ -107,6 +115,7 @@ void Material::set_nu(size_t m, size_t g, double v)
   Require(g < d_number_groups);
   Require(v >= 0.0);
   d_nu[g][m] = v;
+  d_xs_table[xs_index(NU, g, m)] = v;
 }
 
 //---------------------------------------------------------------------------//
@@ -116,6 +125,7 @@ void Material::set_chi(size_t m, size_t g, double v)
   Require(g < d_number_groups);
   Require(v >= 0.0);
   d_chi[g][m] = v;
+  d_xs_table[xs_index(CHI, g, m)] = v;
 }
 
 //---------------------------------------------------------------------------//
@@ -127,6 +137,7 @@ void Material::set_sigma_s(size_t m, size_t g, size_t gp, double v)
   Require(gp < d_number_groups);
   Require(v >= 0.0);
   d_sigma_s[g][gp][m] = v;
+  if (d_finalized) update_sigma_s_table(m, g, gp);
 }
 
 //---------------------------------------------------------------------------//
@@ -136,6 +147,7 @@ void Material::set_diff_coef(size_t m, size_t g, double v)
   Require(g < d_number_groups);
   Require(v >= 0.0);
   d_diff_coef[g][m] = v;
+  d_xs_table[xs_index(DIFF_COEF, g, m)] = v;
 }
 
 // Vectorized
@@ -146,7 +158,10 @@ void Material::set_sigma_t(size_t m, vec_dbl &v)
   Require(m < d_number_materials);
   Require(v.size() == d_number_groups);
   for (size_t g = 0; g < d_number_groups; g++)
+  {
     d_sigma_t[g][m] = v[g];
+    d_xs_table[xs_index(SIGMA_T, g, m)] = v[g];
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -155,7 +170,10 @@ void Material::set_sigma_a(size_t m, vec_dbl &v)
   Require(m < d_number_materials);
   Require(v.size() == d_number_groups);
   for (size_t g = 0; g < d_number_groups; g++)
+  {
     d_sigma_a[g][m] = v[g];
+    d_xs_table[xs_index(SIGMA_A, g, m)] = v[g];
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -164,7 +182,10 @@ void Material::set_nu_sigma_f(size_t m, vec_dbl &v)
   Require(m < d_number_materials);
   Require(v.size() == d_number_groups);
   for (size_t g = 0; g < d_number_groups; g++)
+  {
     d_nu_sigma_f[g][m] = v[g];
+    d_xs_table[xs_index(NU_SIGMA_F, g, m)] = v[g];
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -173,7 +194,10 @@ void Material::set_sigma_f(size_t m, vec_dbl &v)
   Require(m < d_number_materials);
   Require(v.size() == d_number_groups);
   for (size_t g = 0; g < d_number_groups; g++)
+  {
     d_sigma_f[g][m] = v[g];
+    d_xs_table[xs_index(SIGMA_F, g, m)] = v[g];
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -182,7 +206,10 @@ void Material::set_nu(size_t m, vec_dbl &v)
   Require(m < d_number_materials);
   Require(v.size() == d_number_groups);
   for (size_t g = 0; g < d_number_groups; g++)
+  {
     d_nu[g][m] = v[g];
+    d_xs_table[xs_index(NU, g, m)] = v[g];
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -191,7 +218,10 @@ void Material::set_chi(size_t m, vec_dbl &v)
   Require(m < d_number_materials);
   Require(v.size() == d_number_groups);
   for (size_t g = 0; g < d_number_groups; g++)
+  {
     d_chi[g][m] = v[g];
+    d_xs_table[xs_index(CHI, g, m)] = v[g];
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -201,7 +231,10 @@ void Material::set_sigma_s(size_t m, size_t g, vec_dbl &v)
   Require(g < d_number_groups);
   Require(v.size() == d_number_groups);
   for (size_t gp = 0; gp < d_number_groups; gp++)
+  {
     d_sigma_s[g][gp][m] = v[gp];
+    if (d_finalized) update_sigma_s_table(m, g, gp);
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -210,7 +243,10 @@ void Material::set_diff_coef(size_t m, vec_dbl &v)
   Require(m < d_number_materials);
   Require(v.size() == d_number_groups);
   for (size_t g = 0; g < d_number_groups; g++)
+  {
     d_diff_coef[g][m] = v[g];
+    d_xs_table[xs_index(DIFF_COEF, g, m)] = v[g];
+  }
 }
 
 //----------------------------------------------------------------------------//
@@ -262,6 +298,7 @@ void Material::compute_sigma_a()
       d_sigma_a[g][m] = sa;
     }
   }
+  build_xs_table();
 }
 
 //----------------------------------------------------------------------------//
@@ -275,6 +312,7 @@ void Material::compute_diff_coef()
       d_diff_coef[g][m] =  coef / d_sigma_t[g][m];
     }
   }
+  build_xs_table();
 }
 
 //----------------------------------------------------------------------------//
@@ -360,9 +398,29 @@ void Material::finalize()
     for (size_t m = 0; m < d_number_materials; m++)
       d_nu_sigma_f[g][m] = d_nu[g][m] * d_sigma_f[g][m];
 
+  // Refresh the dense tables, since the nested data may have been
+  // modified directly (e.g. by derived classes).
+  build_xs_table();
+  build_sigma_s_table();
+
   d_finalized = true;
 }
 
+//----------------------------------------------------------------------------//
+void Material::expand(const size_t   type,
+                      const size_t   g,
+                      const vec_int &map,
+                      vec_dbl       &v) const
+{
+  const double *row = xs(type, g);
+  v.resize(map.size());
+  for (size_t i = 0; i < map.size(); ++i)
+  {
+    Assert(map[i] < d_number_materials);
+    v[i] = row[map[i]];
+  }
+}
+
 void Material::display()
 {
   material_display();
@@ -372,6 +430,91 @@ void Material::display()
 // IMPLEMENTATION
 //----------------------------------------------------------------------------//
 
+//----------------------------------------------------------------------------//
+void Material::build_xs_table()
+{
+  const vec2_dbl *data[] = {&d_sigma_t, &d_sigma_a, &d_nu_sigma_f,
+                            &d_sigma_f, &d_nu, &d_chi, &d_diff_coef};
+  for (size_t t = 0; t < END_XS_TYPES; ++t)
+    for (size_t g = 0; g < d_number_groups; ++g)
+      for (size_t m = 0; m < d_number_materials; ++m)
+        d_xs_table[xs_index(t, g, m)] = (*data[t])[g][m];
+}
+
+//----------------------------------------------------------------------------//
+void Material::build_sigma_s_table()
+{
+  // Row g holds g' = lower(g) ... upper(g), each a padded material row.
+  d_sigma_s_offset.assign(d_number_groups + 1, 0);
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    size_t band = d_scatter_bounds[g][1] - d_scatter_bounds[g][0] + 1;
+    d_sigma_s_offset[g + 1] = d_sigma_s_offset[g] + band * d_stride;
+  }
+  d_sigma_s_table.assign(d_sigma_s_offset[d_number_groups], 0.0);
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    size_t lo = d_scatter_bounds[g][0];
+    for (size_t gp = lo; gp <= d_scatter_bounds[g][1]; ++gp)
+    {
+      double *row =
+        &d_sigma_s_table[d_sigma_s_offset[g] + (gp - lo) * d_stride];
+      for (size_t m = 0; m < d_number_materials; ++m)
+        row[m] = d_sigma_s[g][gp][m];
+    }
+  }
+
+  // Rows of S and of its transpose by material.
+  for (int t = 0; t < 2; ++t)
+  {
+    bool tran = t;
+    vec_size_t &offset = d_sigma_s_row_offset[t];
+    offset.assign(d_number_groups + 1, 0);
+    for (size_t g = 0; g < d_number_groups; ++g)
+      offset[g + 1] = offset[g] + row_last(g, tran) - row_first(g, tran) + 1;
+    size_t size = offset[d_number_groups];
+    d_sigma_s_rows[t].assign(d_number_materials * size, 0.0);
+    for (size_t m = 0; m < d_number_materials; ++m)
+    {
+      for (size_t g = 0; g < d_number_groups; ++g)
+      {
+        double *row = &d_sigma_s_rows[t][m * size + offset[g]];
+        for (size_t gp = row_first(g, tran); gp <= row_last(g, tran); ++gp)
+        {
+          *row++ = tran ? d_sigma_s[gp][g][m] : d_sigma_s[g][gp][m];
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------//
+void Material::update_sigma_s_table(const size_t m,
+                                    const size_t g,
+                                    const size_t gp)
+{
+  size_t lo = d_scatter_bounds[g][0];
+  size_t hi = d_scatter_bounds[g][1];
+  if (gp < lo || gp > hi)
+  {
+    if (d_sigma_s[g][gp][m] > 0.0) finalize(); // the bounds have changed
+    return;
+  }
+  double v = d_sigma_s[g][gp][m];
+  d_sigma_s_table[d_sigma_s_offset[g] + (gp - lo) * d_stride + m] = v;
+  // Row g of S and row gp of its transpose
+  const vec_size_t &offset = d_sigma_s_row_offset[0];
+  d_sigma_s_rows[0][m * offset[d_number_groups] + offset[g] + gp - lo] = v;
+  if (g < row_first(gp, true) || g > row_last(gp, true))
+  {
+    if (v > 0.0) finalize();
+    return;
+  }
+  const vec_size_t &offset_t = d_sigma_s_row_offset[1];
+  d_sigma_s_rows[1][m * offset_t[d_number_groups] + offset_t[gp] +
+                    g - row_first(gp, true)] = v;
+}
+
 //----------------------------------------------------------------------------//
 void Material::material_display()
 {
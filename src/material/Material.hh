@@ -10,6 +10,7 @@
 #define detran_material_MATERIAL_HH_
 
 #include "material/material_export.hh"
+#include "utilities/AlignedAllocator.hh"
 #include "utilities/Definitions.hh"
 #include "utilities/SP.hh"
 #include <string>
@@ -31,6 +32,15 @@ namespace detran_material
  *
  *  All data is stored with the material index changing fastest.  This
  *  appears to be the best storage scheme with respect to memory access.
+ *
+ *  In addition to the nested arrays set by the user, the group-wise data
+ *  is kept in one contiguous block of [type][group][material] rows, each
+ *  padded to a multiple of eight doubles.  The block starts on a 64-byte
+ *  boundary, so every row starts on a cache line.  finalize() packs the
+ *  scattering matrix into a banded block, laid out the same way, that
+ *  spans only the groups within the scatter bounds.  These are the tables solvers should use
+ *  in their inner loops, via xs() and sigma_s_band(), which return
+ *  pointers to a row of values indexed by material.
  */
 //---------------------------------------------------------------------------//
 class MATERIAL_EXPORT Material
@@ -51,6 +61,13 @@ public:
   typedef detran_utilities::vec_size_t   vec_size_t;
   typedef detran_utilities::vec2_size_t  vec2_size_t;
   typedef detran_utilities::size_t       size_t;
+  typedef detran_utilities::vec_dbl_aligned  vec_dbl_aligned;
+
+  /// Group-wise cross section types stored in the dense table
+  enum XS_TYPES
+  {
+    SIGMA_T, SIGMA_A, NU_SIGMA_F, SIGMA_F, NU, CHI, DIFF_COEF, END_XS_TYPES
+  };
 
   //-------------------------------------------------------------------------//
   // PUBLIC INTERFACE
@@ -132,6 +149,76 @@ public:
   virtual vec2_dbl sigma_s(size_t m) const;
   virtual vec_dbl diff_coef(size_t m) const;
 
+  //------------------------------------------------------------------------//
+  // DENSE TABLES
+  //------------------------------------------------------------------------//
+
+  /**
+   *  @brief Cross section values for all materials in a group
+   *  @param  type    Cross section type (e.g. Material::SIGMA_T)
+   *  @param  g       Group index
+   *  @return         Pointer to the row, indexed by material
+   */
+  inline const double* xs(const size_t type, const size_t g) const;
+
+  /**
+   *  @brief Scattering cross section \f$ g \leftarrow g' \f$ for all
+   *         materials
+   *
+   *  Only the band within the scatter bounds of row g is stored; outside
+   *  it, the returned row is zero.  Requires a finalized material.
+   *
+   *  @param  g       Outgoing group
+   *  @param  gp      Incident group
+   *  @return         Pointer to the row, indexed by material
+   */
+  inline const double* sigma_s_band(const size_t g, const size_t gp) const;
+
+  /**
+   *  @brief Scattering row of one material
+   *
+   *  Row g of \f$ \mathbf{S} \f$ (or of its transpose if tran is set)
+   *  for material m, stored contiguously for the incident groups between
+   *  row_first(g, tran) and row_last(g, tran).  This is the layout for
+   *  kernels that visit each cell once and compute all groups.
+   *  Requires a finalized material.
+   *
+   *  @param  m       Material index
+   *  @param  g       Row
+   *  @param  tran    Flag for accessing transpose of S
+   *  @return         Pointer to the entry for row_first(g, tran)
+   */
+  inline const double*
+  sigma_s_row(const size_t m, const size_t g, bool tran = false) const;
+
+  /// First group in the stored part of a scattering row
+  size_t row_first(const size_t g, bool tran = false) const
+  {
+    return tran ? d_scatter_bounds[g][3] : d_scatter_bounds[g][0];
+  }
+
+  /// Last group in the stored part of a scattering row
+  size_t row_last(const size_t g, bool tran = false) const
+  {
+    return tran ? d_scatter_bounds[g][2] : d_scatter_bounds[g][1];
+  }
+
+  /**
+   *  @brief Expand a cross section row onto cells
+   *
+   *  Sweeps can cache e.g. the total cross section by cell for one group
+   *  to avoid the material lookup in the inner loop.
+   *
+   *  @param  type    Cross section type
+   *  @param  g       Group index
+   *  @param  map     Material index of each cell
+   *  @param  v       Values by cell (resized as needed)
+   */
+  void expand(const size_t   type,
+              const size_t   g,
+              const vec_int &map,
+              vec_dbl       &v) const;
+
   //------------------------------------------------------------------------//
   // OTHER ACCESSORS
   //------------------------------------------------------------------------//
@@ -238,6 +325,20 @@ protected:
   size_t d_upscatter_cutoff[2];
   /// Are we ready to be used?
   bool d_finalized;
+  /// Padded number of materials, i.e. the length of a table row
+  size_t d_stride;
+  /// Dense group-wise data [type, group, material]
+  vec_dbl_aligned d_xs_table;
+  /// Banded scatter [group<-, group' in bounds, material]
+  vec_dbl_aligned d_sigma_s_table;
+  /// Start of each outgoing group's band in the scatter table
+  vec_size_t d_sigma_s_offset;
+  /// A zero row for scatter outside the band
+  vec_dbl_aligned d_zero;
+  /// Scatter rows [material, group, group' in bounds] for S and S^T
+  vec_dbl d_sigma_s_rows[2];
+  /// Start of each row within a material's rows for S and S^T
+  vec_size_t d_sigma_s_row_offset[2];
 
   //-------------------------------------------------------------------------//
   // IMPLEMENTATION
@@ -245,6 +346,21 @@ protected:
 
   void material_display();
 
+  /// Position of a value in the dense table
+  size_t xs_index(const size_t type, const size_t g, const size_t m) const
+  {
+    return (type * d_number_groups + g) * d_stride + m;
+  }
+
+  /// Copy the nested arrays into the dense table.
+  void build_xs_table();
+
+  /// Pack the scattering matrix within the scatter bounds.
+  void build_sigma_s_table();
+
+  /// Update one scatter entry of a finalized table.
+  void update_sigma_s_table(const size_t m, const size_t g, const size_t gp);
+
 #ifdef DETRAN_ENABLE_BOOST
 
   /// Default constructor needed for serialization
@@ -269,6 +385,13 @@ protected:
     ar & d_scatter_bounds;
     ar & d_upscatter_cutoff;
     ar & d_finalized;
+    ar & d_stride;
+    ar & d_xs_table;
+    ar & d_sigma_s_table;
+    ar & d_sigma_s_offset;
+    ar & d_zero;
+    ar & d_sigma_s_rows;
+    ar & d_sigma_s_row_offset;
   }
 
 #endif
@@ -165,6 +165,38 @@ inline Material::vec_dbl Material::diff_coef(size_t m) const
   return v;
 }
 
+//---------------------------------------------------------------------------//
+inline const double* Material::xs(const size_t type, const size_t g) const
+{
+  Require(type < END_XS_TYPES);
+  Require(g < d_number_groups);
+  return &d_xs_table[xs_index(type, g, 0)];
+}
+
+//---------------------------------------------------------------------------//
+inline const double*
+Material::sigma_s_band(const size_t g, const size_t gp) const
+{
+  Require(d_finalized);
+  Require(g < d_number_groups);
+  Require(gp < d_number_groups);
+  size_t lo = d_scatter_bounds[g][0];
+  size_t hi = d_scatter_bounds[g][1];
+  if (gp < lo || gp > hi) return &d_zero[0];
+  return &d_sigma_s_table[d_sigma_s_offset[g] + (gp - lo) * d_stride];
+}
+
+//---------------------------------------------------------------------------//
+inline const double*
+Material::sigma_s_row(const size_t m, const size_t g, bool tran) const
+{
+  Require(d_finalized);
+  Require(m < d_number_materials);
+  Require(g < d_number_groups);
+  const vec_size_t &offset = d_sigma_s_row_offset[tran];
+  return &d_sigma_s_rows[tran][m * offset[d_number_groups] + offset[g]];
+}
+
 } // end namespace detran
 
 #endif /* detran_material_MATERIAL_I_HH_ */
@@ -10,7 +10,8 @@
 #define TEST_LIST                     \
         FUNC(test_Material_basic)     \
         FUNC(test_Material_bounds)    \
-        FUNC(test_Material_serialize)
+        FUNC(test_Material_serialize) \
+        FUNC(test_Material_tables)
 
 // Detran headers
 #include "TestDriver.hh"
@@ -167,6 +168,54 @@ int test_Material_serialize(int argc, char *argv[])
   return 0;
 }
 
+// Test of the dense tables against the scalar accessors
+int test_Material_tables(int argc, char *argv[])
+{
+  SP_material mat = material_fixture_7g();
+  int nm = mat->number_materials();
+  int ng = mat->number_groups();
+  for (int g = 0; g < ng; ++g)
+  {
+    const double *st = mat->xs(Material::SIGMA_T, g);
+    const double *nsf = mat->xs(Material::NU_SIGMA_F, g);
+    const double *chi = mat->xs(Material::CHI, g);
+    // Every row starts on a cache line.
+    TEST(reinterpret_cast<unsigned long>(st)  % 64 == 0);
+    TEST(reinterpret_cast<unsigned long>(nsf) % 64 == 0);
+    for (int m = 0; m < nm; ++m)
+    {
+      TEST(st[m]  == mat->sigma_t(m, g));
+      TEST(nsf[m] == mat->nu_sigma_f(m, g));
+      TEST(chi[m] == mat->chi(m, g));
+    }
+    // The band covers every nonzero entry, forward and adjoint.
+    for (int gp = 0; gp < ng; ++gp)
+    {
+      const double *ss = mat->sigma_s_band(g, gp);
+      TEST(reinterpret_cast<unsigned long>(ss) % 64 == 0);
+      for (int m = 0; m < nm; ++m)
+        TEST(ss[m] == mat->sigma_s(m, g, gp));
+    }
+  }
+
+  // Setting after finalization writes through, including outside the band.
+  mat->set_sigma_t(1, 2, 0.5);
+  TEST(mat->xs(Material::SIGMA_T, 2)[1] == 0.5);
+  TEST(mat->upper(0) == 0);
+  mat->set_sigma_s(2, 0, 3, 0.01);
+  TEST(mat->upper(0) == 3);
+  TEST(mat->sigma_s_band(0, 3)[2] == 0.01);
+
+  // Cell expansion
+  vec_int map(5, 0);
+  map[1] = 1; map[4] = 2;
+  vec_dbl st_cell;
+  mat->expand(Material::SIGMA_T, 2, map, st_cell);
+  TEST(st_cell.size() == 5);
+  TEST(st_cell[1] == 0.5);
+  TEST(st_cell[4] == mat->sigma_t(2, 2));
+  return 0;
+}
 
 //---------------------------------------------------------------------------//
 //              end of test_Material.cc
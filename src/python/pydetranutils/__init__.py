@@ -12,4 +12,5 @@ except ImportError :
   print "Warning: Could not import matplotlib."
 
 from mesh_plot import *
-from quad_plot import *
\ No newline at end of file
+from quad_plot import *
+from track_file import *
\ No newline at end of file
@@ -0,0 +1,96 @@
+# Reader for the binary track files written by detran_geometry::TrackFile
+#
+# The arrays are memory mapped, so large files are not read until used.
+
+import numpy as np
+
+_MAGIC = b"DTRNTRK\0"
+_HEADER = np.dtype([("magic",           "S8"),
+                    ("version",         "u4"),
+                    ("byte_order",      "u4"),
+                    ("key",             "u8"),
+                    ("dimension",       "u4"),
+                    ("number_azimuths", "u4"),
+                    ("number_polar",    "u4"),
+                    ("offset_bytes",    "u4"),
+                    ("number_tracks",   "u8"),
+                    ("number_segments", "u8"),
+                    ("linked",          "u8"),
+                    ("offset",          "u8", (7,)),
+                    ("file_bytes",      "u8")])
+
+class TrackFile(object) :
+    """ Flat track arrays of a track file.
+
+    Track t of angle (a, p) is flat track angle_offset[a*number_polar+p]+t,
+    and its segments are track_offset[t] to track_offset[t+1] in the
+    segment_region and segment_length arrays.  For linked (cyclic) tracks,
+    exit_side[2*t+d] is the side track t leaves through in direction d
+    (0 backward, 1 forward), and link[2*t+d] holds the directed tracks
+    entered next across a reflecting and a periodic side (or -1).
+    """
+
+    def __init__(self, filename) :
+        # Files are written in the writer's byte order.
+        for order in ("<", ">") :
+            h = np.fromfile(filename, dtype=_HEADER.newbyteorder(order), count=1)
+            if len(h) == 0 or h["magic"][0] != _MAGIC.rstrip(b"\0") :
+                raise IOError(filename + " is not a track file")
+            if h["byte_order"][0] == 0x01020304 :
+                break
+        else :
+            raise IOError(filename + " has an unknown byte order")
+        h = h[0]
+        self.version         = int(h["version"])
+        self.key             = int(h["key"])
+        self.dimension       = int(h["dimension"])
+        self.number_azimuths = int(h["number_azimuths"])
+        self.number_polar    = int(h["number_polar"])
+        self.number_tracks   = int(h["number_tracks"])
+        self.number_segments = int(h["number_segments"])
+        self.linked          = int(h["linked"]) == 1
+        offset_type = order + "u%i" % int(h["offset_bytes"])
+        nl = self.number_tracks if self.linked else 0
+        counts = [self.number_azimuths * self.number_polar + 1,
+                  self.number_tracks + 1,
+                  self.number_tracks,
+                  self.number_segments,
+                  self.number_segments,
+                  2 * nl,
+                  4 * nl]
+        types  = [offset_type, offset_type, order + "f8",
+                  order + "i4", order + "f8", order + "i4", order + "i4"]
+        arrays = []
+        for i in range(7) :
+            if counts[i] == 0 :
+                arrays.append(np.zeros(0, dtype=types[i]))
+            else :
+                arrays.append(np.memmap(filename, dtype=types[i], mode="r",
+                                        offset=int(h["offset"][i]),
+                                        shape=(counts[i],)))
+        self.angle_offset, self.track_offset, self.track_width, \
+          self.segment_region, self.segment_length, self.exit_side, \
+          self.link = arrays
+        self.link = self.link.reshape((2 * nl, 2))
+
+    def first_track(self, a, p = 0) :
+        """ Flat index of the first track of angle (a, p).
+        """
+        return int(self.angle_offset[a * self.number_polar + p])
+
+    def number_tracks_angle(self, a, p = 0) :
+        """ Number of tracks of angle (a, p).
+        """
+        i = a * self.number_polar + p
+        return int(self.angle_offset[i + 1] - self.angle_offset[i])
+
+    def segments(self, t) :
+        """ Regions and lengths of the segments of flat track t.
+        """
+        b, e = self.track_offset[t], self.track_offset[t + 1]
+        return self.segment_region[b:e], self.segment_length[b:e]
+
+def read_track_file(filename) :
+    """ Read a track file written by the tracker (see tracker_track_file).
+    """
+    return TrackFile(filename)
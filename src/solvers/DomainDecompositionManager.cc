@@ -0,0 +1,489 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  DomainDecompositionManager.cc
+ *  @brief DomainDecompositionManager member definitions
+ *  @note  Copyright(C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "DomainDecompositionManager.hh"
+#include "boundary/BoundarySN.hh"
+#include "boundary/BoundaryTraits.hh"
+#include "boundary/FixedBoundary.hh"
+#include "external_source/SubdomainSource.hh"
+#include "utilities/Comm.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace detran
+{
+
+using detran_utilities::Comm;
+
+//----------------------------------------------------------------------------//
+template <class D>
+DomainDecompositionManager<D>::DomainDecompositionManager(int         argc,
+                                                          char       *argv[],
+                                                          SP_input    input,
+                                                          SP_material material,
+                                                          SP_mesh     mesh)
+  : TransportManager(argc, argv)
+  , d_input(input)
+  , d_material(material)
+  , d_mesh(mesh)
+  , d_tolerance(1.0e-6)
+  , d_maximum_iterations(1000)
+  , d_print_level(2)
+  , d_print_interval(10)
+  , d_number_iterations(0)
+  , d_is_setup(false)
+  , d_is_ready(false)
+{
+  Require(d_input);
+  Require(d_material);
+  Require(d_mesh);
+  Insist(d_mesh->dimension() == D::dimension,
+         "Solver dimension != and mesh dimension.");
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+DomainDecompositionManager<D>::DomainDecompositionManager(SP_input    input,
+                                                          SP_material material,
+                                                          SP_mesh     mesh)
+  : d_input(input)
+  , d_material(material)
+  , d_mesh(mesh)
+  , d_tolerance(1.0e-6)
+  , d_maximum_iterations(1000)
+  , d_print_level(2)
+  , d_print_interval(10)
+  , d_number_iterations(0)
+  , d_is_setup(false)
+  , d_is_ready(false)
+{
+  Require(d_input);
+  Require(d_material);
+  Require(d_mesh);
+  Insist(d_mesh->dimension() == D::dimension,
+         "Solver dimension != and mesh dimension.");
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+void DomainDecompositionManager<D>::setup()
+{
+  using detran_geometry::Mesh;
+  using detran_geometry::MeshPartitioner;
+  using detran_utilities::InputDB;
+
+  if (d_input->check("dd_tolerance"))
+    d_tolerance = d_input->template get<double>("dd_tolerance");
+  if (d_input->check("dd_max_iters"))
+    d_maximum_iterations = d_input->template get<int>("dd_max_iters");
+  if (d_input->check("dd_print_level"))
+    d_print_level = d_input->template get<int>("dd_print_level");
+  if (d_input->check("dd_print_interval"))
+    d_print_interval = d_input->template get<int>("dd_print_interval");
+  Insist(!d_input->check("problem_type") ||
+         d_input->template get<std::string>("problem_type") != "eigenvalue",
+         "Domain decomposition is implemented only for fixed source problems.");
+
+  //--------------------------------------------------------------------------//
+  // PARTITION
+  //--------------------------------------------------------------------------//
+
+  const char *part_names[] = {"dd_number_x", "dd_number_y", "dd_number_z"};
+  vec_int parts(3, 1);
+  size_t number_subdomains = 1;
+  for (size_t d = 0; d < D::dimension; ++d)
+  {
+    if (d_input->check(part_names[d]))
+      parts[d] = d_input->template get<int>(part_names[d]);
+    Insist(parts[d] > 0, "Each dimension needs at least one subdomain.");
+    number_subdomains *= parts[d];
+  }
+
+  // Contiguous blocks of subdomains go to each process, which keeps
+  // most neighbors on the same process for the x-fastest numbering.
+  size_t number_processes  = Comm::size();
+  Insist(number_subdomains >= number_processes,
+         "Every process needs at least one subdomain.");
+  d_owner.resize(number_subdomains);
+  d_local.clear();
+  d_local_index.assign(number_subdomains, -1);
+  for (size_t s = 0; s < number_subdomains; ++s)
+  {
+    d_owner[s] = (s * number_processes) / number_subdomains;
+    if (d_owner[s] == Comm::rank())
+    {
+      d_local_index[s] = d_local.size();
+      d_local.push_back(s);
+    }
+  }
+
+  // Only the meshes of the local subdomains are built.
+  d_partitioner = MeshPartitioner::Create(d_mesh, parts, d_local);
+
+  //--------------------------------------------------------------------------//
+  // SUBDOMAIN PROBLEMS
+  //--------------------------------------------------------------------------//
+
+  const char *bc_names[] =
+    {"bc_west", "bc_east", "bc_south", "bc_north", "bc_bottom", "bc_top"};
+  d_managers.resize(d_local.size());
+  for (size_t l = 0; l < d_local.size(); ++l)
+  {
+    size_t s = d_local[l];
+    SP_input db(new InputDB(*d_input));
+    for (size_t side = 0; side < 2 * D::dimension; ++side)
+    {
+      if (d_partitioner->neighbor(s, side) >= 0)
+        db->template put<std::string>(bc_names[side], "fixed");
+    }
+    d_managers[l] = new Manager_T(db, d_material, d_partitioner->mesh(s));
+    d_managers[l]->setup();
+    Insist(d_managers[l]->discretization() == Manager_T::SN,
+           "Domain decomposition is implemented only for SN.");
+  }
+
+  d_state = SP_state(0);
+  d_is_setup = true;
+  d_is_ready = false;
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+void DomainDecompositionManager<D>::set_source(SP_source q)
+{
+  using detran_external_source::SubdomainSource;
+  Insist(d_is_setup, "The manager must be setup before adding a source.");
+  Require(q);
+
+  for (size_t l = 0; l < d_managers.size(); ++l)
+  {
+    size_t s = d_local[l];
+    SP_source q_local = SubdomainSource::Create(q,
+                                                d_partitioner->mesh(s),
+                                                d_partitioner->global_cells(s),
+                                                d_managers[l]->quadrature());
+    d_managers[l]->set_source(q_local);
+  }
+  d_is_ready = false;
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+bool DomainDecompositionManager<D>::set_solver()
+{
+  if (!d_is_setup)
+  {
+    std::cout << "You must setup the manager before setting the solver."
+              << std::endl;
+    return false;
+  }
+  d_is_ready = true;
+  for (size_t l = 0; l < d_managers.size(); ++l)
+    d_is_ready = d_managers[l]->set_solver() && d_is_ready;
+  return d_is_ready;
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+bool DomainDecompositionManager<D>::solve(const double keff)
+{
+  if (!d_is_ready)
+  {
+    std::cout << "You must set the solver before solving.  Skipping solve."
+              << std::endl;
+    return false;
+  }
+
+  double error = 0.0;
+  int iteration = 0;
+  for (; iteration < d_maximum_iterations; ++iteration)
+  {
+    // Solve every local subdomain with the lagged incident fluxes
+    double norm_delta = 0.0;
+    double norm_phi   = 0.0;
+    for (size_t l = 0; l < d_managers.size(); ++l)
+    {
+      SP_state state = d_managers[l]->state();
+      State::group_moments_type phi_old = state->all_phi();
+      d_managers[l]->solve(keff);
+      for (size_t g = 0; g < phi_old.size(); ++g)
+      {
+        const State::moments_type &phi = state->phi(g);
+        for (size_t i = 0; i < phi.size(); ++i)
+        {
+          norm_delta = std::max(norm_delta, std::abs(phi[i] - phi_old[g][i]));
+          norm_phi   = std::max(norm_phi, std::abs(phi[i]));
+        }
+      }
+    }
+    norm_delta = Comm::global_max(norm_delta);
+    norm_phi   = Comm::global_max(norm_phi);
+    error = norm_phi > 0.0 ? norm_delta / norm_phi : norm_delta;
+
+    // Pass the new outgoing fluxes to the neighbors
+    exchange();
+
+    if (d_print_level > 1 && Comm::is_master() &&
+        iteration % d_print_interval == 0)
+    {
+      printf("  DD Iter: %3i  Error: %12.9f \n", iteration, error);
+    }
+    if (error < d_tolerance) break;
+  }
+  d_number_iterations = std::min(iteration + 1, d_maximum_iterations);
+
+  if (d_print_level > 0 && Comm::is_master())
+  {
+    printf("  DD Final: Number Iters: %3i  Error: %12.9f  Subdomains: %3i \n",
+           d_number_iterations, error,
+           (int)d_partitioner->number_subdomains());
+  }
+  if (error >= d_tolerance && Comm::is_master())
+  {
+    printf("  *** DD did not converge within the maximum number "
+           "of iterations.\n");
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+typename DomainDecompositionManager<D>::SP_state
+DomainDecompositionManager<D>::state()
+{
+  Insist(d_is_setup, "The manager must be setup before gathering the state.");
+
+  // Every other process sends the moments of each of its subdomains to
+  // the master as one message, tagged by subdomain, with the groups in
+  // order.
+  size_t number_groups = d_material->number_groups();
+  vec_int  send_rank, send_tag, recv_rank, recv_tag, recv_subdomains;
+  vec2_dbl send, recv;
+  if (!Comm::is_master())
+  {
+    for (size_t l = 0; l < d_managers.size(); ++l)
+    {
+      send.push_back(vec_dbl());
+      for (size_t g = 0; g < number_groups; ++g)
+      {
+        const State::moments_type &phi_l = d_managers[l]->state()->phi(g);
+        send.back().insert(send.back().end(), phi_l.begin(), phi_l.end());
+      }
+      send_rank.push_back(0);
+      send_tag.push_back(d_local[l]);
+    }
+    Comm::exchange(send_rank, send_tag, send, recv_rank, recv_tag, recv);
+    return SP_state(0);
+  }
+
+  // The master builds the global state once.  Angular fluxes are never
+  // gathered, so none are stored.
+  if (!d_state)
+  {
+    SP_input db(new detran_utilities::InputDB(*d_input));
+    db->template put<int>("store_angular_flux", 0);
+    d_state = new State(db, d_mesh, d_managers[0]->quadrature());
+  }
+  size_t number_cells   = d_mesh->number_cells();
+  size_t number_moments = d_state->phi(0).size() / number_cells;
+
+  for (size_t s = 0; s < d_owner.size(); ++s)
+  {
+    if (d_owner[s] == Comm::rank()) continue;
+    recv.push_back(vec_dbl(number_groups * number_moments *
+                           d_partitioner->number_cells(s), 0.0));
+    recv_rank.push_back(d_owner[s]);
+    recv_tag.push_back(s);
+    recv_subdomains.push_back(s);
+  }
+  Comm::exchange(send_rank, send_tag, send, recv_rank, recv_tag, recv);
+
+  // Place the local and received subdomain moments.
+  for (size_t l = 0; l < d_managers.size(); ++l)
+  {
+    vec_dbl phi_l;
+    for (size_t g = 0; g < number_groups; ++g)
+    {
+      const State::moments_type &phi_g = d_managers[l]->state()->phi(g);
+      phi_l.insert(phi_l.end(), phi_g.begin(), phi_g.end());
+    }
+    recv.push_back(phi_l);
+    recv_subdomains.push_back(d_local[l]);
+  }
+  for (size_t r = 0; r < recv.size(); ++r)
+  {
+    vec_int cells = d_partitioner->global_cells(recv_subdomains[r]);
+    size_t k = 0;
+    for (size_t g = 0; g < number_groups; ++g)
+    {
+      State::moments_type &phi = d_state->phi(g);
+      for (size_t m = 0; m < number_moments; ++m)
+        for (size_t c = 0; c < cells.size(); ++c)
+          phi[m * number_cells + cells[c]] = recv[r][k++];
+    }
+    Assert(k == recv[r].size());
+  }
+  return d_state;
+}
+
+//----------------------------------------------------------------------------//
+// IMPLEMENTATION
+//----------------------------------------------------------------------------//
+
+namespace
+{
+
+// Dimensions spanning the face on each side
+const int face_dims[3][2] = {{1, 2}, {0, 2}, {0, 1}};
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------//
+template <class D>
+typename DomainDecompositionManager<D>::size_t
+DomainDecompositionManager<D>::message_size(const size_t l, const size_t side)
+{
+  SP_mesh mesh = d_managers[l]->mesh();
+  const int *dims = face_dims[side / 2];
+  return d_managers[l]->quadrature()->incident_octant(side).size() *
+         d_managers[l]->quadrature()->number_angles_octant() *
+         d_material->number_groups() *
+         mesh->number_cells(dims[0]) *
+         mesh->number_cells(dims[1]);
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+void DomainDecompositionManager<D>::pack(const size_t  l,
+                                         const size_t  side,
+                                         vec_dbl      &buffer)
+{
+  typedef BoundarySN<D>                     BoundarySN_T;
+  typedef detran_utilities::SP<BoundarySN_T> SP_boundarysn;
+  typedef BoundaryValue<D>                  BV;
+
+  SP_boundarysn boundary(d_managers[l]->boundary());
+  Assert(boundary);
+  SP_mesh mesh = d_managers[l]->mesh();
+  const int *dims = face_dims[side / 2];
+
+  // The directions leaving through this side enter the neighbor through
+  // the opposite side, and they are ordered as the neighbor expects.
+  const vec_int &octants =
+    d_managers[l]->quadrature()->incident_octant(side ^ 1);
+  size_t number_angles = d_managers[l]->quadrature()->number_angles_octant();
+
+  buffer.resize(message_size(l, side));
+  size_t k = 0;
+  for (size_t g = 0; g < d_material->number_groups(); ++g)
+    for (size_t io = 0; io < octants.size(); ++io)
+      for (size_t a = 0; a < number_angles; ++a)
+        for (size_t j = 0; j < mesh->number_cells(dims[1]); ++j)
+          for (size_t i = 0; i < mesh->number_cells(dims[0]); ++i)
+            buffer[k++] = BV::value((*boundary)(side, octants[io], a, g), i, j);
+  Ensure(k == buffer.size());
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+void DomainDecompositionManager<D>::unpack(const size_t   l,
+                                           const size_t   side,
+                                           const vec_dbl &buffer)
+{
+  typedef BoundarySN<D>                         BoundarySN_T;
+  typedef detran_utilities::SP<BoundarySN_T>     SP_boundarysn;
+  typedef detran_utilities::SP<FixedBoundary<D> > SP_fixed;
+  typedef BoundaryValue<D>                      BV;
+
+  SP_boundarysn boundary(d_managers[l]->boundary());
+  Assert(boundary);
+  SP_fixed bc(boundary->bc(side));
+  Assert(bc);
+  SP_mesh mesh = d_managers[l]->mesh();
+  const int *dims = face_dims[side / 2];
+
+  size_t number_octants = d_managers[l]->quadrature()->incident_octant(side).size();
+  size_t number_angles  = d_managers[l]->quadrature()->number_angles_octant();
+
+  Require(buffer.size() == message_size(l, side));
+  size_t k = 0;
+  for (size_t g = 0; g < d_material->number_groups(); ++g)
+    for (size_t io = 0; io < number_octants; ++io)
+      for (size_t a = 0; a < number_angles; ++a)
+        for (size_t j = 0; j < mesh->number_cells(dims[1]); ++j)
+          for (size_t i = 0; i < mesh->number_cells(dims[0]); ++i)
+            BV::value((*bc)(io, a, g), i, j) = buffer[k++];
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+void DomainDecompositionManager<D>::exchange()
+{
+  // Pack everything before unpacking anything, so that every subdomain
+  // sees its neighbors' fluxes from the same iteration.
+  vec2_dbl local_buffers;
+  vec_int  local_targets, local_sides;
+  vec2_dbl send, recv;
+  vec_int  send_rank, send_tag, recv_rank, recv_tag;
+  vec_int  recv_targets, recv_sides;
+  for (size_t l = 0; l < d_local.size(); ++l)
+  {
+    size_t s = d_local[l];
+    for (size_t side = 0; side < 2 * D::dimension; ++side)
+    {
+      int n = d_partitioner->neighbor(s, side);
+      if (n < 0) continue;
+      size_t n_side = side ^ 1;
+      vec_dbl buffer;
+      pack(l, side, buffer);
+      if (d_local_index[n] >= 0)
+      {
+        local_buffers.push_back(buffer);
+        local_targets.push_back(d_local_index[n]);
+        local_sides.push_back(n_side);
+      }
+      else
+      {
+        // Messages are tagged by their receiving subdomain and side.
+        send.push_back(buffer);
+        send_rank.push_back(d_owner[n]);
+        send_tag.push_back(2 * D::dimension * n + n_side);
+        recv.push_back(vec_dbl(message_size(l, side), 0.0));
+        recv_rank.push_back(d_owner[n]);
+        recv_tag.push_back(2 * D::dimension * s + side);
+        recv_targets.push_back(l);
+        recv_sides.push_back(side);
+      }
+    }
+  }
+  Comm::exchange(send_rank, send_tag, send, recv_rank, recv_tag, recv);
+  for (size_t i = 0; i < local_buffers.size(); ++i)
+    unpack(local_targets[i], local_sides[i], local_buffers[i]);
+  for (size_t i = 0; i < recv.size(); ++i)
+    unpack(recv_targets[i], recv_sides[i], recv[i]);
+}
+
+//----------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//----------------------------------------------------------------------------//
+
+SOLVERS_INSTANTIATE_EXPORT(DomainDecompositionManager<_1D>)
+SOLVERS_INSTANTIATE_EXPORT(DomainDecompositionManager<_2D>)
+SOLVERS_INSTANTIATE_EXPORT(DomainDecompositionManager<_3D>)
+SOLVERS_TEMPLATE_EXPORT(detran_utilities::SP<DomainDecompositionManager<_1D> >)
+SOLVERS_TEMPLATE_EXPORT(detran_utilities::SP<DomainDecompositionManager<_2D> >)
+SOLVERS_TEMPLATE_EXPORT(detran_utilities::SP<DomainDecompositionManager<_3D> >)
+
+} // end namespace detran
+
+//----------------------------------------------------------------------------//
+//              end of file DomainDecompositionManager.cc
+//----------------------------------------------------------------------------//
@@ -0,0 +1,217 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  DomainDecompositionManager.hh
+ *  @brief DomainDecompositionManager class definition
+ *  @note  Copyright(C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_DOMAINDECOMPOSITIONMANAGER_HH_
+#define detran_DOMAINDECOMPOSITIONMANAGER_HH_
+
+#include "solvers/solvers_export.hh"
+#include "FixedSourceManager.hh"
+#include "geometry/MeshPartitioner.hh"
+
+namespace detran
+{
+
+/**
+ *  @class DomainDecompositionManager
+ *  @brief Solve a fixed source problem by spatial domain decomposition
+ *
+ *  The mesh is partitioned into a logical grid of subdomains, and the
+ *  subdomains are distributed over the processes in contiguous blocks.
+ *  Each subdomain is an ordinary SN fixed source problem whose sides
+ *  interior to the global mesh are fixed boundaries.  The problem is
+ *  solved by block Jacobi iteration on the interface angular fluxes:
+ *  every subdomain is solved with the incident fluxes of the previous
+ *  iteration, and then the outgoing fluxes of every subdomain become
+ *  the incident fluxes of its neighbors.  Neighbors on the same process
+ *  are exchanged by copy and all others by MPI.  Iteration stops when
+ *  the largest relative change in the scalar flux of any subdomain,
+ *  reduced over all processes, falls below the tolerance.
+ *
+ *  Each process builds the meshes, states, and solvers of its own
+ *  subdomains only.  The global mesh is needed on every process only as
+ *  the description being partitioned.  The local subdomain states are
+ *  the distributed solution; state() gathers the scalar flux onto the
+ *  master process.
+ *
+ *  Without MPI, all subdomains live on one process, which is useful
+ *  for testing and for bounding the memory of each subdomain solve.
+ *
+ *  Only fixed source problems are decomposed.  Eigenvalue problems would
+ *  need the Krylov and eigenvalue reductions distributed over the
+ *  subdomains, which is not done, so they are rejected at setup.
+ *
+ *  Relevant database entries:
+ *    - dd_number_x, dd_number_y, dd_number_z [int] subdomains per
+ *      dimension (default 1)
+ *    - dd_tolerance [double] (default 1e-6)
+ *    - dd_max_iters [int] (default 1000)
+ *    - dd_print_level, dd_print_interval [int] (default 2, 10)
+ *
+ *  All other entries are passed to each subdomain's manager.
+ */
+template <class D>
+class DomainDecompositionManager: TransportManager
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<DomainDecompositionManager<D> >  SP_manager;
+  typedef FixedSourceManager<D>                                 Manager_T;
+  typedef typename Manager_T::SP_manager                        SP_submanager;
+  typedef typename Manager_T::SP_input                          SP_input;
+  typedef typename Manager_T::SP_material                       SP_material;
+  typedef typename Manager_T::SP_mesh                           SP_mesh;
+  typedef typename Manager_T::SP_state                          SP_state;
+  typedef typename Manager_T::SP_source                         SP_source;
+  typedef detran_geometry::MeshPartitioner::SP_partitioner      SP_partitioner;
+  typedef detran_utilities::vec_int                             vec_int;
+  typedef detran_utilities::vec_dbl                             vec_dbl;
+  typedef detran_utilities::vec2_dbl                            vec2_dbl;
+  typedef detran_utilities::size_t                              size_t;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param argc       command line count
+   *  @param argv       command line values
+   *  @param input      parameter database
+   *  @param material   material database
+   *  @param mesh       global mesh definition
+   */
+  DomainDecompositionManager(int         argc,
+                             char       *argv[],
+                             SP_input    input,
+                             SP_material material,
+                             SP_mesh     mesh);
+
+  /// Constructor (without command line)
+  DomainDecompositionManager(SP_input    input,
+                             SP_material material,
+                             SP_mesh     mesh);
+
+  /// Virtual destructor
+  virtual ~DomainDecompositionManager(){}
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /// Partition the mesh and set up the local subdomain problems
+  void setup();
+
+  /// Add an external source defined on the global mesh
+  void set_source(SP_source q);
+
+  /// Set the subdomain solvers based on the parameter database
+  bool set_solver();
+
+  /**
+   *  @brief Solve the system
+   *  @param keff   Scaling factor for multiplying problems
+   */
+  bool solve(const double keff = 1.0);
+
+  /**
+   *  @brief Gather the scalar flux moments onto the global mesh
+   *
+   *  This is collective.  Only the master process builds and receives
+   *  the global state, which holds no angular flux; every other process
+   *  gets a null state.  The local subdomain states are available on
+   *  every process through manager(l)->state().
+   */
+  SP_state state();
+
+  /// @name Getters
+  /// @{
+  SP_partitioner partitioner() const { return d_partitioner; }
+  size_t number_local_subdomains() const { return d_managers.size(); }
+  /// Manager for a local subdomain
+  SP_submanager manager(const size_t l) const
+  {
+    Require(l < d_managers.size());
+    return d_managers[l];
+  }
+  /// Global index of a local subdomain
+  size_t subdomain(const size_t l) const
+  {
+    Require(l < d_local.size());
+    return d_local[l];
+  }
+  /// Process owning a subdomain
+  int owner(const size_t s) const
+  {
+    Require(s < d_owner.size());
+    return d_owner[s];
+  }
+  int number_iterations() const { return d_number_iterations; }
+  /// @}
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Parameter database
+  SP_input d_input;
+  /// Material database
+  SP_material d_material;
+  /// Global mesh
+  SP_mesh d_mesh;
+  /// Partition of the global mesh
+  SP_partitioner d_partitioner;
+  /// Owning process of each subdomain
+  vec_int d_owner;
+  /// Subdomains on this process
+  vec_int d_local;
+  /// Local index of each subdomain, or -1 if not on this process
+  vec_int d_local_index;
+  /// Managers for the local subdomains
+  std::vector<SP_submanager> d_managers;
+  /// Global state, built on the master process when first gathered
+  SP_state d_state;
+  /// Parameters
+  double d_tolerance;
+  int d_maximum_iterations;
+  int d_print_level;
+  int d_print_interval;
+  /// Iterations in the last solve
+  int d_number_iterations;
+  /// Flags
+  bool d_is_setup;
+  bool d_is_ready;
+
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  /// Number of values exchanged across a side of a local subdomain
+  size_t message_size(const size_t l, const size_t side);
+  /// Pack the outgoing fluxes of a local subdomain on a side
+  void pack(const size_t l, const size_t side, vec_dbl &buffer);
+  /// Unpack incident fluxes into the fixed boundary of a local subdomain
+  void unpack(const size_t l, const size_t side, const vec_dbl &buffer);
+  /// Exchange interface fluxes between all neighbors
+  void exchange();
+
+};
+
+} // end namespace detran
+
+#endif /* detran_DOMAINDECOMPOSITIONMANAGER_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of file DomainDecompositionManager.hh
+//----------------------------------------------------------------------------//
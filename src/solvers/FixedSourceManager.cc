@@ -15,6 +15,7 @@
 #include "geometry/Tracker.hh"
 // Multigroup solvers
 #include "MGSolverGS.hh"
+#include "MGSolverJacobi.hh"
 #include "MGDiffusionSolver.hh"
 #include "MGSolverGMRES.hh"
 #include "MGSolverCMFD.hh"
@@ -106,12 +107,12 @@ void FixedSourceManager<D>::setup()
     if (d_discretization == MOC)
     {
       // Track the mesh
-      detran_geometry::Tracker tracker(d_mesh, d_quadrature);
+      detran_geometry::Tracker tracker(d_input, d_quadrature);
+      tracker.trackit(d_mesh);
       // Normalize segments to conserve volume.
       tracker.normalize();
-      // Replace the mesh with the tracked one.  This suggests refactoring
-      // to have a (possibly null) trackdb in Mesh.
-      //d_mesh = tracker.meshmoc();
+      // The sweeper and boundary find the tracks on the mesh.
+      d_mesh->set_tracks(tracker.trackdb());
     }
   }
 
@@ -200,6 +201,12 @@ bool FixedSourceManager<D>::set_solver()
       d_solver = new MGSolverGS<D>(d_state, d_material, d_boundary,
                                    d_sources, d_fissionsource, d_multiply);
     }
+    else if (outer_solver == "Jacobi")
+    {
+      d_solver = new MGSolverJacobi<D>(d_state, d_material, d_boundary,
+                                       d_sources, d_fissionsource,
+                                       d_multiply);
+    }
     else if (outer_solver == "CMFD")
     {
       d_solver = new MGSolverCMFD<D>(d_state, d_material, d_boundary,
@@ -239,6 +246,41 @@ bool FixedSourceManager<D>::solve(const double keff)
   return true;
 }
 
+//----------------------------------------------------------------------------//
+template <class D>
+typename FixedSourceManager<D>::vec_state
+FixedSourceManager<D>::solve_batch(const vec_source &sources,
+                                   const double      keff)
+{
+  Insist(d_is_setup, "The manager must be setup before a batch solve.");
+  Require(!sources.empty());
+
+  using detran_external_source::BatchSource;
+
+  // Replace the current sources with the batch and build one solver
+  vec_source saved_sources = d_sources;
+  SP_batchsource batch = BatchSource::Create(sources, d_mesh, d_quadrature);
+  d_sources.assign(1, SP_source(batch));
+  bool ready = set_solver();
+  d_sources = saved_sources;
+  Insist(ready, "The batch solver could not be built.");
+
+  vec_state states(sources.size());
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    batch->select(i);
+    d_state->clear();
+    d_boundary->clear();
+    d_solver->solve(keff);
+    states[i] = new State(*d_state);
+  }
+
+  // The solver still points to the batch
+  d_is_ready = false;
+
+  return states;
+}
+
 //----------------------------------------------------------------------------//
 template <class D>
 double FixedSourceManager<D>::iterate(const int generation)
@@ -13,6 +13,7 @@
 #include "TransportManager.hh"
 #include "solvers/mg/MGSolver.hh"
 #include "angle/Quadrature.hh"
+#include "external_source/BatchSource.hh"
 
 namespace detran
 {
@@ -58,6 +59,7 @@ public:
   typedef detran_utilities::SP<FixedSourceManager<D> >  SP_manager;
   typedef detran_utilities::InputDB::SP_input           SP_input;
   typedef State::SP_state                               SP_state;
+  typedef std::vector<SP_state>                         vec_state;
   typedef detran_geometry::Mesh::SP_mesh                SP_mesh;
   typedef detran_material::Material::SP_material        SP_material;
   typedef detran_angle::Quadrature::SP_quadrature       SP_quadrature;
@@ -67,6 +69,8 @@ public:
           ExternalSource::SP_externalsource             SP_source;
   typedef detran_external_source::
           ExternalSource::vec_externalsource            vec_source;
+  typedef detran_external_source::
+          BatchSource::SP_batchsource                   SP_batchsource;
   typedef FissionSource::SP_fissionsource               SP_fissionsource;
   typedef State::moments_type                           moments_type;
   typedef typename MGSolver<D>::SP_solver               SP_solver;
@@ -145,6 +149,28 @@ public:
    */
   bool solve(const double keff = 1.0);
 
+  /**
+   *  @brief Convenience solve of one problem for several external sources
+   *
+   *  The sources are wrapped in a single batch source, and one solver
+   *  is built for all of them, so that the operators and preconditioners
+   *  built by the solver are reused for every source.  This is not a
+   *  block solve: the sources are solved one after another, each
+   *  starting from a zero state and boundary, and every sweep and
+   *  Krylov iteration carries only one right hand side.
+   *
+   *  Sources added with set_source are not included, and they are
+   *  restored afterward.  Because the batch solver replaces the one
+   *  built by set_solver, set_solver must be called again before the
+   *  next call to solve.  The manager's state holds the solution for
+   *  the last source.
+   *
+   *  @param sources  External sources, one per problem
+   *  @param keff     Scaling factor for multiplying problems
+   *  @return         One state per source
+   */
+  vec_state solve_batch(const vec_source &sources, const double keff = 1.0);
+
   /**
    *  @brief Perform a fission iteration
    *
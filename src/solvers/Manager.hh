@@ -11,6 +11,7 @@
 
 #include "detran_config.hh"
 #include "utilities/Profiler.hh"
+#include "utilities/Comm.hh"
 #include "callow/utils/Initialization.hh"
 #include <iostream>
 
@@ -30,10 +31,11 @@ class Manager
 
 public:
 
-  /// Initialize libraries (PETSc/SLEPc through callow)
+  /// Initialize libraries (MPI, then PETSc/SLEPc through callow)
   static void initialize(int argc, char *argv[])
   {
     START_PROFILER();
+    detran_utilities::Comm::initialize(argc, argv);
     callow_initialize(argc, argv);
   }
 
@@ -41,6 +43,7 @@ public:
   static void finalize()
   {
     callow_finalize();
+    detran_utilities::Comm::finalize();
     STOP_PROFILER();
   }
 
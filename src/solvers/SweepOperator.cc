@@ -33,15 +33,9 @@ SweepOperator<D>::SweepOperator(SP_state        state,
   // Determine the sizes of the moments.
   d_moments_size = d_state->moments_size();
 
-  // Determine the sizes of any reflected boundary fluxes.
-  for (int side = 0; side < 2*D::dimension; side++)
-  {
-    if (boundary->is_reflective(side))
-    {
-      // We only need to store only half of the unknowns.
-      d_boundary_size += boundary->boundary_flux_size(side)/2;
-    }
-  }
+  // Determine the size of any reflected boundary fluxes.  We only need
+  // to store the incident half.
+  d_boundary_size = boundary->reflective_flux_size();
 
   // Set the operator size
   set_size(d_moments_size + d_boundary_size);
@@ -12,6 +12,7 @@
 
 #include "solvers/solvers_export.hh"
 #include "callow/utils/Initialization.hh"
+#include "utilities/Comm.hh"
 
 namespace detran
 {
@@ -43,6 +44,7 @@ public:
   TransportManager(int argc, char *argv[])
     : d_flag(true)
   {
+    detran_utilities::Comm::initialize(argc, argv);
     callow_initialize(argc, argv);
   }
 
@@ -56,7 +58,11 @@ public:
   /// Destructor.  This initializes all external libraries.
   virtual ~TransportManager()
   {
-    if (d_flag) callow_finalize();
+    if (d_flag)
+    {
+      callow_finalize();
+      detran_utilities::Comm::finalize();
+    }
   }
 
 private:
@@ -77,16 +77,19 @@ void MGDSA::apply(Vector &V, Vector &V_out)
   //--------------------------------------------------------------------------//
 
   Vector S_V(size_moments * d_number_active_groups, 0.0);
+  State::vec_moments_type
+    source(d_number_groups, State::moments_type(size_moments, 0.0));
+  // Add scatter
+  d_scattersource->build_total_source
+    (detran_utilities::range<size_t>(d_group_cutoff, d_number_groups),
+     d_group_cutoff, phi, source);
   for (int g = d_group_cutoff; g < d_number_groups; g++)
   {
-    State::moments_type source(size_moments, 0.0);
-    // Add scatter
-    d_scattersource->build_total_group_source(g, d_group_cutoff, phi, source);
     // Add fission
     if (d_include_fission)
-      d_fissionsource->build_total_group_source(g, phi, source);
+      d_fissionsource->build_total_group_source(g, phi, source[g]);
     for (int i = 0; i < size_moments; i++)
-      S_V[(g - d_group_cutoff) * size_moments + i] = source[i];
+      S_V[(g - d_group_cutoff) * size_moments + i] = source[g][i];
   }
 
   //--------------------------------------------------------------------------//
@@ -73,18 +73,19 @@ void MGScatterFissionOperator::multiply(const Vector &V,  Vector &V_out)
       phi[*g][i] = V[(*g - d_group_cutoff) * size_moments + i];
 
   // Construct the action of the scattering and/or fission operators
+  State::vec_moments_type source(d_number_groups,
+      State::moments_type(size_moments, 0.0));
+  // Add scatter for all groups in one pass over the cells
+  if (d_include_scatter)
+    d_S->build_total_source(d_groups, d_group_cutoff, phi, source);
   g = d_groups.begin();
   for (; g != d_groups.end(); ++g)
   {
-    State::moments_type source(size_moments, 0.0);
-    // Add scatter
-    if (d_include_scatter)
-      d_S->build_total_group_source(*g, d_group_cutoff, phi, source);
     // Add fission
     if (d_include_fission)
-      d_F->build_total_group_source(*g, phi, source);
+      d_F->build_total_group_source(*g, phi, source[*g]);
     for (int i = 0; i < size_moments; ++i)
-      V_out[(*g - d_group_cutoff) * size_moments + i] = source[i];
+      V_out[(*g - d_group_cutoff) * size_moments + i] = source[*g][i];
   }
 }
 
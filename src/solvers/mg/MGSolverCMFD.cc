@@ -202,24 +202,30 @@ void MGSolverCMFD<D>::update(const double keff)
 template <class D>
 void MGSolverCMFD<D>::compute_current()
 {
+  size_t number_cells = d_mesh->number_cells();
   for (size_t g = 0; g < d_number_groups; ++g)
   {
-    for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+    // Accumulate by angle, since each angular flux is fetched as a whole
+    detran_utilities::vec2_dbl
+      J(3, detran_utilities::vec_dbl(number_cells, 0.0));
+    for (size_t o = 0; o < d_quadrature->number_octants(); ++o)
     {
-      double J[3] = {0.0, 0.0, 0.0};
-      for (size_t o = 0; o < d_quadrature->number_octants(); ++o)
+      for (size_t a = 0; a < d_quadrature->number_angles_octant(); ++a)
       {
-        for (size_t a = 0; a < d_quadrature->number_angles_octant(); ++a)
+        double w = d_quadrature->weight(a);
+        State::angular_flux_type psi = d_state->psi(g, o, a);
+        for (size_t d = 0; d < D::dimension; ++d)
         {
-          double w = d_quadrature->weight(a);
-          double psi = d_state->psi(g, o, a)[i];
-          for (size_t d = 0; d < D::dimension; ++d)
-          {
-            J[d] += w * psi * d_quadrature->cosines(d)[a];
-          }
+          double mu = d_quadrature->cosines(d)[a];
+          for (size_t i = 0; i < number_cells; ++i)
+            J[d][i] += w * psi[i] * mu;
         }
       }
-      d_state->current(g)[i] = std::sqrt(J[0]*J[0] + J[1]*J[1] + J[2]*J[2]);
+    }
+    for (size_t i = 0; i < number_cells; ++i)
+    {
+      d_state->current(g)[i] =
+        std::sqrt(J[0][i]*J[0][i] + J[1][i]*J[1][i] + J[2][i]*J[2][i]);
     }
   }
 }
@@ -0,0 +1,126 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  MGSolverJacobi.cc
+ *  @brief MGSolverJacobi member definitions
+ *  @note  Copyright(C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "detran_config.hh"
+#include "MGSolverJacobi.hh"
+#include <algorithm>
+#include <string>
+
+namespace detran
+{
+
+//----------------------------------------------------------------------------//
+template <class D>
+MGSolverJacobi<D>::MGSolverJacobi(SP_state                  state,
+                                  SP_material               material,
+                                  SP_boundary               boundary,
+                                  const vec_externalsource &q_e,
+                                  SP_fissionsource          q_f,
+                                  bool                      multiply)
+  : Base(state, material, boundary, q_e, q_f, multiply)
+  , d_group_thread(d_number_groups, 0)
+  , d_phi_new(d_number_groups)
+  , d_norm_type("Linf")
+{
+  using detran_utilities::range;
+
+  if (d_input->check("outer_norm_type"))
+    d_norm_type = d_input->template get<std::string>("outer_norm_type");
+
+  // Group bounds, reversed for adjoint problems as in Gauss-Seidel
+  int lower = 0;
+  int lower_upscatter = d_material->upscatter_cutoff(d_adjoint);
+  int upper = d_number_groups;
+  if (d_adjoint)
+  {
+    lower = d_number_groups - 1;
+    upper = -1;
+  }
+  if (d_multiply) lower_upscatter = lower;
+
+  // Only the upscatter block is iterated, and so only it is done by Jacobi
+  if ((!d_downscatter && d_maximum_iterations > 0 && d_number_groups > 1)
+      || d_multiply)
+  {
+    d_gs_groups     = range<int>(lower, lower_upscatter);
+    d_jacobi_groups = range<int>(lower_upscatter, upper);
+  }
+  else
+  {
+    d_gs_groups = range<int>(lower, upper);
+  }
+
+  // One within-group solver and state per thread, but no more threads
+  // than there are groups in the block
+  int number_threads = 1;
+#ifdef DETRAN_ENABLE_OPENMP
+  number_threads = omp_get_max_threads();
+#endif
+  if (d_input->check("outer_number_threads"))
+    number_threads = d_input->template get<int>("outer_number_threads");
+  number_threads = std::min(number_threads, (int)d_jacobi_groups.size());
+  if (!d_jacobi_groups.empty()) number_threads = std::max(number_threads, 1);
+  d_thread_state.resize(number_threads);
+  d_thread_wg_solver.resize(number_threads);
+  for (int t = 0; t < number_threads; ++t)
+  {
+    d_thread_state[t] = new State(*d_state);
+    d_thread_wg_solver[t] = this->build_wg_solver(d_thread_state[t]);
+  }
+
+  Ensure(d_norm_type == "Linf" || d_norm_type == "L1" || d_norm_type == "L2");
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+int MGSolverJacobi<D>::number_sweeps() const
+{
+  int n = d_wg_solver->get_sweeper()->number_sweeps();
+  for (int t = 0; t < d_thread_wg_solver.size(); ++t)
+    n += d_thread_wg_solver[t]->get_sweeper()->number_sweeps();
+  return n;
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+void MGSolverJacobi<D>::scatter_state()
+{
+  for (int t = 0; t < d_thread_state.size(); ++t)
+    for (int g = 0; g < d_number_groups; ++g)
+      d_thread_state[t]->phi(g) = d_state->phi(g);
+}
+
+//----------------------------------------------------------------------------//
+template <class D>
+void MGSolverJacobi<D>::gather_state(const bool angular)
+{
+  for (int i = 0; i < d_jacobi_groups.size(); ++i)
+  {
+    int g = d_jacobi_groups[i];
+    d_state->phi(g) = d_phi_new[g];
+    if (!angular) continue;
+    SP_state s = d_thread_state[d_group_thread[g]];
+    for (int o = 0; o < d_quadrature->number_octants(); ++o)
+      for (int a = 0; a < d_quadrature->number_angles_octant(); ++a)
+        d_state->set_psi(g, o, a, s->psi(g, o, a));
+  }
+}
+
+//----------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//----------------------------------------------------------------------------//
+
+template class MGSolverJacobi<_1D>;
+template class MGSolverJacobi<_2D>;
+template class MGSolverJacobi<_3D>;
+
+} // end namespace detran
+
+//----------------------------------------------------------------------------//
+//              end of MGSolverJacobi.cc
+//----------------------------------------------------------------------------//
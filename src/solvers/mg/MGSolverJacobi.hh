@@ -0,0 +1,178 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  MGSolverJacobi.hh
+ *  @brief MGSolverJacobi class definition
+ *  @note  Copyright(C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_MGSOLVERJACOBI_HH_
+#define detran_MGSOLVERJACOBI_HH_
+
+#include "MGTransportSolver.hh"
+#include <vector>
+
+namespace detran
+{
+
+//----------------------------------------------------------------------------//
+/**
+ *  @class MGSolverJacobi
+ *  @brief Solves the multigroup transport equation via block Jacobi in energy.
+ *
+ *  Groups below the upscatter cutoff are solved once in order, as in
+ *  Gauss-Seidel.  The groups of the upscatter block are then iterated
+ *  with the in-scatter (and in-fission for multiplying problems) lagged
+ *  one iteration, so that all groups of an iteration are independent
+ *  and are solved concurrently by OpenMP threads.
+ *
+ *  Each thread owns a within-group solver built on its own copy of
+ *  the state, and hence its own sweeper, sweep source, and equations.
+ *  The copies always hold the lagged flux: a new group flux is moved
+ *  aside as soon as it is computed and gathered after the iteration,
+ *  so the result does not depend on which thread solves which group.  The boundary is
+ *  shared, since each group touches only its own boundary fluxes.
+ *
+ *  Lagging the in-scatter costs iterations relative to Gauss-Seidel
+ *  but lets many-group problems use one thread per group.  Sweeps
+ *  within a group run on the calling thread unless nested parallelism
+ *  is enabled (e.g. via OMP_MAX_ACTIVE_LEVELS), in which case each group
+ *  gets its own thread team.
+ *
+ *  Relevant db entries:
+ *  - outer_norm_type (str) [default = "Linf"]
+ *  - outer_number_threads (int) [default = all available]
+ */
+/**
+ *  @example solvers/test/test_MGSolverJacobi
+ */
+//----------------------------------------------------------------------------//
+
+template <class D>
+class MGSolverJacobi: public MGTransportSolver<D>
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef MGTransportSolver<D>                      Base;
+  typedef typename Base::SP_solver                  SP_solver;
+  typedef typename Base::SP_wg_solver               SP_wg_solver;
+  typedef typename Base::SP_input                   SP_input;
+  typedef typename Base::SP_state                   SP_state;
+  typedef typename Base::SP_mesh                    SP_mesh;
+  typedef typename Base::SP_material                SP_material;
+  typedef typename Base::SP_quadrature              SP_quadrature;
+  typedef typename Base::SP_boundary                SP_boundary;
+  typedef typename Base::SP_externalsource          SP_externalsource;
+  typedef typename Base::vec_externalsource         vec_externalsource;
+  typedef typename Base::SP_fissionsource           SP_fissionsource;
+  typedef typename Base::size_t                     size_t;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
+  typedef detran_utilities::vec_int                 vec_int;
+  typedef detran_utilities::vec_size_t              vec_size_t;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param state             State vectors, etc.
+   *  @param material          Material definitions.
+   *  @param boundary          Boundary fluxes.
+   *  @param q_e               Vector of user-defined external sources
+   *  @param q_f               Fission source.
+   *  @param multiply          Flag for a multiplying fixed source problem
+   */
+  MGSolverJacobi(SP_state                   state,
+                 SP_material                material,
+                 SP_boundary                boundary,
+                 const vec_externalsource  &q_e,
+                 SP_fissionsource           q_f,
+                 bool                       multiply = false);
+
+  //--------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL MULTIGROUP SOLVERS MUST IMPLEMENT
+  //--------------------------------------------------------------------------//
+
+  /// Solve the multigroup equations.
+  void solve(const double keff = 1.0);
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /// Return number of sweeps, summed over all threads
+  int number_sweeps() const;
+
+  /// Number of threads solving groups concurrently
+  int number_threads() const { return d_thread_wg_solver.size(); }
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  // Expose base members.
+  using Base::d_input;
+  using Base::d_state;
+  using Base::d_mesh;
+  using Base::d_material;
+  using Base::d_quadrature;
+  using Base::d_boundary;
+  using Base::d_externalsources;
+  using Base::d_fissionsource;
+  using Base::d_downscatter;
+  using Base::d_number_groups;
+  using Base::d_maximum_iterations;
+  using Base::d_tolerance;
+  using Base::d_print_level;
+  using Base::d_print_interval;
+  using Base::d_adjoint;
+  using Base::d_wg_solver;
+  using Base::d_multiply;
+
+  /// Groups solved once in order before the Jacobi block
+  vec_int d_gs_groups;
+  /// Groups of the Jacobi block
+  vec_int d_jacobi_groups;
+  /// Per-thread state copies
+  std::vector<SP_state> d_thread_state;
+  /// Per-thread within-group solvers
+  std::vector<SP_wg_solver> d_thread_wg_solver;
+  /// Thread that last solved each group
+  vec_int d_group_thread;
+  /// New group fluxes of the current iteration
+  State::vec_moments_type d_phi_new;
+  /// Determines which norm to use (default is Linf)
+  std::string d_norm_type;
+
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  /// Copy the lagged flux into each thread's state
+  void scatter_state();
+  /// Copy the new group fluxes (and angular fluxes) into the state
+  void gather_state(const bool angular);
+
+};
+
+} // namespace detran
+
+//----------------------------------------------------------------------------//
+// INLINE FUNCTIONS
+//----------------------------------------------------------------------------//
+
+#include "MGSolverJacobi.i.hh"
+
+#endif /* detran_MGSOLVERJACOBI_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of MGSolverJacobi.hh
+//----------------------------------------------------------------------------//
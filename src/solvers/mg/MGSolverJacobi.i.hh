@@ -0,0 +1,115 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  MGSolverJacobi.i.hh
+ *  @brief MGSolverJacobi inline member definitions
+ *  @note  Copyright(C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_MGSOLVERJACOBI_I_HH_
+#define detran_MGSOLVERJACOBI_I_HH_
+
+#include "detran_config.hh"
+#include "utilities/MathUtilities.hh"
+#include "utilities/Warning.hh"
+#include <cstdio>
+#ifdef DETRAN_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace detran
+{
+
+//----------------------------------------------------------------------------//
+template <class D>
+void MGSolverJacobi<D>::solve(const double keff)
+{
+  using detran_utilities::norm;
+  using detran_utilities::norm_residual;
+  using detran_utilities::vec_scale;
+
+  // Norm of the group-wise residuals and the total residual norm
+  vec_dbl nres(d_number_groups, 0.0);
+  double nres_tot = 0;
+
+  // Set the scaling factor for multiplying problems
+  if (d_multiply) d_fissionsource->setup_outer(1.0 / keff);
+
+  // Groups below the upscatter block are solved once, in order.
+  for (int i = 0; i < d_gs_groups.size(); ++i)
+    d_wg_solver->solve(d_gs_groups[i]);
+
+  // Jacobi iterations over the upscatter block.
+  int iteration = 0;
+  int number_groups  = d_jacobi_groups.size();
+  int number_threads = d_thread_wg_solver.size();
+  if (number_groups)
+  {
+    for (iteration = 1; iteration <= d_maximum_iterations; ++iteration)
+    {
+      vec_scale(nres, 0.0);
+
+      // Save current group flux and hand it to each thread.
+      State::group_moments_type phi_old = d_state->all_phi();
+      scatter_state();
+
+      // Each group sees only the lagged flux of all others.
+      #pragma omp parallel for schedule(dynamic, 1) num_threads(number_threads)
+      for (int i = 0; i < number_groups; ++i)
+      {
+        int t = 0;
+#ifdef DETRAN_ENABLE_OPENMP
+        t = omp_get_thread_num();
+#endif
+        int g = d_jacobi_groups[i];
+        d_thread_wg_solver[t]->solve(g);
+        d_group_thread[g] = t;
+        // keep the new flux aside and restore the lagged one, so that
+        // the next group solved by this thread does not see it
+        d_phi_new[g] = d_thread_state[t]->phi(g);
+        d_thread_state[t]->phi(g) = d_state->phi(g);
+      }
+
+      gather_state(false);
+      for (int i = 0; i < number_groups; ++i)
+      {
+        int g = d_jacobi_groups[i];
+        nres[g] = norm_residual(d_state->phi(g), phi_old[g], d_norm_type);
+      }
+      nres_tot = norm(nres, d_norm_type);
+
+      if (d_print_level > 1  && iteration % d_print_interval == 0)
+      {
+        printf("  Jacobi Iter: %3i  Error: %12.9f \n", iteration, nres_tot);
+      }
+      if (nres_tot < d_tolerance) break;
+
+    } // end Jacobi iterations
+
+    // Angular fluxes are only needed from the last iteration.
+    if (d_state->store_angular_flux()) gather_state(true);
+
+    if (nres_tot > d_tolerance)
+    {
+      detran_utilities::warning(detran_utilities::SOLVER_CONVERGENCE,
+        "Jacobi upscatter did not converge.");
+    }
+
+  } // end upscatter block
+
+  // Diagnostic output
+  if (d_print_level > 0)
+  {
+    printf("  Jacobi Final: Number Iters: %3i  Error: %12.9f  Sweeps: %6i \n",
+           iteration, nres_tot, number_sweeps());
+  }
+
+}
+
+} // end namespace detran
+
+#endif /* detran_MGSOLVERJACOBI_I_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of MGSolverJacobi.i.hh
+//----------------------------------------------------------------------------//
@@ -121,6 +121,13 @@ protected:
   /// Inner solver
   SP_wg_solver d_wg_solver;
 
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  /// Build the within-group solver selected by inner_solver for a state
+  SP_wg_solver build_wg_solver(SP_state state);
+
 };
 
 } // namespace detran
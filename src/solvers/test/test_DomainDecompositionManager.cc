@@ -0,0 +1,151 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  test_DomainDecompositionManager.cc
+ *  @brief Test of DomainDecompositionManager
+ *  @note  Copyright(C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                                  \
+        FUNC(test_DomainDecompositionManager_1D)   \
+        FUNC(test_DomainDecompositionManager_2D)
+
+#include "TestDriver.hh"
+#include "DomainDecompositionManager.hh"
+#include "Mesh1D.hh"
+#include "Mesh2D.hh"
+#include "external_source/ConstantSource.hh"
+#include "callow/utils/Initialization.hh"
+#include "utilities/Comm.hh"
+#include <string>
+
+using namespace detran;
+using namespace detran_material;
+using namespace detran_external_source;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace detran_test;
+using std::string;
+
+int main(int argc, char *argv[])
+{
+  // RUN returns immediately, but MPI must be finalized
+  Comm::initialize(argc, argv);
+  callow_initialize(argc, argv);
+  int result = TestDriver::run(argc, argv);
+  callow_finalize();
+  Comm::finalize();
+  return result;
+}
+
+//----------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------------------------------------//
+
+Material::SP_material test_DomainDecompositionManager_material()
+{
+  // A scattering material and a strong absorber
+  Material::SP_material mat = Material::Create(2, 1, "dd");
+  mat->set_sigma_t(0, 0, 1.0);
+  mat->set_sigma_s(0, 0, 0, 0.9);
+  mat->set_sigma_t(1, 0, 2.0);
+  mat->set_sigma_s(1, 0, 0, 0.5);
+  mat->finalize();
+  return mat;
+}
+
+InputDB::SP_input test_DomainDecompositionManager_input()
+{
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",              1);
+  inp->put<string>("equation",                "dd");
+  inp->put<string>("bc_west",                 "reflect");
+  inp->put<string>("bc_south",                "reflect");
+  inp->put<int>("quad_number_polar_octant",   2);
+  inp->put<int>("quad_number_azimuth_octant", 2);
+  inp->put<double>("inner_tolerance",         1e-13);
+  inp->put<int>("inner_max_iters",            10000);
+  inp->put<int>("inner_print_level",          0);
+  inp->put<int>("outer_print_level",          0);
+  inp->put<double>("dd_tolerance",            1e-11);
+  inp->put<int>("store_angular_flux",         1);
+  return inp;
+}
+
+template <class D>
+int test_DomainDecompositionManager_T(Mesh::SP_mesh mesh, const int *parts)
+{
+  Material::SP_material mat = test_DomainDecompositionManager_material();
+
+  // Reference on the undecomposed mesh
+  InputDB::SP_input inp = test_DomainDecompositionManager_input();
+  FixedSourceManager<D> reference(inp, mat, mesh);
+  reference.setup();
+  ExternalSource::SP_externalsource
+    q(new ConstantSource(1, mesh, 1.0, reference.quadrature()));
+  reference.set_source(q);
+  reference.set_solver();
+  reference.solve();
+  const State::moments_type &phi_ref = reference.state()->phi(0);
+
+  // Decomposed
+  const char *names[] = {"dd_number_x", "dd_number_y", "dd_number_z"};
+  for (int d = 0; d < D::dimension; ++d)
+    inp->put<int>(names[d], parts[d]);
+  DomainDecompositionManager<D> manager(inp, mat, mesh);
+  manager.setup();
+  int number_subdomains = 1;
+  for (int d = 0; d < D::dimension; ++d)
+    number_subdomains *= parts[d];
+  TEST(manager.partitioner()->number_subdomains() == number_subdomains);
+  TEST(Comm::global_sum(manager.number_local_subdomains()) ==
+       number_subdomains);
+  for (int s = 0; s < number_subdomains; ++s)
+  {
+    TEST(manager.partitioner()->has_mesh(s) ==
+         (manager.owner(s) == Comm::rank()));
+  }
+  manager.set_source(q);
+  TEST(manager.set_solver());
+  TEST(manager.solve());
+  TEST(manager.number_iterations() > 1);
+
+  // Only the master gathers the flux, and it keeps no angular flux.
+  State::SP_state state = manager.state();
+  TEST(Comm::is_master() == (bool)state);
+  if (!state) return 0;
+  TEST(!state->store_angular_flux());
+  const State::moments_type &phi = state->phi(0);
+  TEST(phi.size() == phi_ref.size());
+  for (int i = 0; i < phi.size(); ++i)
+    TEST(soft_equiv(phi[i], phi_ref[i], 1.0e-8));
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_DomainDecompositionManager_1D(int argc, char *argv[])
+{
+  vec_dbl cm(3, 0.0); cm[1] = 5.0; cm[2] = 10.0;
+  vec_int fm(2, 10);
+  vec_int mt(2, 0); mt[1] = 1;
+  Mesh::SP_mesh mesh = Mesh1D::Create(fm, cm, mt);
+  int parts[] = {4};
+  return test_DomainDecompositionManager_T<_1D>(mesh, parts);
+}
+
+//----------------------------------------------------------------------------//
+int test_DomainDecompositionManager_2D(int argc, char *argv[])
+{
+  vec_dbl cm(3, 0.0); cm[1] = 3.0; cm[2] = 6.0;
+  vec_int fm(2, 5);
+  vec_int mt(4, 0); mt[3] = 1;
+  Mesh::SP_mesh mesh = Mesh2D::Create(fm, fm, cm, cm, mt);
+  int parts[] = {2, 3};
+  return test_DomainDecompositionManager_T<_2D>(mesh, parts);
+}
+
+//----------------------------------------------------------------------------//
+//              end of test_DomainDecompositionManager.cc
+//----------------------------------------------------------------------------//
@@ -12,11 +12,14 @@
         FUNC(test_MGSolverGMRES_7g_forward)          \
         FUNC(test_MGSolverGMRES_7g_forward_multiply) \
         FUNC(test_MGSolverGMRES_7g_adjoint)          \
-        FUNC(test_MGSolverGMRES_7g_adjoint_multiply)
+        FUNC(test_MGSolverGMRES_7g_adjoint_multiply) \
+        FUNC(test_MGSolverGMRES_batch)               \
+        FUNC(test_MGSolverGMRES_moc_cyclic)
 
 #include "TestDriver.hh"
 #include "solvers/FixedSourceManager.hh"
 #include "solvers/test/fixedsource_fixture.hh"
+#include "geometry/Mesh2D.hh"
 
 using namespace detran_test;
 using namespace detran;
@@ -165,6 +168,108 @@ int test_MGSolverGMRES_7g_adjoint_multiply(int argc, char *argv[])
   return 0;
 }
 
+int test_MGSolverGMRES_batch(int argc, char *argv[])
+{
+  FixedSourceData data = get_fixedsource_data(1, 7);
+  data.input->put<std::string>("outer_solver", "GMRES");
+  data.input->put<std::string>("bc_west", "reflect");
+  data.input->put<std::string>("bc_east", "reflect");
+  data.input->put<double>("inner_tolerance", 1e-14);
+  data.input->put<double>("outer_tolerance", 1e-14);
+  data.input->put<int>("inner_max_iters", 1000000);
+  data.input->put<int>("outer_max_iters", 1000000);
+  FixedSourceManager<_1D> manager(data.input, data.material, data.mesh);
+  manager.setup();
+
+  // the same operator with three source strengths
+  FixedSourceManager<_1D>::vec_source sources;
+  sources.push_back(data.source);
+  sources.push_back(ConstantSource::Create(7, data.mesh, 2.0));
+  sources.push_back(ConstantSource::Create(7, data.mesh, 0.5));
+  FixedSourceManager<_1D>::vec_state states = manager.solve_batch(sources);
+  TEST(states.size() == 3);
+
+  double ref[] = {1.983654685392368e+01, 3.441079047626809e+02,
+      5.302787426165165e+01, 1.125133608569081e+01, 2.662710276585539e+01,
+      1.010604145062320e+01, 4.015682491688769e+00};
+  double scale[] = {1.0, 2.0, 0.5};
+  for (int s = 0; s < 3; ++s)
+    for (int g = 0; g < 7; ++g)
+      TEST(soft_equiv(scale[s] * ref[g], states[s]->phi(g)[0], 1.0e-10));
+
+  // the manager solves a single source again after a new solver is set
+  TEST(!manager.solve());
+  manager.set_source(data.source);
+  manager.set_solver();
+  TEST(manager.solve());
+  for (int g = 0; g < 7; ++g)
+    TEST(soft_equiv(ref[g], manager.state()->phi(g)[0], 1.0e-10));
+  return 0;
+}
+
+int test_MGSolverGMRES_moc_cyclic(int argc, char *argv[])
+{
+  // Reflecting or periodic sides make the box an infinite medium, where
+  // the scalar flux is the source over the absorption cross section.
+  // Krylov solvers carry the closed chain fluxes as boundary unknowns,
+  // and each source of a batch starts from zero boundary fluxes.
+  Material::SP_material mat = Material::Create(1, 1, "scatterer");
+  mat->set_sigma_t(0, 0, 1.0);
+  mat->set_sigma_s(0, 0, 0, 0.5);
+  mat->finalize();
+
+  const char *bc[2][2] = {{"reflect", "reflect"}, {"periodic", "reflect"}};
+  const char *solver[3][2] = {{"GS", "SI"}, {"GS", "GMRES"},
+                              {"GMRES", "GMRES"}};
+  for (int b = 0; b < 2; ++b)
+  {
+    for (int s = 0; s < 3; ++s)
+    {
+      vec_dbl cm(3, 0.0);
+      cm[1] = 1.0;
+      cm[2] = 2.0;
+      vec_int fm(2, 3);
+      vec_int mt(4, 0);
+      Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mt));
+
+      InputDB::SP_input input = InputDB::Create();
+      input->put<int>("number_groups", 1);
+      input->put<std::string>("equation", "scmoc");
+      input->put<std::string>("quad_type", "u-dgl");
+      input->put<int>("quad_number_azimuth_octant", 3);
+      input->put<int>("quad_number_polar_octant", 2);
+      input->put<double>("tracker_maximum_spacing", 0.05);
+      input->put<int>("tracker_cyclic", 1);
+      input->put<std::string>("bc_west",  bc[b][0]);
+      input->put<std::string>("bc_east",  bc[b][0]);
+      input->put<std::string>("bc_south", bc[b][1]);
+      input->put<std::string>("bc_north", bc[b][1]);
+      input->put<std::string>("outer_solver", solver[s][0]);
+      input->put<std::string>("inner_solver", solver[s][1]);
+      input->put<double>("inner_tolerance", 1e-12);
+      input->put<double>("outer_tolerance", 1e-12);
+      input->put<int>("inner_max_iters", 1000000);
+      input->put<int>("outer_max_iters", 1000000);
+      input->put<int>("inner_print_level", 0);
+      input->put<int>("outer_print_level", 0);
+      FixedSourceManager<_2D> manager(input, mat, mesh);
+      manager.setup();
+
+      FixedSourceManager<_2D>::vec_source sources;
+      sources.push_back(ConstantSource::Create(1, mesh, 1.0,
+                                               manager.quadrature()));
+      sources.push_back(ConstantSource::Create(1, mesh, 2.0,
+                                               manager.quadrature()));
+      FixedSourceManager<_2D>::vec_state states = manager.solve_batch(sources);
+      TEST(states.size() == 2);
+      for (int q = 0; q < 2; ++q)
+        for (int i = 0; i < mesh->number_cells(); ++i)
+          TEST(soft_equiv(states[q]->phi(0)[i], 2.0 * (q + 1), 1.0e-8));
+    }
+  }
+  return 0;
+}
+
 //----------------------------------------------------------------------------//
 //              end of test_MGSolverGMRES.cc
 //----------------------------------------------------------------------------//
@@ -12,7 +12,9 @@
         FUNC(test_MGSolverGS_7g_forward)          \
         FUNC(test_MGSolverGS_7g_forward_multiply) \
         FUNC(test_MGSolverGS_7g_adjoint)          \
-        FUNC(test_MGSolverGS_7g_adjoint_multiply)
+        FUNC(test_MGSolverGS_7g_adjoint_multiply) \
+        FUNC(test_MGSolverGS_single_precision)   \
+        FUNC(test_MGSolverGS_batch)
 
 #include "TestDriver.hh"
 #include "solvers/FixedSourceManager.hh"
@@ -156,6 +158,78 @@ int test_MGSolverGS_7g_adjoint_multiply(int argc, char *argv[])
   return 0;
 }
 
+//----------------------------------------------------------------------------//
+int test_MGSolverGS_single_precision(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  {
+    typedef FixedSourceManager<_2D> Manager_2D;
+    const char *inner[] = {"SI", "GMRES"};
+    for (int s = 0; s < 2; ++s)
+    {
+      // Double and mixed precision solves of a reflected 2-D problem
+      vec2_dbl phi(2);
+      for (int p = 0; p < 2; ++p)
+      {
+        FixedSourceData data = get_fixedsource_data(2, 2, 6);
+        set_data(data.input);
+        data.input->put<std::string>("inner_solver", inner[s]);
+        data.input->put<double>("inner_tolerance", 1e-12);
+        data.input->put<double>("outer_tolerance", 1e-12);
+        data.input->put<std::string>("bc_south", "reflect");
+        data.input->put<int>("quad_number_polar_octant",   2);
+        data.input->put<int>("quad_number_azimuth_octant", 3);
+        data.input->put<int>("sweeper_angle_packets", 1);
+        if (p == 1) data.input->put<std::string>("inner_precision", "single");
+        Manager_2D manager(data.input, data.material, data.mesh);
+        manager.setup();
+        manager.set_source(data.source);
+        manager.set_solver();
+        manager.solve();
+        phi[p] = manager.state()->phi(1);
+      }
+      for (int i = 0; i < phi[0].size(); ++i)
+        TEST(soft_equiv(phi[0][i], phi[1][i], 1.0e-9));
+    }
+  }
+  callow_finalize();
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_MGSolverGS_batch(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  {
+    // Each source of a batch gives the flux of solving it alone, with
+    // either within-group solver.
+    double ref[] = {1.983654685392368e+01, 3.441079047626809e+02,
+         5.302787426165165e+01, 1.125133608569081e+01, 2.662710276585539e+01,
+         1.010604145062320e+01, 4.015682491688769e+00};
+    double scale[] = {1.0, 2.0, 0.5};
+    const char *inner[] = {"SI", "GMRES"};
+    for (int s = 0; s < 2; ++s)
+    {
+      FixedSourceData data = get_fixedsource_data(1, 7);
+      set_data(data.input);
+      data.input->put<std::string>("inner_solver", inner[s]);
+      Manager manager(data.input, data.material, data.mesh);
+      manager.setup();
+      Manager::vec_source sources;
+      sources.push_back(data.source);
+      sources.push_back(ConstantSource::Create(7, data.mesh, 2.0));
+      sources.push_back(ConstantSource::Create(7, data.mesh, 0.5));
+      Manager::vec_state states = manager.solve_batch(sources);
+      TEST(states.size() == 3);
+      for (int q = 0; q < 3; ++q)
+        for (int g = 0; g < 7; ++g)
+          TEST(soft_equiv(scale[q] * ref[g], states[q]->phi(g)[0], 1.0e-10));
+    }
+  }
+  callow_finalize();
+  return 0;
+}
+
 //----------------------------------------------------------------------------//
 //              end of test_MGSolverGS.cc
 //----------------------------------------------------------------------------//
@@ -281,10 +281,10 @@ int test_BDF_Steps(int argc, char *argv[])
 
     // Initial condition (constant psi = 1/2)
     TS_1D::SP_state ic = stepper.state();
+    State::angular_flux_type psi(mesh->number_cells(), 0.5);
     for (int o = 0; o < stepper.quadrature()->number_octants(); ++o)
       for (int a = 0; a < stepper.quadrature()->number_angles_octant(); ++a)
-        for (int i = 0; i < mesh->number_cells(); ++i)
-          ic->psi(0, o, a)[i] = 0.5;
+        ic->set_psi(0, o, a, psi);
 
     stepper.solve(ic);
 
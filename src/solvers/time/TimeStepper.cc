@@ -510,26 +510,29 @@ void TimeStepper<D>::extrapolate()
   {
     for (size_t g = 0; g < d_number_groups; ++g)
     {
-      // Clear the scalar flux.  We'll rebuild it with the extrapolated
-      // angular flux.
-      for (size_t i = 0; i < d_mesh->number_cells(); ++i)
-        d_state->phi(g)[i] = 0.0;
+      // Rebuild the scalar flux with the extrapolated angular flux.  It
+      // is replaced only at the end, since the angular flux of groups
+      // that are not stored is recovered from it.
+      State::moments_type phi(d_mesh->number_cells(), 0.0);
       for (size_t o = 0; o < d_quadrature->number_octants(); ++o)
       {
         for (size_t a = 0; a < d_quadrature->number_angles_octant(); ++a)
         {
           // Updated flux
-          State::angular_flux_type &psi  = d_state->psi(g, o, a);
+          State::angular_flux_type psi  = d_state->psi(g, o, a);
           // Previous flux
-          const State::angular_flux_type &psi0 = d_states[0]->psi(g, o, a);
+          const State::angular_flux_type psi0 = d_states[0]->psi(g, o, a);
           for (size_t i = 0; i < d_mesh->number_cells(); ++i)
           {
             psi[i] = 2.0 * psi[i] - psi0[i];
             if (d_fixup && psi[i] < 0.0) psi[i] = 0.0;
-            d_state->phi(g)[i] += d_quadrature->weight(a) * psi[i];
+            phi[i] += d_quadrature->weight(a) * psi[i];
           } // end cell
+          d_state->set_psi(g, o, a, psi);
         } // end angle
       } // end octant
+      for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+        d_state->phi(g)[i] = phi[i];
     } // end group
   }
   else
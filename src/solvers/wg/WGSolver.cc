@@ -11,6 +11,7 @@
 #include "transport/Sweeper2D.cc"
 #include "transport/Sweeper3D.cc"
 #include "transport/Sweeper2DMOC.cc"
+#include "transport/Sweeper3DMOC.cc"
 #include <iostream>
 
 namespace detran
@@ -28,6 +29,8 @@ WGSolver<D>::WGSolver(SP_state                  state,
   : Base(state, material, boundary, q_e, q_f)
   , d_quadrature(quadrature)
   , d_multiply(multiply)
+  , d_single_precision(false)
+  , d_single_tolerance(1.0e-4)
 {
   // Preconditions
   Require(quadrature);
@@ -97,6 +100,26 @@ WGSolver<D>::WGSolver(SP_state                  state,
     message.append(" is not supported for this dimension.");
     THROW(message);
   }
+
+  //-------------------------------------------------------------------------//
+  // PRECISION
+  //-------------------------------------------------------------------------//
+
+  if (d_input->check("inner_precision"))
+  {
+    std::string p = d_input->template get<std::string>("inner_precision");
+    Insist(p == "double" || p == "single",
+           "inner_precision must be double or single.");
+    d_single_precision = p == "single";
+  }
+  if (d_input->check("inner_single_tolerance"))
+  {
+    d_single_tolerance =
+      d_input->template get<double>("inner_single_tolerance");
+  }
+  Insist(!d_single_precision || d_sweeper->has_single_precision(),
+         "Single precision inner iterations need sweeper_angle_packets "
+         "and an equation with angle packets.");
 }
 
 //---------------------------------------------------------------------------//
@@ -119,6 +142,13 @@ inline bool WGSolver<_3D>::set_sweep(std::string equation)
       d_sweepsource);
     return true;
   }
+  else if (equation == "scmoc")
+  {
+    d_sweeper = new Sweeper3DMOC<Equation_SC_MOC>(
+      d_input, d_mesh, d_material, d_quadrature, d_state, d_boundary,
+      d_sweepsource);
+    return true;
+  }
   return false;
 }
 
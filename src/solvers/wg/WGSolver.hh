@@ -13,6 +13,7 @@
 #include "angle/MomentToDiscrete.hh"
 #include "transport/Sweeper.hh"
 #include "transport/Sweeper2DMOC.hh"
+#include "transport/Sweeper3DMOC.hh"
 #include "transport/SweepSource.hh"
 #include "utilities/MathUtilities.hh"
 #include <string>
@@ -67,6 +68,14 @@ namespace detran
  *    - inner_tolerance        [1e-5]
  *    - inner_print_out        [2], 0=never, 1=final, 2=every interval
  *    - inner_print_interval   [10]
+ *    - inner_precision        ["double"] or "single"
+ *    - inner_single_tolerance [1e-4]
+ *
+ *  With single precision, the inner iterations sweep in float (which
+ *  requires a sweeper with angle packets) and are then refined in double
+ *  precision, so the converged flux still meets inner_tolerance.  The
+ *  single tolerance is the relative error to which each single precision
+ *  stage is converged, and it should stay well above float round off.
  *
  *  @sa WGSolverSI, WGSolverGMRES
  */
@@ -182,6 +191,10 @@ protected:
   size_t d_number_sweeps;
   /// Flag for multiplying fixed source
   bool d_multiply;
+  /// Sweep in single precision with double precision refinement?
+  bool d_single_precision;
+  /// Tolerance of the single precision stages
+  double d_single_tolerance;
 
 private:
 
@@ -25,6 +25,9 @@ WGSolverGMRES<D>::WGSolverGMRES(SP_state                  state,
  : Base(state, material, quadrature, boundary, q_e, q_f, multiply)
  , d_reflective_solve_iterations(0)
  , d_update_angular_flux(false)
+ , d_number_refinements(0)
+ , d_number_refined_iterations(0)
+ , d_refined_residual(0.0)
 {
   Require(d_input);
 
@@ -42,6 +42,13 @@ namespace detran
  *  is often required.  A good preconditioner @f$ \mathbf{M} @f$
  *  is in some way "similar" to the operator @f$ \mathbf{A} @f$, and
  *  applying its inverse @f$ \mathbf{M}^{-1} @f$ can be done cheaply.
+ *
+ *  With inner_precision set to single, the system is solved by iterative
+ *  refinement.  The residual @f$ r = b - \mathbf{A}x @f$ is computed with
+ *  double precision sweeps, and the correction @f$ \mathbf{A}\delta = r @f$
+ *  is found by the Krylov solver with single precision sweeps, converged
+ *  to inner_single_tolerance.  Refinement stops once the residual meets
+ *  the tolerances of the Krylov solver, so nearly all sweeps are float.
  */
 //---------------------------------------------------------------------------//
 
@@ -128,6 +135,8 @@ private:
   using Base::d_print_level;
   using Base::d_print_interval;
   using Base::d_g;
+  using Base::d_single_precision;
+  using Base::d_single_tolerance;
 
   /// Main linear solver
   SP_linearsolver d_solver;
@@ -143,6 +152,12 @@ private:
   int d_reflective_solve_iterations;
   /// Flag to update the angular fluxes, including cell and boundary
   bool d_update_angular_flux;
+  /// Number of refinements in the last mixed precision solve
+  int d_number_refinements;
+  /// Krylov iterations summed over those refinements
+  int d_number_refined_iterations;
+  /// Residual norm at the end of the last mixed precision solve
+  double d_refined_residual;
 
   //--------------------------------------------------------------------------//
   // IMPLEMENTATION
@@ -151,6 +166,9 @@ private:
   /// Build the right hand side.
   void build_rhs(State::moments_type &B);
 
+  /// Solve by refinement of single precision solves.
+  void solve_refined();
+
 };
 
 } // namespace detran
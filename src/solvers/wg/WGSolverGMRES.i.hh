@@ -49,7 +49,13 @@ inline void WGSolverGMRES<D>::solve(const size_t g)
   d_x->copy(d_b);
 
   // Solve
-  if (b_norm > 0.0) d_solver->solve(*d_b, *d_x);
+  if (b_norm > 0.0)
+  {
+    if (d_single_precision)
+      solve_refined();
+    else
+      d_solver->solve(*d_b, *d_x);
+  }
 
   //-------------------------------------------------------------------------//
   // POSTPROCESS
@@ -93,11 +99,22 @@ inline void WGSolverGMRES<D>::solve(const size_t g)
 
   if (d_print_level > 0)
   {
+    // With refinement, the iterations of every correction count, and the
+    // error is the residual of the double precision problem.
+    int number_iterations = d_solver->number_iterations();
+    double error = d_solver->residual_norms()[number_iterations];
+    bool converged = error <= d_tolerance;
+    if (d_single_precision)
+    {
+      number_iterations = d_number_refined_iterations;
+      error = d_refined_residual;
+      converged = d_number_refinements < d_maximum_iterations;
+    }
     printf(" GMRES Final: Number Iters: %3i  Error: %12.9f  Sweeps: %6i \n",
-           d_solver->number_iterations(),
-           d_solver->residual_norms()[d_solver->number_iterations()],
-           d_sweeper->number_sweeps());
-    if (d_solver->residual_norms()[d_solver->number_iterations()] > d_tolerance)
+           number_iterations, error, d_sweeper->number_sweeps());
+    if (d_single_precision)
+      printf(" GMRES Final: Refinements: %3i \n", d_number_refinements);
+    if (!converged)
     {
       detran_utilities::warning(detran_utilities::SOLVER_CONVERGENCE,
         "    WGSolverGMRES did not converge.");
@@ -106,6 +123,51 @@ inline void WGSolverGMRES<D>::solve(const size_t g)
 
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+inline void WGSolverGMRES<D>::solve_refined()
+{
+  // Tolerances of the double precision problem
+  double atol  = d_solver->absolute_tolerance();
+  double rtol  = d_solver->relative_tolerance();
+  int    maxit = d_solver->maximum_iterations();
+
+  // Each correction is converged only to the single tolerance
+  d_solver->set_tolerances(atol, std::max(rtol, d_single_tolerance), maxit);
+
+  callow::Vector r(d_b->size(), 0.0);
+  callow::Vector dx(d_b->size(), 0.0);
+  double r0_norm = 0.0;
+  d_number_refined_iterations = 0;
+  for (d_number_refinements = 0;
+       d_number_refinements < d_maximum_iterations;
+       ++d_number_refinements)
+  {
+    // Residual r = b - Ax with double precision sweeps
+    d_sweeper->set_single_precision(false);
+    d_operator->multiply(*d_x, r);
+    r.scale(-1.0);
+    r.add(*d_b);
+    double r_norm = r.norm(callow::L2);
+    if (d_number_refinements == 0) r0_norm = r_norm;
+    d_refined_residual = r_norm;
+    if (d_print_level > 1)
+      printf("    Refinement: %3i  Residual: %12.9e \n",
+             d_number_refinements, r_norm);
+    if (r_norm <= std::max(atol, rtol * r0_norm)) break;
+
+    // Correction Adx = r with single precision sweeps
+    d_sweeper->set_single_precision(true);
+    dx.set(0.0);
+    d_solver->solve(r, dx);
+    d_number_refined_iterations += d_solver->number_iterations();
+    d_x->add(dx);
+  }
+
+  d_sweeper->set_single_precision(false);
+  d_solver->set_tolerances(atol, rtol, maxit);
+}
+
 //---------------------------------------------------------------------------//
 template <class D>
 inline void WGSolverGMRES<D>::build_rhs(State::moments_type &B)
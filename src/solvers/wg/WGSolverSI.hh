@@ -121,6 +121,8 @@ private:
   using Base::d_print_interval;
   using Base::d_adjoint;
   using Base::d_g;
+  using Base::d_single_precision;
+  using Base::d_single_tolerance;
 
 };
 
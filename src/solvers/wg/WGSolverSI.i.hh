@@ -30,6 +30,10 @@ void WGSolverSI<D>::solve(const size_t g)
   // Setup boundary conditions.  This sets any conditions fixed for the solve.
   d_boundary->set(g);
 
+  // Reflect boundaries during each sweep.  The sweeper may be shared with
+  // a multigroup Krylov solver that turns this off after its own use.
+  d_sweeper->set_update_boundary(true);
+
   // Set the equations.
   d_sweeper->setup_group(g);
 
@@ -43,8 +47,17 @@ void WGSolverSI<D>::solve(const size_t g)
   // Construct within group.
   d_sweepsource->build_within_group_scatter(g, phi);
 
+  // In single precision, sweep in float until the single tolerance is met
+  // (or the error stalls at round off) and then refine in double.  The
+  // fixed point of the double precision iteration does not depend on
+  // where it starts.
+  bool single = d_single_precision;
+  double single_tolerance = std::max(d_tolerance, d_single_tolerance);
+  d_sweeper->set_single_precision(single);
+
   // Iterate.
   double error = 1.0;
+  double error_old = 0.0;
   size_t iteration;
   for (iteration = 1; iteration <= d_maximum_iterations; iteration++)
   {
@@ -56,13 +69,23 @@ void WGSolverSI<D>::solve(const size_t g)
     d_sweeper->sweep(phi);
 
     // Flux residual using L-infinity.
+    error_old = error;
     error = norm_residual(phi_old, phi, "Linf");
 
     if (d_print_level > 1 && iteration % d_print_interval == 0)
     {
       printf("    SI Iter: %3i  Error: %12.9f \n", iteration, error);
     }
-    if (error < d_tolerance) break;
+    bool stalled = iteration > 1 && error >= error_old;
+    if (single && (error < single_tolerance || stalled))
+    {
+      single = false;
+      d_sweeper->set_single_precision(false);
+    }
+    else if (error < d_tolerance)
+    {
+      break;
+    }
 
     // INSERT ACCELERATION HERE
     // d_accelerate->update(g, phi)
@@ -71,6 +94,7 @@ void WGSolverSI<D>::solve(const size_t g)
     d_sweepsource->build_within_group_scatter(g, phi);
 
   } // end iterations
+  d_sweeper->set_single_precision(false);
 
   if (d_print_level > 0)
   {
@@ -0,0 +1,104 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   AngularFluxArena.cc
+ *  @author Jeremy Roberts
+ *  @brief  AngularFluxArena member definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#include "AngularFluxArena.hh"
+#include <algorithm>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+AngularFluxArena::AngularFluxArena()
+  : d_number_angles(0)
+  , d_number_cells(0)
+  , d_precision(DOUBLE)
+{
+  /* ... */
+}
+
+//---------------------------------------------------------------------------//
+AngularFluxArena::AngularFluxArena(const size_t     number_groups,
+                                   const size_t     number_angles,
+                                   const size_t     number_cells,
+                                   const PRECISION  precision,
+                                   const vec_int   &resident_groups)
+  : d_number_angles(number_angles)
+  , d_number_cells(number_cells)
+  , d_precision(precision)
+  , d_slot(number_groups, -1)
+{
+  Require(precision < END_PRECISION);
+
+  // Assign arena slots in group order
+  int number_resident = 0;
+  for (size_t g = 0; g < number_groups; ++g)
+  {
+    bool resident = resident_groups.empty() ||
+      std::find(resident_groups.begin(), resident_groups.end(), (int)g) !=
+        resident_groups.end();
+    if (resident) d_slot[g] = number_resident++;
+  }
+  for (size_t i = 0; i < resident_groups.size(); ++i)
+  {
+    Insist(resident_groups[i] >= 0 && resident_groups[i] < number_groups,
+           "Resident angular flux groups must be valid groups.");
+  }
+
+  size_t n = number_resident * d_number_angles * d_number_cells;
+  if (d_precision == DOUBLE)
+    d_psi.assign(n, 0.0);
+  else
+    d_psi_single.assign(n, 0.0f);
+}
+
+//---------------------------------------------------------------------------//
+void AngularFluxArena::get(const size_t g, const size_t angle, vec_dbl &psi) const
+{
+  size_t i = offset(g, angle);
+  psi.resize(d_number_cells);
+  if (d_precision == DOUBLE)
+    std::copy(d_psi.begin() + i, d_psi.begin() + i + d_number_cells,
+              psi.begin());
+  else
+    std::copy(d_psi_single.begin() + i,
+              d_psi_single.begin() + i + d_number_cells, psi.begin());
+}
+
+//---------------------------------------------------------------------------//
+void AngularFluxArena::set(const size_t g, const size_t angle, const vec_dbl &psi)
+{
+  Require(psi.size() == d_number_cells);
+  if (!is_resident(g)) return;
+  size_t i = offset(g, angle);
+  if (d_precision == DOUBLE)
+    std::copy(psi.begin(), psi.end(), d_psi.begin() + i);
+  else
+    std::copy(psi.begin(), psi.end(), d_psi_single.begin() + i);
+}
+
+//---------------------------------------------------------------------------//
+void AngularFluxArena::clear()
+{
+  std::fill(d_psi.begin(), d_psi.end(), 0.0);
+  std::fill(d_psi_single.begin(), d_psi_single.end(), 0.0f);
+}
+
+//---------------------------------------------------------------------------//
+void AngularFluxArena::scale(const double f)
+{
+  for (size_t i = 0; i < d_psi.size(); ++i)
+    d_psi[i] *= f;
+  for (size_t i = 0; i < d_psi_single.size(); ++i)
+    d_psi_single[i] *= f;
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of AngularFluxArena.cc
+//---------------------------------------------------------------------------//
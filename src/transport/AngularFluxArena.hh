@@ -0,0 +1,213 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   AngularFluxArena.hh
+ *  @author Jeremy Roberts
+ *  @brief  AngularFluxArena class definition.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_ANGULARFLUXARENA_HH_
+#define detran_ANGULARFLUXARENA_HH_
+
+#include "transport/transport_export.hh"
+#include "utilities/DBC.hh"
+#include "utilities/Definitions.hh"
+#include <vector>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class StridedView
+ *  @brief Unowned view of equally-spaced values in an arena.
+ */
+//---------------------------------------------------------------------------//
+template <class T>
+struct StridedView
+{
+  typedef detran_utilities::size_t size_t;
+
+  StridedView(T *data = 0, const size_t size = 0, const size_t stride = 1)
+    : d_data(data), d_size(size), d_stride(stride) {}
+
+  T& operator[](const size_t i) const
+  {
+    Require(i < d_size);
+    return d_data[i * d_stride];
+  }
+
+  size_t size() const { return d_size; }
+  size_t stride() const { return d_stride; }
+
+  T *d_data;
+  size_t d_size;
+  size_t d_stride;
+};
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class AngularFluxArena
+ *  @brief Contiguous storage of the cell-center angular flux.
+ *
+ *  All values live in one allocation ordered as [group, angle, cell],
+ *  so the flux of one angle is a unit-stride row and the flux of one
+ *  cell over all angles has a stride of the number of cells.  Values
+ *  are stored in double or single precision; single precision halves
+ *  the footprint at the cost of about seven significant digits.
+ *
+ *  Only selected groups may be kept resident.  A group that is not
+ *  resident has no storage, writes to it are ignored, and its flux is
+ *  reconstructed by the client (see State::psi).
+ */
+//---------------------------------------------------------------------------//
+class TRANSPORT_EXPORT AngularFluxArena
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::vec_int   vec_int;
+  typedef detran_utilities::vec_dbl   vec_dbl;
+  typedef detran_utilities::size_t    size_t;
+
+  enum PRECISION
+  {
+    DOUBLE, SINGLE, END_PRECISION
+  };
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /// Empty arena
+  AngularFluxArena();
+
+  /**
+   *  @brief Constructor.
+   *  @param number_groups    Number of groups
+   *  @param number_angles    Number of angles
+   *  @param number_cells     Number of cells
+   *  @param precision        Storage precision
+   *  @param resident_groups  Groups to store (all if empty)
+   */
+  AngularFluxArena(const size_t     number_groups,
+                   const size_t     number_angles,
+                   const size_t     number_cells,
+                   const PRECISION  precision = DOUBLE,
+                   const vec_int   &resident_groups = vec_int(0));
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Is a group stored?
+  bool is_resident(const size_t g) const
+  {
+    Require(g < d_slot.size());
+    return d_slot[g] >= 0;
+  }
+
+  /// Storage precision
+  PRECISION precision() const { return d_precision; }
+
+  /// Bytes held by the angular flux values
+  size_t memory_size() const
+  {
+    return d_psi.size() * sizeof(double) + d_psi_single.size() * sizeof(float);
+  }
+
+  /// Copy one angle's flux into psi (resized as needed)
+  void get(const size_t g, const size_t angle, vec_dbl &psi) const;
+
+  /// Store one angle's flux; ignored if the group is not resident
+  void set(const size_t g, const size_t angle, const vec_dbl &psi);
+
+  /// Value for one group, angle, and cell of a resident group
+  double value(const size_t g, const size_t angle, const size_t cell) const
+  {
+    size_t i = offset(g, angle) + cell;
+    return d_precision == DOUBLE ? d_psi[i] : d_psi_single[i];
+  }
+
+  /// Flux over cells for one angle, in the storage precision T
+  template <class T>
+  StridedView<T> angle_view(const size_t g, const size_t angle)
+  {
+    return StridedView<T>(data<T>() + offset(g, angle), d_number_cells, 1);
+  }
+
+  /// Flux over angles for one cell, in the storage precision T
+  template <class T>
+  StridedView<T> cell_view(const size_t g, const size_t cell)
+  {
+    Require(cell < d_number_cells);
+    return StridedView<T>(data<T>() + offset(g, 0) + cell,
+                          d_number_angles, d_number_cells);
+  }
+
+  /// Zero all values
+  void clear();
+
+  /// Scale all values
+  void scale(const double f);
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  size_t d_number_angles;
+  size_t d_number_cells;
+  PRECISION d_precision;
+  /// Position of each group in the arena, or -1 if not resident
+  vec_int d_slot;
+  /// Values for double and single precision storage (one is empty)
+  vec_dbl d_psi;
+  std::vector<float> d_psi_single;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Start of one angle's row
+  size_t offset(const size_t g, const size_t angle) const
+  {
+    Require(is_resident(g));
+    Require(angle < d_number_angles);
+    return (d_slot[g] * d_number_angles + angle) * d_number_cells;
+  }
+
+  /// Raw storage of the given precision
+  template <class T>
+  T* data();
+
+};
+
+//---------------------------------------------------------------------------//
+template <>
+inline double* AngularFluxArena::data<double>()
+{
+  Insist(d_precision == DOUBLE, "The angular flux is not double precision.");
+  return d_psi.empty() ? 0 : &d_psi[0];
+}
+
+//---------------------------------------------------------------------------//
+template <>
+inline float* AngularFluxArena::data<float>()
+{
+  Insist(d_precision == SINGLE, "The angular flux is not single precision.");
+  return d_psi_single.empty() ? 0 : &d_psi_single[0];
+}
+
+} // end namespace detran
+
+#endif /* detran_ANGULARFLUXARENA_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of AngularFluxArena.hh
+//---------------------------------------------------------------------------//
@@ -50,6 +50,9 @@ namespace detran
  *  order methods are implemented, equation-dependent currents would
  *  be required.
  *
+ *  Threaded sweepers tally several angles at once, so each tally is
+ *  added atomically.  The tally must be reset before, not during, the
+ *  parallel region of a sweep.
  */
 /**
  *  @example transport/test/test_CurrentTally.cc
@@ -80,6 +80,7 @@ CurrentTally<D>::tally(const size_t i,
                     d_coarsemesh->get_fine_mesh()->width(d2, dim[d2]);
 
       // Tally
+      #pragma omp atomic
       d_partial_current[d0][g][d_octant_shift[d0][o]][idx] +=
         psi[d0] * d_quadrature->cosines(d0)[a] * d_quadrature->weight(a) * area;
 
@@ -111,6 +112,7 @@ CurrentTally<_1D>::tally(const size_t i,
   if (coarse_edge >= 0)
   {
     // Tally.
+    #pragma omp atomic
     d_partial_current[0][g][d_octant_shift[0][o]][coarse_edge] +=
       psi * d_quadrature->mu(0, a) * d_quadrature->weight(a);
   }
@@ -163,6 +165,7 @@ CurrentTally<D>::tally(const size_t i,
                 d_coarsemesh->get_fine_mesh()->width(d2, dim[d2]);
 
   // Tally
+  #pragma omp atomic
   d_partial_current[d0][g][d_octant_shift[d0][o]][idx] +=
     psi * d_quadrature->cosines(d0)[a] * d_quadrature->weight(a) * area;
 }
@@ -10,11 +10,13 @@
 #ifndef detran_EQUATION_HH_
 #define detran_EQUATION_HH_
 
+#include "detran_config.hh"
 #include "transport/transport_export.hh"
 #include "DimensionTraits.hh"
 #include "material/Material.hh"
 #include "geometry/Mesh.hh"
 #include "angle/Quadrature.hh"
+#include "utilities/DBC.hh"
 #include "utilities/Definitions.hh"
 #include "utilities/SP.hh"
 
@@ -28,18 +30,38 @@ namespace detran
 /**
  *  @class Equation traits
  *  @brief Traits for defining the face flux type for a discretization
+ *
+ *  Packet face fluxes are stored as [face][lane], so that the fluxes for
+ *  all angles of a packet on one face are contiguous.  The value type T
+ *  is the precision of a sweep.
  */
-template <class D>
+template <class D, class T = double>
 class EquationTraits
 {
 public:
-  typedef double face_flux_type[D::dimension];
+  typedef T face_flux_type[D::dimension];
+  typedef T packet_flux_type[D::dimension][DETRAN_ANGLE_PACKET_SIZE];
 };
-template <>
-class EquationTraits<_1D>
+template <class T>
+class EquationTraits<_1D, T>
 {
 public:
-  typedef double face_flux_type;
+  typedef T face_flux_type;
+  typedef T packet_flux_type[1][DETRAN_ANGLE_PACKET_SIZE];
+};
+
+/**
+ *  @class PacketCoefficients
+ *  @brief Streaming coefficients and weights of an angle packet
+ *
+ *  Coefficients are stored per dimension as [index * packet_size + lane].
+ *  Equations keep one set for each precision in which they sweep.
+ */
+template <class T>
+struct PacketCoefficients
+{
+  std::vector<T> coef[3];
+  T weight[DETRAN_ANGLE_PACKET_SIZE];
 };
 
 //---------------------------------------------------------------------------//
@@ -58,6 +80,9 @@ public:
   /// Dimension of equation.
   static const int dimension = D::dimension;
 
+  /// Number of angles solved at once by a packet solve.
+  static const int packet_size = DETRAN_ANGLE_PACKET_SIZE;
+
   //-------------------------------------------------------------------------//
   // TYPEDEFS
   //-------------------------------------------------------------------------//
@@ -69,6 +94,7 @@ public:
   typedef detran_utilities::vec_dbl                       moments_type;
   typedef detran_utilities::vec_dbl                       angular_flux_type;
   typedef typename EquationTraits<D>::face_flux_type      face_flux_type;
+  typedef typename EquationTraits<D>::packet_flux_type    packet_flux_type;
   typedef detran_utilities::size_t                        size_t;
 
   //-------------------------------------------------------------------------//
@@ -149,6 +175,60 @@ public:
    */
   virtual void setup_angle(const size_t angle) = 0;
 
+  //-------------------------------------------------------------------------//
+  // ANGLE PACKETS -- OPTIONAL FOR EQUATION TYPES
+  //-------------------------------------------------------------------------//
+
+  /*
+   *  Equations that can solve one cell for several angles of an octant at
+   *  once hide these members with their own.  Sweepers call them through
+   *  the concrete equation type, so no virtual dispatch is involved.
+   */
+
+  /// Does this equation solve packets of angles?
+  static bool has_packets() { return false; }
+
+  /**
+   *  @brief Setup the equations for a packet of angles.
+   *  @param angle  First angle index within octant
+   *  @param number Number of angles in the packet (at most packet_size)
+   */
+  void setup_packet(const size_t angle, const size_t number)
+  {
+    THROW("Angle packets are not implemented for this equation.");
+  }
+
+  /**
+   *   @brief Solve for the cell-center and outgoing edge fluxes of a packet.
+   *
+   *   Sources and angular fluxes are stored angle-major, i.e. the value
+   *   for lane l in a cell is at [cell * packet_size + l].  Unused lanes of
+   *   a partial packet are computed but carry no weight.  The cell is
+   *   solved in the precision T of the source, while the flux moments
+   *   are always accumulated in double precision.
+   *
+   *   @param   i           Cell x index
+   *   @param   j           Cell y index
+   *   @param   k           Cell z index
+   *   @param   source      Packet source
+   *   @param   psi_in      Incident packet flux for this cell
+   *   @param   psi_out     Outgoing packet flux from this cell
+   *   @param   phi         Reference to flux moments for this group
+   *   @param   psi         Packet angular flux (if it is stored)
+   */
+  template <class T>
+  void solve_packet(const size_t i,
+                    const size_t j,
+                    const size_t k,
+                    const T *source,
+                    typename EquationTraits<D, T>::packet_flux_type &psi_in,
+                    typename EquationTraits<D, T>::packet_flux_type &psi_out,
+                    moments_type &phi,
+                    T *psi)
+  {
+    THROW("Angle packets are not implemented for this equation.");
+  }
+
 protected:
 
   //-------------------------------------------------------------------------//
@@ -169,6 +249,8 @@ protected:
   double d_ksi;
   /// Material map
   detran_utilities::vec_int d_mat_map;
+  /// Total cross section by cell for the current group
+  detran_utilities::vec_dbl d_sigma_t;
   /// Update the angular flux?
   bool d_update_psi;
   /// Current group
@@ -28,7 +28,7 @@ inline void Equation_DD_2D::solve(const size_t       i,
 
   // Compute cell-center angular flux.
   int cell = d_mesh->index(i, j);
-  double coef = 1.0 / (d_material->sigma_t(d_mat_map[cell], d_g) +
+  double coef = 1.0 / (d_sigma_t[cell] +
                        d_coef_x[i] + d_coef_y[j]);
   double psi_center = coef * (source[cell] +
                               d_coef_x[i] * psi_in[detran_geometry::Mesh::VERT] +
@@ -49,6 +49,70 @@ inline void Equation_DD_2D::solve(const size_t       i,
 
 }
 
+//---------------------------------------------------------------------------//
+template <>
+inline const PacketCoefficients<double>& Equation_DD_2D::packet<double>() const
+{
+  return d_packet;
+}
+
+//---------------------------------------------------------------------------//
+template <>
+inline const PacketCoefficients<float>& Equation_DD_2D::packet<float>() const
+{
+  return d_packet_single;
+}
+
+//---------------------------------------------------------------------------//
+template <class T>
+inline void Equation_DD_2D::solve_packet(const size_t       i,
+                                         const size_t       j,
+                                         const size_t       k,
+                                         const T           *source,
+                                         typename EquationTraits<_2D, T>::
+                                           packet_flux_type &psi_in,
+                                         typename EquationTraits<_2D, T>::
+                                           packet_flux_type &psi_out,
+                                         moments_type      &phi,
+                                         T                 *psi)
+{
+  // Preconditions.  (The client *must* set group and packet.)
+  Require(k == 0);
+
+  typedef detran_geometry::Mesh Mesh;
+
+  // One material lookup serves every lane.
+  int cell = d_mesh->index(i, j);
+  const PacketCoefficients<T> &c = packet<T>();
+  T sigma = d_sigma_t[cell];
+  const T *coef_x = &c.coef[0][i * packet_size];
+  const T *coef_y = &c.coef[1][j * packet_size];
+  const T *q      = &source[cell * packet_size];
+
+  // Fixed trip count with unit stride, so the lanes vectorize.
+  T psi_center[packet_size];
+  T phi_cell = 0.0;
+  for (int l = 0; l < packet_size; ++l)
+  {
+    psi_center[l] = (q[l] + coef_x[l] * psi_in[Mesh::VERT][l] +
+                            coef_y[l] * psi_in[Mesh::HORZ][l]) /
+                    (sigma + coef_x[l] + coef_y[l]);
+    psi_out[Mesh::HORZ][l] = T(2) * psi_center[l] - psi_in[Mesh::HORZ][l];
+    psi_out[Mesh::VERT][l] = T(2) * psi_center[l] - psi_in[Mesh::VERT][l];
+    phi_cell += c.weight[l] * psi_center[l];
+  }
+
+  // Accumulate the flux moments in double precision.
+  phi[cell] += phi_cell;
+
+  // Store angular flux if needed.
+  if (d_update_psi)
+  {
+    for (int l = 0; l < packet_size; ++l)
+      psi[cell * packet_size + l] = psi_center[l];
+  }
+}
+
 } // end namespace detran
 
 #endif /* detran_EQUATION_DD_2D_I_HH_ */
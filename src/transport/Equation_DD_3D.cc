@@ -22,7 +22,11 @@ Equation_DD_3D::Equation_DD_3D(SP_mesh       mesh,
   ,  d_coef_y(mesh->number_cells_y())
   ,  d_coef_z(mesh->number_cells_z())
 {
-  /* ... */
+  for (int d = 0; d < 3; ++d)
+  {
+    d_packet.coef[d].resize(mesh->number_cells(d) * packet_size, 0.0);
+    d_packet_single.coef[d].resize(mesh->number_cells(d) * packet_size, 0.0f);
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -30,6 +34,8 @@ void Equation_DD_3D::setup_group(const size_t g)
 {
   Require(g < d_material->number_groups());
   d_g = g;
+  d_material->expand(detran_material::Material::SIGMA_T, g,
+                     d_mat_map, d_sigma_t);
 }
 
 //---------------------------------------------------------------------------//
@@ -62,6 +68,47 @@ void Equation_DD_3D::setup_angle(const size_t angle)
 
 }
 
+//---------------------------------------------------------------------------//
+void Equation_DD_3D::setup_packet(const size_t angle, const size_t number)
+{
+  Require(number > 0 && number <= packet_size);
+  Require(angle + number <= d_quadrature->number_angles_octant());
+  d_angle = angle;
+  for (size_t l = 0; l < packet_size; ++l)
+  {
+    // Unused lanes get zero streaming and zero weight.
+    double w = 0.0;
+    double mu = 0.0, eta = 0.0, xi = 0.0;
+    if (l < number)
+    {
+      w   = d_quadrature->weight(angle + l);
+      mu  = d_quadrature->mu(0, angle + l);
+      eta = d_quadrature->eta(0, angle + l);
+      xi  = d_quadrature->xi(0, angle + l);
+    }
+    d_packet.weight[l] = w;
+    d_packet_single.weight[l] = w;
+    for (size_t i = 0; i < d_mesh->number_cells_x(); ++i)
+    {
+      double c = 2.0 * mu / d_mesh->dx(i);
+      d_packet.coef[0][i * packet_size + l] = c;
+      d_packet_single.coef[0][i * packet_size + l] = c;
+    }
+    for (size_t j = 0; j < d_mesh->number_cells_y(); ++j)
+    {
+      double c = 2.0 * eta / d_mesh->dy(j);
+      d_packet.coef[1][j * packet_size + l] = c;
+      d_packet_single.coef[1][j * packet_size + l] = c;
+    }
+    for (size_t k = 0; k < d_mesh->number_cells_z(); ++k)
+    {
+      double c = 2.0 * xi / d_mesh->dz(k);
+      d_packet.coef[2][k * packet_size + l] = c;
+      d_packet_single.coef[2][k * packet_size + l] = c;
+    }
+  }
+}
+
 } // end namespace detran
 
 //---------------------------------------------------------------------------//
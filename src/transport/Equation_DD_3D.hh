@@ -38,6 +38,7 @@ public:
   typedef Equation<_3D>::moments_type             moments_type;
   typedef Equation<_3D>::angular_flux_type        angular_flux_type;
   typedef Equation<_3D>::face_flux_type           face_flux_type;
+  typedef Equation<_3D>::packet_flux_type         packet_flux_type;
 
   //-------------------------------------------------------------------------//
   // CONSTRUCTOR & DESTRUCTOR
@@ -73,6 +74,29 @@ public:
   /// Setup the equations for an angle.
   void setup_angle(const size_t angle);
 
+  //-------------------------------------------------------------------------//
+  // ANGLE PACKETS
+  //-------------------------------------------------------------------------//
+
+  /// Diamond difference solves packets of angles.
+  static bool has_packets() { return true; }
+
+  /// Setup the equations for a packet of angles.
+  void setup_packet(const size_t angle, const size_t number);
+
+  /// Solve for the cell-center and outgoing edge fluxes of a packet.
+  template <class T>
+  inline void solve_packet(const size_t i,
+                           const size_t j,
+                           const size_t k,
+                           const T *source,
+                           typename EquationTraits<_3D, T>::
+                             packet_flux_type &psi_in,
+                           typename EquationTraits<_3D, T>::
+                             packet_flux_type &psi_out,
+                           moments_type &phi,
+                           T *psi);
+
 
 private:
 
@@ -84,6 +108,18 @@ private:
 
   /// Z-directed coefficient, \f$ 2|\xi|/\Delta_z \f$.
   detran_utilities::vec_dbl d_coef_z;
+
+  /// Packet coefficients for double and single precision sweeps.
+  PacketCoefficients<double> d_packet;
+  PacketCoefficients<float>  d_packet_single;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Packet coefficients in the sweep precision T.
+  template <class T>
+  inline const PacketCoefficients<T>& packet() const;
 };
 
 } // end namespace detran
@@ -27,7 +27,7 @@ inline void Equation_DD_3D::solve(const size_t i,
 
   // Compute cell-center angular flux.
   int cell = d_mesh->index(i, j, k);
-  double coef = 1.0 / (d_material->sigma_t(d_mat_map[cell], d_g) +
+  double coef = 1.0 / (d_sigma_t[cell] +
                        d_coef_x[i] + d_coef_y[j] + d_coef_z[k]);
   double psi_center = coef * (source[cell] + d_coef_x[i] * psi_in[Mesh::YZ] +
                                              d_coef_y[j] * psi_in[Mesh::XZ] +
@@ -47,6 +47,70 @@ inline void Equation_DD_3D::solve(const size_t i,
 
 }
 
+//---------------------------------------------------------------------------//
+template <>
+inline const PacketCoefficients<double>& Equation_DD_3D::packet<double>() const
+{
+  return d_packet;
+}
+
+//---------------------------------------------------------------------------//
+template <>
+inline const PacketCoefficients<float>& Equation_DD_3D::packet<float>() const
+{
+  return d_packet_single;
+}
+
+//---------------------------------------------------------------------------//
+template <class T>
+inline void Equation_DD_3D::solve_packet(const size_t       i,
+                                         const size_t       j,
+                                         const size_t       k,
+                                         const T           *source,
+                                         typename EquationTraits<_3D, T>::
+                                           packet_flux_type &psi_in,
+                                         typename EquationTraits<_3D, T>::
+                                           packet_flux_type &psi_out,
+                                         moments_type      &phi,
+                                         T                 *psi)
+{
+  typedef detran_geometry::Mesh Mesh;
+
+  // One material lookup serves every lane.
+  int cell = d_mesh->index(i, j, k);
+  const PacketCoefficients<T> &c = packet<T>();
+  T sigma = d_sigma_t[cell];
+  const T *coef_x = &c.coef[0][i * packet_size];
+  const T *coef_y = &c.coef[1][j * packet_size];
+  const T *coef_z = &c.coef[2][k * packet_size];
+  const T *q      = &source[cell * packet_size];
+
+  // Fixed trip count with unit stride, so the lanes vectorize.
+  T psi_center[packet_size];
+  T phi_cell = 0.0;
+  for (int l = 0; l < packet_size; ++l)
+  {
+    psi_center[l] = (q[l] + coef_x[l] * psi_in[Mesh::YZ][l] +
+                            coef_y[l] * psi_in[Mesh::XZ][l] +
+                            coef_z[l] * psi_in[Mesh::XY][l]) /
+                    (sigma + coef_x[l] + coef_y[l] + coef_z[l]);
+    psi_out[Mesh::YZ][l] = T(2) * psi_center[l] - psi_in[Mesh::YZ][l];
+    psi_out[Mesh::XZ][l] = T(2) * psi_center[l] - psi_in[Mesh::XZ][l];
+    psi_out[Mesh::XY][l] = T(2) * psi_center[l] - psi_in[Mesh::XY][l];
+    phi_cell += c.weight[l] * psi_center[l];
+  }
+
+  // Accumulate the flux moments in double precision.
+  phi[cell] += phi_cell;
+
+  // Store angular flux if needed.
+  if (d_update_psi)
+  {
+    for (int l = 0; l < packet_size; ++l)
+      psi[cell * packet_size + l] = psi_center[l];
+  }
+}
+
 } // end namespace detran
 
 #endif /* detran_EQUATION_DD_3D_I_HH_ */
@@ -151,6 +151,8 @@ protected:
   double d_inv_sin;
   /// Material map
   detran_utilities::vec_int d_mat_map;
+  /// Total cross section by cell for the current group
+  detran_utilities::vec_dbl d_sigma_t;
   /// Update the angular flux?
   bool d_update_psi;
   /// Current group
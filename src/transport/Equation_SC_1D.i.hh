@@ -39,7 +39,7 @@ inline void Equation_SC_1D::solve(const size_t i,
   Require(d_mu > 0.0);
 
   // Compute cell-center angular flux.
-  double sigma = d_material->sigma_t(d_mat_map[i], d_g);
+  double sigma = d_sigma_t[i];
   double tau   = sigma * d_mesh->dx(i) / d_mu;
   double A     = std::exp(-tau);
   double q     = source[i];
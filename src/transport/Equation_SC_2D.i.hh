@@ -35,7 +35,7 @@ inline void Equation_SC_2D::solve(const size_t       i,
   typedef detran_geometry::Mesh Mesh;
 
   int cell = d_mesh->index(i, j);
-  double sigma = d_material->sigma_t(d_mat_map[cell], d_g);
+  double sigma = d_sigma_t[cell];
   double Q = source[cell] / sigma;
   double alpha = sigma * d_alpha[i];
   double beta = sigma * d_beta[j];
@@ -20,6 +20,7 @@ Equation_SC_MOC::Equation_SC_MOC(SP_mesh       mesh,
   : Equation_MOC(mesh, material, quadrature, update_psi)
   , d_weights(quadrature->number_polar_octant(), 0.0)
   , d_inv_sin(quadrature->number_polar_octant(), 0.0)
+  , d_exp(new ExpTable())
 {
   for (size_t p = 0; p < d_quadrature->number_polar_octant(); ++p)
   {
@@ -32,12 +33,14 @@ void Equation_SC_MOC::setup_group(const size_t g)
 {
   Require(g < d_material->number_groups());
   d_g = g;
+  d_material->expand(detran_material::Material::SIGMA_T, g,
+                     d_mat_map, d_sigma_t);
 }
 
 //---------------------------------------------------------------------------//
 void Equation_SC_MOC::setup_octant(const size_t octant)
 {
-  Require(octant < 4);
+  Require(octant < d_quadrature->number_octants());
   d_octant = octant;
 }
 
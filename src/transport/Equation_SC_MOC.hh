@@ -11,6 +11,7 @@
 #define detran_EQUATION_SC_MOC_HH_
 
 #include "Equation_MOC.hh"
+#include "ExpTable.hh"
 
 namespace detran
 {
@@ -47,6 +48,11 @@ namespace detran
  *  The step characteristic method is positive but only first-order
  *  accurate in space.
  *
+ *  The exponential \f$ A \f$ is evaluated by an ExpTable, which is exact
+ *  unless the client sets an approximate one.  Alternatively, the client
+ *  can supply \f$ A \f$ directly, e.g. from a cache of precomputed
+ *  segment attenuations.
+ *
  *  Reference:  A. Hebert, <em>Applied Reactor Physics</em>.
  *
  * \sa Equation_DD_MOC
@@ -64,6 +70,7 @@ public:
   //-------------------------------------------------------------------------//
 
   typedef Equation_MOC                      Base;
+  typedef ExpTable::SP_exptable             SP_exptable;
 
   //-------------------------------------------------------------------------//
   // CONSTRUCTOR & DESTRUCTOR
@@ -89,6 +96,27 @@ public:
                     moments_type      &phi,
                     angular_flux_type &psi);
 
+  /**
+   *  @brief Solve given a precomputed segment attenuation.
+   *  @param   A    Attenuation, \f$ e^{-\Sigma_t l / \sin\theta} \f$
+   *  @sa solve
+   */
+  inline void solve(const size_t       region,
+                    const double       length,
+                    const double       width,
+                    const double       A,
+                    moments_type      &source,
+                    double            &psi_in,
+                    double            &psi_out,
+                    moments_type      &phi,
+                    angular_flux_type &psi);
+
+  /// Set the exponential evaluator.
+  void set_exp(SP_exptable exp)
+  {
+    Require(exp);
+    d_exp = exp;
+  }
 
   /// Setup the equations for a group.
   void setup_group(const size_t g);
@@ -114,6 +142,9 @@ private:
   /// Inverse polar sines
   detran_utilities::vec_dbl d_inv_sin;
 
+  /// Exponential evaluator
+  SP_exptable d_exp;
+
 };
 
 } // end namespace detran
@@ -24,6 +24,25 @@ inline void Equation_SC_MOC::solve(const size_t       region,
                                    double            &psi_out,
                                    moments_type      &phi,
                                    angular_flux_type &psi)
+{
+  // Preconditions.
+  Require(region < d_mesh->number_cells());
+
+  double sigma = d_sigma_t[region];
+  double A = (*d_exp)(sigma * length * d_inv_sin[d_polar]);
+  solve(region, length, width, A, source, psi_in, psi_out, phi, psi);
+}
+
+//---------------------------------------------------------------------------//
+inline void Equation_SC_MOC::solve(const size_t       region,
+                                   const double       length,
+                                   const double       width,
+                                   const double       A,
+                                   moments_type      &source,
+                                   double            &psi_in,
+                                   double            &psi_out,
+                                   moments_type      &phi,
+                                   angular_flux_type &psi)
 {
   using std::cout;
   using std::endl;
@@ -31,12 +50,11 @@ inline void Equation_SC_MOC::solve(const size_t       region,
   // Preconditions.
   Require(region < d_mesh->number_cells());
 
-  double sigma = d_material->sigma_t(d_mat_map[region], d_g);
+  double sigma = d_sigma_t[region];
   double length_over_sin = length * d_inv_sin[d_polar];
   double inv_volume = 1.0 / d_mesh->volume(region);
 
   // Coefficients from Hebert.
-  double A = std::exp(-sigma * length_over_sin);
   double B = (1.0 - A) / sigma;
   double C = (length_over_sin / sigma) * (1.0 - B / length_over_sin);
   //double C = (length_over_sin / sigma) * (1.0 - (1.0-A)/(length_over_sin*sigma));
@@ -28,6 +28,8 @@ void Equation_SD_1D::setup_group(const size_t g)
 {
   Require(g < d_material->number_groups());
   d_g = g;
+  d_material->expand(detran_material::Material::SIGMA_T, g,
+                     d_mat_map, d_sigma_t);
 }
 
 //---------------------------------------------------------------------------//
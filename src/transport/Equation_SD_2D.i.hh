@@ -32,7 +32,7 @@ inline void Equation_SD_2D::solve(const size_t i,
 
   // Compute cell-center angular flux.
   int cell = d_mesh->index(i, j);
-  double coef = 1.0 / (d_material->sigma_t(d_mat_map[cell], d_g) +
+  double coef = 1.0 / (d_sigma_t[cell] +
                        d_coef_x[i] + d_coef_y[j]);
   double psi_center = coef * (source[cell] + d_coef_x[i] * psi_in[Mesh::VERT] +
                                              d_coef_y[j] * psi_in[Mesh::HORZ] );
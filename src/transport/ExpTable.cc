@@ -0,0 +1,113 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  ExpTable.cc
+ *  @brief ExpTable member definitions
+ *  @note  Copyright (C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#include "transport/ExpTable.hh"
+#include <string>
+
+namespace detran
+{
+
+//----------------------------------------------------------------------------//
+ExpTable::ExpTable(const int type, const double max_error)
+  : d_type(type)
+  , d_max_error(max_error)
+  , d_max_argument(0.0)
+  , d_inv_spacing(0.0)
+  , d_order(0)
+{
+  Insist(d_type >= 0 && d_type < END_EXP_TYPES,
+         "Unknown exponential evaluation type.");
+  Insist(d_max_error > 0.0 && d_max_error < 1.0,
+         "The exponential error bound must be in (0, 1).");
+
+  // Beyond this, zero is within the error bound.
+  d_max_argument = -std::log(d_max_error);
+
+  if (d_type == TABLE)
+    build_table();
+  else if (d_type == RATIONAL)
+    build_rational();
+}
+
+//----------------------------------------------------------------------------//
+ExpTable::SP_exptable ExpTable::Create(SP_input input)
+{
+  Require(input);
+  int type = EXACT;
+  double max_error = 1.0e-8;
+  if (input->check("moc_exp_type"))
+  {
+    std::string t = input->get<std::string>("moc_exp_type");
+    if (t == "exact")
+      type = EXACT;
+    else if (t == "table")
+      type = TABLE;
+    else if (t == "rational")
+      type = RATIONAL;
+    else
+      THROW("Unknown moc_exp_type: " + t);
+  }
+  if (input->check("moc_exp_max_error"))
+    max_error = input->get<double>("moc_exp_max_error");
+  SP_exptable p(new ExpTable(type, max_error));
+  return p;
+}
+
+//----------------------------------------------------------------------------//
+void ExpTable::build_table()
+{
+  // Linear interpolation of f has error at most h^2 max|f''| / 8, and
+  // max|f''| = 1 for f(x) = exp(-x) on x >= 0.
+  double h = std::sqrt(8.0 * d_max_error);
+  size_t n = (size_t) std::ceil(d_max_argument / h) + 1;
+  h = d_max_argument / (n - 1);
+  d_inv_spacing = 1.0 / h;
+  d_table.resize(2 * n, 0.0);
+  for (size_t i = 0; i < n; ++i)
+    d_table[2 * i] = std::exp(-(i * h));
+  for (size_t i = 0; i + 1 < n; ++i)
+    d_table[2 * i + 1] = d_table[2 * i + 2] - d_table[2 * i];
+}
+
+//----------------------------------------------------------------------------//
+void ExpTable::build_rational()
+{
+  // The [m/m] Padé approximant of exp(-r) has a leading error term
+  // (m!)^2 / ((2m)! (2m+1)!) r^(2m+1), which is largest at r = ln(2).
+  // Since exp(-x) = 2^(-n) exp(-r), the bound holds for all x.
+  const double ln2 = 0.6931471805599453;
+  const int max_order = 7;
+  double factor = 1.0;
+  for (d_order = 1; d_order < max_order; ++d_order)
+  {
+    int m = d_order;
+    // factor(m) = factor(m-1) * m^2 / ((2m)(2m-1)(2m)(2m+1))
+    factor *= double(m * m) / (2.0 * m * (2 * m - 1) * 2.0 * m * (2 * m + 1));
+    if (factor * std::pow(ln2, 2 * m + 1) <= d_max_error) break;
+  }
+
+  // Coefficients of P(r), where exp(-r) ~ P(-r) / P(r).
+  d_coef.resize(d_order + 1, 1.0);
+  for (int k = 0; k < d_order; ++k)
+  {
+    d_coef[k + 1] = d_coef[k] * (d_order - k) /
+                    ((2.0 * d_order - k) * (k + 1.0));
+  }
+
+  // Scaling factors for every n reachable below the cutoff.
+  size_t n = (size_t)(d_max_argument / ln2) + 2;
+  d_pow2.resize(n, 1.0);
+  for (size_t i = 1; i < n; ++i)
+    d_pow2[i] = 0.5 * d_pow2[i - 1];
+}
+
+} // end namespace detran
+
+//----------------------------------------------------------------------------//
+//              end of ExpTable.cc
+//----------------------------------------------------------------------------//
@@ -0,0 +1,161 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  ExpTable.hh
+ *  @brief ExpTable class definition
+ *  @note  Copyright (C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_EXPTABLE_HH_
+#define detran_EXPTABLE_HH_
+
+#include "transport/transport_export.hh"
+#include "utilities/DBC.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/InputDB.hh"
+#include "utilities/SP.hh"
+#include <cmath>
+
+namespace detran
+{
+
+/**
+ *  @class ExpTable
+ *  @brief Evaluates \f$ e^{-x} \f$ for \f$ x \ge 0 \f$
+ *
+ *  Characteristic methods evaluate an exponential for every segment of
+ *  every track, angle, and group.  This class provides cheaper
+ *  alternatives to the library exponential, each with an absolute error
+ *  no larger than a user-specified bound:
+ *    - EXACT, which calls std::exp
+ *    - TABLE, which linearly interpolates a table with spacing
+ *      \f$ h = \sqrt{8\epsilon} \f$
+ *    - RATIONAL, which reduces the argument to \f$ x = n \ln 2 + r \f$
+ *      and evaluates the \f$ [m/m] \f$ Padé approximant of \f$ e^{-r} \f$,
+ *      with \f$ m \f$ the smallest order meeting the bound
+ *
+ *  Both approximations return zero beyond \f$ x = -\ln \epsilon \f$.
+ *  The table has an absolute error, so very thin segments lose relative
+ *  accuracy in \f$ 1 - e^{-x} \f$; the rational form does not, since
+ *  its error vanishes as \f$ r^{2m+1} \f$.  The rational form still
+ *  has a cutoff branch and looks up \f$ 2^{-n} \f$ in a short table of
+ *  powers, but it needs no interpolation table sized by the error bound.
+ *
+ *  Relevant input database entries:
+ *    - moc_exp_type [str]          (exact, table, or rational)
+ *    - moc_exp_max_error [dbl]     (absolute error bound; default 1e-8)
+ */
+/**
+ *  @example transport/test/test_ExpTable.cc
+ *  @brief   Test of ExpTable class
+ */
+class TRANSPORT_EXPORT ExpTable
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // ENUMERATIONS
+  //--------------------------------------------------------------------------//
+
+  enum EXP_TYPES
+  {
+    EXACT, TABLE, RATIONAL, END_EXP_TYPES
+  };
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<ExpTable>        SP_exptable;
+  typedef detran_utilities::InputDB::SP_input   SP_input;
+  typedef detran_utilities::vec_dbl             vec_dbl;
+  typedef detran_utilities::size_t              size_t;
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //--------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param type         Evaluation type
+   *  @param max_error    Bound on the absolute error (for approximations)
+   */
+  ExpTable(const int type = EXACT, const double max_error = 1.0e-8);
+
+  /// SP constructor from user input
+  static SP_exptable Create(SP_input input);
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  /// Evaluate \f$ e^{-x} \f$ for \f$ x \ge 0 \f$
+  inline double operator()(const double x) const;
+
+  /// Evaluation type
+  int type() const { return d_type; }
+
+  /// Bound on the absolute error
+  double max_error() const { return d_max_error; }
+
+  /// Order of the rational approximant (zero unless RATIONAL)
+  int order() const { return d_order; }
+
+  /// Number of table points (zero unless TABLE)
+  size_t table_size() const { return d_table.size() / 2; }
+
+private:
+
+  //--------------------------------------------------------------------------//
+  // DATA
+  //--------------------------------------------------------------------------//
+
+  /// Evaluation type
+  int d_type;
+  /// Absolute error bound
+  double d_max_error;
+  /// Argument beyond which zero is returned
+  double d_max_argument;
+  /// Inverse table spacing
+  double d_inv_spacing;
+  /// Table values and slopes, interleaved for locality
+  vec_dbl d_table;
+  /// Order of the rational approximant
+  int d_order;
+  /// Padé coefficients
+  vec_dbl d_coef;
+  /// Powers \f$ 2^{-n} \f$ for the range reduction
+  vec_dbl d_pow2;
+
+  //--------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //--------------------------------------------------------------------------//
+
+  /// Build the interpolation table.
+  void build_table();
+
+  /// Choose an order and build the rational approximant.
+  void build_rational();
+
+  /// Interpolate the table.
+  inline double exp_table(const double x) const;
+
+  /// Evaluate the rational approximation.
+  inline double exp_rational(const double x) const;
+
+};
+
+} // end namespace detran
+
+//----------------------------------------------------------------------------//
+// INLINE MEMBER DEFINITIONS
+//----------------------------------------------------------------------------//
+
+#include "ExpTable.i.hh"
+
+#endif /* detran_EXPTABLE_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of ExpTable.hh
+//----------------------------------------------------------------------------//
@@ -0,0 +1,59 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  ExpTable.i.hh
+ *  @brief ExpTable inline member definitions
+ *  @note  Copyright (C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_EXPTABLE_I_HH_
+#define detran_EXPTABLE_I_HH_
+
+namespace detran
+{
+
+//----------------------------------------------------------------------------//
+inline double ExpTable::operator()(const double x) const
+{
+  Require(x >= 0.0);
+  if (d_type == TABLE)
+    return exp_table(x);
+  else if (d_type == RATIONAL)
+    return exp_rational(x);
+  return std::exp(-x);
+}
+
+//----------------------------------------------------------------------------//
+inline double ExpTable::exp_table(const double x) const
+{
+  if (x >= d_max_argument) return 0.0;
+  double s = x * d_inv_spacing;
+  int i = (int) s;
+  return d_table[2 * i] + (s - i) * d_table[2 * i + 1];
+}
+
+//----------------------------------------------------------------------------//
+inline double ExpTable::exp_rational(const double x) const
+{
+  if (x >= d_max_argument) return 0.0;
+  // x = n ln(2) + r, with 0 <= r < ln(2)
+  int n = (int) (x * 1.4426950408889634);
+  double r = x - n * 0.6931471805599453;
+  // Horner for P(r) and P(-r)
+  double num = d_coef[d_order];
+  double den = d_coef[d_order];
+  for (int k = d_order - 1; k >= 0; --k)
+  {
+    num = d_coef[k] - r * num;
+    den = d_coef[k] + r * den;
+  }
+  return d_pow2[n] * num / den;
+}
+
+} // end namespace detran
+
+#endif /* detran_EXPTABLE_I_HH_ */
+
+//----------------------------------------------------------------------------//
+//              end of ExpTable.i.hh
+//----------------------------------------------------------------------------//
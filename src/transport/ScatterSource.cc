@@ -7,6 +7,7 @@
 //----------------------------------------------------------------------------//
 
 #include "ScatterSource.hh"
+#include <algorithm>
 
 namespace detran
 {
@@ -27,6 +28,66 @@ ScatterSource::ScatterSource(SP_mesh     mesh,
   d_adjoint = d_state->adjoint();
 }
 
+//----------------------------------------------------------------------------//
+void ScatterSource::build_total_source(const groups_t                &groups,
+                                       const size_t                   g_cutoff,
+                                       const State::vec_moments_type &phi,
+                                       State::vec_moments_type       &s)
+{
+  Require(phi.size() == d_material->number_groups());
+  Require(s.size() == d_material->number_groups());
+
+  size_t number_groups = groups.size();
+  if (!number_groups) return;
+
+  // For each group, the incident groups are those between the cutoff and
+  // the upper bound (see build_total_group_source), clipped to the part of
+  // the scattering row that is stored.
+  vec_size_t first(number_groups, 0);
+  vec_size_t last(number_groups, 0);
+  size_t g_min = d_material->number_groups();
+  size_t g_max = 0;
+  for (size_t i = 0; i < number_groups; ++i)
+  {
+    size_t g = groups[i];
+    size_t u = upper(g);
+    first[i] = std::max(std::min(g_cutoff, u),
+                        d_material->row_first(g, d_adjoint));
+    last[i]  = std::min(std::max(g_cutoff, u),
+                        d_material->row_last(g, d_adjoint));
+    g_min = std::min(g_min, first[i]);
+    g_max = std::max(g_max, last[i]);
+  }
+
+  int number_cells = d_mesh->number_cells();
+
+  #pragma omp parallel default(shared)
+  {
+    // Fluxes of one cell for all contributing groups
+    detran_utilities::vec_dbl phi_cell(d_material->number_groups(), 0.0);
+
+    #pragma omp for
+    for (int cell = 0; cell < number_cells; ++cell)
+    {
+      size_t m = d_mat_map[cell];
+      for (size_t gp = g_min; gp <= g_max; ++gp)
+        phi_cell[gp] = phi[gp][cell];
+
+      for (size_t i = 0; i < number_groups; ++i)
+      {
+        size_t g = groups[i];
+        if (first[i] > last[i]) continue;
+        const double *row = d_material->sigma_s_row(m, g, d_adjoint);
+        size_t offset = d_material->row_first(g, d_adjoint);
+        double q = 0.0;
+        for (size_t gp = first[i]; gp <= last[i]; ++gp)
+          q += row[gp - offset] * phi_cell[gp];
+        s[g][cell] += q;
+      }
+    }
+  }
+}
+
 } // end namespace detran
 
 //----------------------------------------------------------------------------//
@@ -150,6 +150,26 @@ public:
                                 const State::vec_moments_type &phi,
                                 moments_type                  &s);
 
+  /**
+   *  @brief Build the total scatter source for a block of groups.
+   *
+   *  This is equivalent to calling build_total_group_source for each
+   *  group in the block, but the cells are visited once.  For each cell,
+   *  the fluxes of all contributing groups are gathered and the material's
+   *  scattering rows are applied for every group in the block, so the
+   *  inner loop runs over contiguous groups rather than over cells
+   *  through the material map.
+   *
+   *  @param   groups   Groups for which sources are built.
+   *  @param   g_cutoff Highest group to contribute to downscatter.
+   *  @param   phi      Const reference to multigroup flux moments.
+   *  @param   s        Mutable reference to multigroup moments sources.
+   */
+  void build_total_source(const groups_t                &groups,
+                          const size_t                   g_cutoff,
+                          const State::vec_moments_type &phi,
+                          State::vec_moments_type       &s);
+
 protected:
 
   //--------------------------------------------------------------------------//
@@ -21,9 +21,10 @@ build_within_group_source(const size_t        g,
   Require(g < d_material->number_groups());
   Require(phi.size() == s.size());
 
+  const double *sigma_s = d_material->sigma_s_band(g, g);
   for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
   {
-    s[cell] += phi[cell] * d_material->sigma_s(d_mat_map[cell], g, g);
+    s[cell] += phi[cell] * sigma_s[d_mat_map[cell]];
   }
 }
 
@@ -40,10 +41,11 @@ build_in_scatter_source(const size_t  g,
     if (g == *gp) continue;
     const size_t g_f = g_from(g, *gp);
     const size_t g_t = g_to(g, *gp);
+    const double *sigma_s = d_material->sigma_s_band(g_t, g_f);
     const moments_type &phi = d_state->phi(*gp);
     for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
     {
-      s[cell] += phi[cell] * d_material->sigma_s(d_mat_map[cell], g_t, g_f);
+      s[cell] += phi[cell] * sigma_s[d_mat_map[cell]];
     }
   }
 }
@@ -62,10 +64,11 @@ build_downscatter_source(const size_t  g,
   {
     const size_t g_f = g_from(g, *gp);
     const size_t g_t = g_to(g, *gp);
+    const double *sigma_s = d_material->sigma_s_band(g_t, g_f);
     moments_type &phi = d_state->phi(*gp);
     for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
     {
-      s[cell] += phi[cell] * d_material->sigma_s(d_mat_map[cell], g_t, g_f);
+      s[cell] += phi[cell] * sigma_s[d_mat_map[cell]];
     }
   }
 }
@@ -84,10 +87,10 @@ build_total_group_source(const size_t                   g,
   {
     const size_t g_f = g_from(g, *gp);
     const size_t g_t = g_to(g, *gp);
+    const double *sigma_s = d_material->sigma_s_band(g_t, g_f);
     for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
     {
-      s[cell] += phi[*gp][cell] *
-                 d_material->sigma_s(d_mat_map[cell], g_t, g_f);
+      s[cell] += phi[*gp][cell] * sigma_s[d_mat_map[cell]];
     }
   }
 }
@@ -10,6 +10,7 @@
 #include "State.hh"
 #include <iostream>
 #include <cstdio>
+#include <string>
 
 namespace detran
 {
@@ -70,9 +71,25 @@ State::State(SP_input        input,
   {
     Insist(d_quadrature, "Angular flux requested but no quadrature given.");
     d_store_angular_flux = true;
-    d_angular_flux.resize(d_number_groups,
-                          vec_moments_type(d_quadrature->number_angles(),
-			               moments_type(d_mesh->number_cells(), 0.0)));
+    AngularFluxArena::PRECISION precision = AngularFluxArena::DOUBLE;
+    if (input->check("angular_flux_precision"))
+    {
+      std::string p = input->get<std::string>("angular_flux_precision");
+      Insist(p == "double" || p == "single",
+             "angular_flux_precision must be double or single.");
+      if (p == "single") precision = AngularFluxArena::SINGLE;
+    }
+    vec_int groups;
+    if (input->check("angular_flux_groups"))
+      groups = input->get<vec_int>("angular_flux_groups");
+    d_angular_flux = AngularFluxArena(d_number_groups,
+                                      d_quadrature->number_angles(),
+                                      d_mesh->number_cells(),
+                                      precision,
+                                      groups);
+    // Nonresident groups are recovered from the moments
+    d_MtoD = detran_angle::MomentToDiscrete::Create(d_momentindexer,
+                                                    d_quadrature);
   }
 
   // Check for adjoint calculation
@@ -88,15 +105,9 @@ void State::clear()
     for (size_t i = 0; i < d_mesh->number_cells(); ++i)
     {
       d_moments[g][i] = 0.0;
-      if (d_store_angular_flux)
-      {
-        for (size_t a = 0; a < d_quadrature->number_angles(); ++a)
-        {
-          d_angular_flux[g][a][i] = 0.0;
-        }
-      }
     }
   }
+  d_angular_flux.clear();
 }
 
 //---------------------------------------------------------------------------//
@@ -107,15 +118,9 @@ void State::scale(const double f)
     for (size_t i = 0; i < d_mesh->number_cells(); ++i)
     {
       d_moments[g][i] *= f;
-      if (d_store_angular_flux)
-      {
-        for (size_t a = 0; a < d_quadrature->number_angles(); ++a)
-        {
-          d_angular_flux[g][a][i] *= f;
-        }
-      }
     }
   }
+  d_angular_flux.scale(f);
 }
 
 //---------------------------------------------------------------------------//
@@ -159,38 +164,44 @@ void State::display() const
 
   if (d_store_angular_flux)
   {
+    size_t number_angles = d_quadrature->number_angles();
     printf("\n");
-    for (size_t a = 0; a < d_angular_flux[0].size() + 1; a++)
+    for (size_t a = 0; a < number_angles + 1; a++)
       printf("--------------");
     printf("\n");
     printf("Discrete Angular Flux\n");
-    for (size_t a = 0; a < d_angular_flux[0].size() + 1; a++)
+    for (size_t a = 0; a < number_angles + 1; a++)
       printf("--------------");
     printf("\n");
 
     for (size_t g = 0; g < d_number_groups; g++)
     {
+      // Gather (or recover) the group flux in angle order
+      std::vector<angular_flux_type> psi_g(number_angles);
+      for (size_t o = 0; o < d_quadrature->number_octants(); o++)
+        for (size_t a = 0; a < d_quadrature->number_angles_octant(); a++)
+          psi_g[d_quadrature->index(o, a)] = psi(g, o, a);
+
       printf("group %4i \n", g);
       printf("cell \\ a");
-      for (size_t a = 0; a < d_angular_flux[g].size(); a++)
+      for (size_t a = 0; a < number_angles; a++)
         printf(" %12i ", a);
       printf("\n");
-      for (size_t a = 0; a < d_angular_flux[0].size() + 1; a++)
+      for (size_t a = 0; a < number_angles + 1; a++)
         printf("--------------");
       printf("\n");
       for (size_t i = 0; i < d_mesh->number_cells(); i++)
       {
         printf("%10i", i);
-        for (size_t a = 0; a < d_angular_flux[g].size(); a++)
+        for (size_t a = 0; a < number_angles; a++)
         {
-          printf(" %12.5e ", d_angular_flux[g][a][i]);
+          printf(" %12.5e ", psi_g[a][i]);
         }
         printf("\n");
       }
       printf("\n");
     }
   }
-
 }
 
 } // end namespace detran
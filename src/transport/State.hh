@@ -11,8 +11,10 @@
 #define detran_STATE_HH_
 
 #include "transport/transport_export.hh"
+#include "transport/AngularFluxArena.hh"
 #include "angle/Quadrature.hh"
 #include "angle/MomentIndexer.hh"
+#include "angle/MomentToDiscrete.hh"
 #include "geometry/Mesh.hh"
 #include "utilities/Definitions.hh"
 #include "utilities/InputDB.hh"
@@ -33,9 +35,17 @@ namespace detran
  *  typically what we need (e.g. doses or fission rates).  For eigenvalue
  *  problems, keff is also included.
  *
+ *  The angular flux, if stored, lives in a single contiguous arena.
+ *  It may be kept in single precision, and only some groups may be
+ *  kept resident.  The flux of any other group is recovered on request
+ *  from its flux moments, which is exact for isotropic angular fluxes
+ *  and otherwise limited to the moment order.
+ *
  *  Relevant input entries:
  *  - number_groups (int)
  *  - store_angular_flux (int)
+ *  - angular_flux_precision (string: "double" [default] or "single")
+ *  - angular_flux_groups (vec_int: resident groups [default all])
  */
 //---------------------------------------------------------------------------//
 class TRANSPORT_EXPORT State
@@ -52,12 +62,14 @@ public:
   typedef detran_geometry::Mesh::SP_mesh                SP_mesh;
   typedef detran_angle::Quadrature::SP_quadrature       SP_quadrature;
   typedef detran_angle::MomentIndexer::SP_momentindexer SP_momentindexer;
+  typedef detran_angle::MomentToDiscrete::SP_MtoD       SP_MtoD;
   typedef detran_utilities::vec_dbl                     moments_type;
   typedef std::vector<moments_type>                     vec_moments_type;
   typedef std::vector<moments_type>                     group_moments_type;
   typedef detran_utilities::vec_dbl                     angular_flux_type;
   typedef std::vector<std::vector<angular_flux_type> >  vec_angular_flux_type;
   typedef detran_utilities::vec_dbl                     vec_dbl;
+  typedef detran_utilities::vec_int                     vec_int;
   typedef detran_utilities::size_t                      size_t;
 
   //-------------------------------------------------------------------------//
@@ -116,23 +128,41 @@ public:
   void set_moments(const size_t g, std::vector<double>& f);
 
   /**
-   *  @brief Const accessor to a group angular flux.
+   *  @brief Copy of a group angular flux.
+   *
+   *  For groups that are not resident, the flux is recovered from
+   *  the flux moments.
+   *
    *  @param    g   Group of field requested.
    *  @param    o   Octant
    *  @param    a   Angle within octant
-   *  @return       Constant reference to group angular flux vector.
+   *  @return       Group angular flux vector.
    */
-  const angular_flux_type& psi(const size_t g,
-                               const size_t o,
-                               const size_t a) const;
+  angular_flux_type psi(const size_t g,
+                        const size_t o,
+                        const size_t a) const;
+
   /**
-   *  @brief Mutable accessor to a group angular flux.
-   *  @param    g   Group of field requested.
-   *  @param    o   Octant
-   *  @param    a   Angle within octant
-   *  @return       Mutable reference to group angular flux vector.
+   *  @brief Set a group angular flux.
+   *
+   *  This does nothing for groups that are not resident.
+   *
+   *  @param    g     Group of field requested.
+   *  @param    o     Octant
+   *  @param    a     Angle within octant
+   *  @param    psi   Group angular flux vector.
    */
-  angular_flux_type& psi(const size_t g, const size_t o, const size_t a);
+  void set_psi(const size_t             g,
+               const size_t             o,
+               const size_t             a,
+               const angular_flux_type &psi);
+
+  /// Direct access to the angular flux storage, e.g. for strided views
+  AngularFluxArena& angular_flux()
+  {
+    Require(d_store_angular_flux);
+    return d_angular_flux;
+  }
 
   /// Const accessor to a group current field.
   const moments_type& current(const size_t g) const;
@@ -225,7 +255,9 @@ private:
   /// Cell-center scalar flux moments, [energy, (space-moment)]
   vec_moments_type d_moments;
   /// Cell-center angular flux, [energy, angle, (space)]
-  vec_angular_flux_type d_angular_flux;
+  AngularFluxArena d_angular_flux;
+  /// Moments-to-discrete operator for recovering nonresident groups
+  SP_MtoD d_MtoD;
   /// Cell-center current magnitude, e.g. sqrt(Jx^2+Jy^2)
   vec_moments_type d_current;
   /// k-eigenvalue
@@ -60,28 +60,43 @@ inline void State::set_moments(const size_t g, std::vector<double>& f)
 }
 
 //---------------------------------------------------------------------------//
-inline const State::angular_flux_type&
+inline State::angular_flux_type
 State::psi(const size_t g, const size_t o, const size_t a) const
 {
   Require(d_store_angular_flux);
-  Require(d_angular_flux.size() > 0);
   Require(o < d_quadrature->number_octants());
   Require(a < d_quadrature->number_angles_octant());
   Require(g < d_number_groups);
   int angle = d_quadrature->index(o, a);
-  return d_angular_flux[g][angle];
+  angular_flux_type f;
+  if (d_angular_flux.is_resident(g))
+  {
+    d_angular_flux.get(g, angle, f);
+    return f;
+  }
+  // Recover the flux from the moments, ordered [moment, cell]
+  size_t number_cells = d_mesh->number_cells();
+  f.assign(number_cells, 0.0);
+  for (size_t m = 0; m < d_number_moments; ++m)
+  {
+    double mtod = (*d_MtoD)(angle, m);
+    for (size_t i = 0; i < number_cells; ++i)
+      f[i] += mtod * d_moments[g][m * number_cells + i];
+  }
+  return f;
 }
 
 //---------------------------------------------------------------------------//
-inline State::angular_flux_type&
-State::psi(const size_t g, const size_t o, const size_t a)
+inline void State::set_psi(const size_t             g,
+                           const size_t             o,
+                           const size_t             a,
+                           const angular_flux_type &psi)
 {
-  // Cast away return type
-  return const_cast<angular_flux_type&>
-  (
-    // Add const to *this's type and call const version
-    static_cast<const State*>(this)->psi(g, o, a)
-  );
+  Require(d_store_angular_flux);
+  Require(o < d_quadrature->number_octants());
+  Require(a < d_quadrature->number_angles_octant());
+  Require(g < d_number_groups);
+  d_angular_flux.set(g, d_quadrature->index(o, a), psi);
 }
 
 //---------------------------------------------------------------------------//
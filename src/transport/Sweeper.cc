@@ -8,6 +8,9 @@
 //---------------------------------------------------------------------------//
 
 #include "Sweeper.t.hh"
+#ifdef DETRAN_ENABLE_OPENMP
+#include <omp.h>
+#endif
 
 namespace detran
 {
@@ -31,6 +34,7 @@ Sweeper<D>::Sweeper(SP_input input,
   , d_adjoint(false)
   , d_number_sweeps(0)
   , d_update_boundary(false)
+  , d_single_precision(false)
   , d_ordered_octants(std::pow((float)2, (int)D::dimension), 0)
 {
   Require(d_input);
@@ -109,6 +113,22 @@ bool Sweeper<D>::is_adjoint() const
   return d_adjoint;
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+void Sweeper<D>::set_single_precision(const bool v)
+{
+  Insist(!v || has_single_precision(),
+         "Single precision sweeps are not available for this sweeper.");
+  d_single_precision = v;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+bool Sweeper<D>::single_precision() const
+{
+  return d_single_precision;
+}
+
 //---------------------------------------------------------------------------//
 template <class D>
 void Sweeper<D>::set_tally(SP_tally tally)
@@ -215,6 +235,91 @@ void Sweeper<D>::setup_octant_indices(SP_boundary boundary)
 
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+void Sweeper<D>::setup_thread_fluxes()
+{
+#ifdef DETRAN_ENABLE_OPENMP
+  // Pad by a cache line, so the last cells of one buffer do not share a
+  // line with the start of the next allocation.
+  const size_t line = 64 / sizeof(double);
+  size_t n = d_mesh->number_cells() + line;
+  size_t number_threads = omp_get_max_threads();
+  if (d_thread_phi.size() < number_threads)
+    d_thread_phi.resize(number_threads);
+  for (size_t t = 0; t < d_thread_phi.size(); ++t)
+    if (d_thread_phi[t].size() != n) d_thread_phi[t].resize(n, 0.0);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+typename Sweeper<D>::moments_type&
+Sweeper<D>::thread_flux(moments_type &phi)
+{
+#ifdef DETRAN_ENABLE_OPENMP
+  Require(omp_get_thread_num() < d_thread_phi.size());
+  moments_type &phi_t = d_thread_phi[omp_get_thread_num()];
+  phi_t.assign(phi_t.size(), 0.0);
+  return phi_t;
+#else
+  return phi;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void Sweeper<D>::reduce_thread_fluxes(moments_type &phi)
+{
+#ifdef DETRAN_ENABLE_OPENMP
+  int number_threads = omp_get_num_threads();
+  int number_cells   = d_mesh->number_cells();
+  #pragma omp barrier
+  #pragma omp for schedule(static)
+  for (int i = 0; i < number_cells; ++i)
+  {
+    double v = 0.0;
+    for (int t = 0; t < number_threads; ++t)
+      v += d_thread_phi[t][i];
+    phi[i] += v;
+  }
+#endif
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void Sweeper<D>::setup_thread_psi(const size_t number_per_thread)
+{
+  size_t number_threads = 1;
+#ifdef DETRAN_ENABLE_OPENMP
+  number_threads = omp_get_max_threads();
+#endif
+  size_t n = d_update_psi ? d_mesh->number_cells() : 0;
+  if (d_thread_psi.size() < number_threads)
+    d_thread_psi.resize(number_threads);
+  for (size_t t = 0; t < d_thread_psi.size(); ++t)
+  {
+    if (d_thread_psi[t].size() < number_per_thread)
+      d_thread_psi[t].resize(number_per_thread);
+    for (size_t i = 0; i < d_thread_psi[t].size(); ++i)
+      if (d_thread_psi[t][i].size() != n) d_thread_psi[t][i].resize(n, 0.0);
+  }
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+std::vector<typename Sweeper<D>::angular_flux_type>&
+Sweeper<D>::thread_psi()
+{
+#ifdef DETRAN_ENABLE_OPENMP
+  Require(omp_get_thread_num() < d_thread_psi.size());
+  return d_thread_psi[omp_get_thread_num()];
+#else
+  Require(!d_thread_psi.empty());
+  return d_thread_psi[0];
+#endif
+}
+
 //---------------------------------------------------------------------------//
 // EXPLICIT INSTANTIATIONS
 //---------------------------------------------------------------------------//
@@ -47,6 +47,22 @@ namespace detran
  *  flux *moments* are updated, while the discrete angular flux is
  *  optionally stored.
  *
+ *  When threaded, each thread accumulates its share of the flux moments
+ *  into its own buffer.  The buffers persist across sweeps and are
+ *  summed into the result by a segmented reduction in which each thread
+ *  owns a contiguous block of cells.  The threads are summed in a fixed
+ *  order, so the result does not depend on scheduling.  Each buffer ends
+ *  in a cache line of unused padding, so its last cells do not share a
+ *  line with the start of the next allocation.  The buffers are not
+ *  aligned, though, so their first cells may share a line with whatever
+ *  precedes them.
+ *
+ *  Sweepers that support it can sweep in single precision.  Sources,
+ *  face fluxes, and the cell solves are then float, while the flux
+ *  moments are still accumulated in double precision.  This is never
+ *  the default; a solver switches it on for inner iterations whose
+ *  error it later removes by refinement in double precision.
+ *
  *  Relevant input database entries:
  *    - store_angular_flux [int]
  *    - equation [string]
@@ -150,6 +166,15 @@ public:
   /// Is adjoint?
   bool is_adjoint() const;
 
+  /// Can this sweeper sweep in single precision?
+  virtual bool has_single_precision() const { return false; }
+
+  /// Switch single precision sweeps on or off
+  void set_single_precision(const bool v);
+
+  /// Are sweeps in single precision?
+  bool single_precision() const;
+
   /// Set a boundary flux tally.
   void set_tally(SP_tally tally);
 
@@ -183,12 +208,18 @@ protected:
   size_t d_number_sweeps;
   /// Update the boundary on the fly?  Can't be used for Krylov.
   bool d_update_boundary;
+  /// Sweep in single precision?
+  bool d_single_precision;
   /// Current tally
   SP_tally d_tally;
   /// Spatial index ranges
   vec3_int d_space_ranges;
   /// Ordered octant indices
   vec_int d_ordered_octants;
+  /// Per-thread flux moment accumulators
+  std::vector<moments_type> d_thread_phi;
+  /// Per-thread angular flux scratch
+  std::vector<std::vector<angular_flux_type> > d_thread_psi;
 
   //-------------------------------------------------------------------------//
   // IMPLEMENTATION
@@ -203,6 +234,46 @@ protected:
   /// Setup octant sweep indices.
   void setup_octant_indices(SP_boundary);
 
+  /// Size the per-thread flux accumulators.  Call outside a parallel region.
+  void setup_thread_fluxes();
+
+  /**
+   *  @brief Get the zeroed flux accumulator for the calling thread.
+   *  @param phi    Flux moments, which are used directly when not threaded
+   */
+  moments_type& thread_flux(moments_type &phi);
+
+  /**
+   *  @brief Add the per-thread fluxes to the flux moments.
+   *
+   *  This must be called by every thread of the parallel region.  It
+   *  waits for all threads to finish their sweeps before summing.
+   *
+   *  @param phi    Flux moments to be updated
+   */
+  void reduce_thread_fluxes(moments_type &phi);
+
+  /**
+   *  @brief Size the per-thread angular flux scratch.
+   *
+   *  Each thread gets the given number of vectors, which hold one
+   *  angular flux apiece when psi is updated and are empty otherwise.
+   *  They persist across angles and sweeps.  Call outside a parallel
+   *  region.
+   *
+   *  @param number_per_thread  Angular fluxes each thread holds at once
+   */
+  void setup_thread_psi(const size_t number_per_thread = 1);
+
+  /**
+   *  @brief Get the angular flux scratch for the calling thread.
+   *
+   *  The vectors keep what the thread last wrote.  Equations that set
+   *  every cell can use them as is, while those that accumulate must
+   *  zero them first.
+   */
+  std::vector<angular_flux_type>& thread_psi();
+
 };
 
 } // end namespace detran
@@ -26,13 +26,14 @@ inline void Sweeper1D<EQ>::sweep(moments_type &phi)
   // Reset the flux moments
   phi.assign(phi.size(), 0.0);
 
-#ifdef DETRAN_ENABLE_OPENMP
-  moments_type phi_local;
-#else
-  moments_type &phi_local = phi;
-#endif
+  // Reset the boundary flux tally
+  if (d_tally) d_tally->reset(d_g);
 
-  #pragma omp parallel default(shared) private(phi_local)
+  // Size the thread flux accumulators.
+  setup_thread_fluxes();
+  setup_thread_psi();
+
+  #pragma omp parallel default(shared)
   {
 
   // Initialize equation and setup for this group.
@@ -40,10 +41,7 @@ inline void Sweeper1D<EQ>::sweep(moments_type &phi)
   equation.setup_group(d_g);
 
   // Reset the flux moments
-  phi_local.resize(d_mesh->number_cells(), 0.0);
-
-  // Reset the boundary flux tally
-  if (d_tally) d_tally->reset(d_g);
+  moments_type &phi_local = thread_flux(phi);
 
   // Initialize discrete sweep source vector.
   SweepSource<_1D>::sweep_source_type source(d_mesh->number_cells(), 0.0);
@@ -52,6 +50,9 @@ inline void Sweeper1D<EQ>::sweep(moments_type &phi)
   typename Equation_T::face_flux_type psi_in = 0.0;
   typename Equation_T::face_flux_type psi_out = 0.0;
 
+  // Angular flux scratch.  Every cell is written, so nothing is fetched.
+  State::angular_flux_type &psi = thread_psi()[0];
+
   // Reference to boundary to simplify clutter.
   Boundary_T &b = *d_boundary;
 
@@ -74,10 +75,6 @@ inline void Sweeper1D<EQ>::sweep(moments_type &phi)
       // Setup equation for this angle.
       equation.setup_angle(a);
 
-      // Get psi if update requested.
-      State::angular_flux_type psi;
-      if (d_update_psi) psi = d_state->psi(d_g, o, a);
-
       // Update the boundary for this angle.
       if (d_update_boundary) b.update(d_g, o, a);
 
@@ -99,7 +96,7 @@ inline void Sweeper1D<EQ>::sweep(moments_type &phi)
         psi_in = psi_out;
 
         // Solve the equation in this cell.
-        equation.solve(i, 0, 0, source, psi_in, psi_out, phi, psi);
+        equation.solve(i, 0, 0, source, psi_in, psi_out, phi_local, psi);
 
         // Tally the outgoing cell flux
         if (d_tally)
@@ -111,30 +108,19 @@ inline void Sweeper1D<EQ>::sweep(moments_type &phi)
       b(d_face_index[o][Mesh::VERT][Boundary_T::OUT], o, a, d_g) = psi_out;
 
       // Update the angular flux.
-      if (d_update_psi) d_state->psi(d_g, o, a) = psi;
+      if (d_update_psi) d_state->set_psi(d_g, o, a, psi);
 
     } // end angle loop
     // end omp do
 
   } // end octant loop
 
-#ifdef DETRAN_ENABLE_OPENMP
   // Sum local thread fluxes.
-  #pragma omp critical
-  {
-    for (int i = 0; i < d_mesh->number_cells(); i++)
-    {
-      phi[i] += phi_local[i];
-    }
-  }
-#endif
+  reduce_thread_fluxes(phi);
 
   } // end omp parallel
 
-  #pragma omp master
-  {
-    d_number_sweeps++;
-  }
+  d_number_sweeps++;
   return;
 }
 
@@ -26,9 +26,24 @@ Sweeper2D<EQ>::Sweeper2D(SP_input input,
                          SP_sweepsource sweepsource)
   : Base(input, mesh, material, quadrature, state, boundary, sweepsource)
   , d_boundary(boundary)
+  , d_wavefront(false)
+  , d_packets(false)
 {
-    // Preconditions
-    Require(d_boundary);
+  // Preconditions
+  Require(d_boundary);
+
+  if (d_input->check("sweeper_wavefront"))
+    d_wavefront = 0 != d_input->template get<int>("sweeper_wavefront");
+  if (d_wavefront) setup_wavefront();
+  if (d_input->check("sweeper_angle_packets"))
+    d_packets = 0 != d_input->template get<int>("sweeper_angle_packets");
+  if (d_packets)
+  {
+    Insist(Equation_T::has_packets(),
+           "Angle packets are not implemented for this equation.");
+    Insist(!d_wavefront,
+           "Angle packets cannot be combined with the wavefront sweep.");
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -47,6 +62,17 @@ Sweeper2D<EQ>::Create(SP_input       input,
   return p;
 }
 
+//---------------------------------------------------------------------------//
+template <class EQ>
+void Sweeper2D<EQ>::setup_wavefront()
+{
+  int nx = d_mesh->number_cells_x();
+  int ny = d_mesh->number_cells_y();
+  d_hyperplanes.resize(nx + ny - 1);
+  for (int jj = 0; jj < ny; ++jj)
+    for (int ii = 0; ii < nx; ++ii)
+      d_hyperplanes[ii + jj].push_back(ii);
+}
 
 //---------------------------------------------------------------------------//
 // EXPLICIT INSTANTIATIONS
@@ -19,6 +19,25 @@ namespace detran
 /**
  *  @class Sweeper2D
  *  @brief Sweeper for 2D discrete ordinates problems.
+ *
+ *  By default, threading is over the angles within an octant.  Low order
+ *  quadratures run out of angles long before fine meshes run out of cells,
+ *  so a wavefront mode is also available.  A cell depends only on its
+ *  upwind neighbors in x and y, so all cells on a hyperplane i + j = const
+ *  (relative to the sweep direction) can be solved concurrently.  The
+ *  hyperplanes are swept in order, and each one is solved for every angle
+ *  of the octant (or of all octants, when they are independent) at once.
+ *
+ *  For equations that support it, angles can also be swept in packets of
+ *  Equation::packet_size.  Each cell is then solved for all angles of the
+ *  packet at once, with sources and face fluxes stored lane-contiguous so
+ *  that the cell kernel vectorizes.  Threading is over packets.  Packets
+ *  can be swept in single precision, which doubles the lanes per vector
+ *  register and halves the bytes moved (see Sweeper).
+ *
+ *  Relevant input database entries:
+ *    - sweeper_wavefront [int]      (0 = angle threading, 1 = hyperplanes)
+ *    - sweeper_angle_packets [int]  (0 = one angle at a time, 1 = packets)
  */
 template <class EQ>
 class Sweeper2D: public Sweeper<_2D>
@@ -46,6 +65,7 @@ public:
   typedef typename Base::vec2_int                   vec2_int;
   typedef typename Base::vec3_int                   vec3_int;
   typedef typename Base::size_t                     size_t;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
   typedef EQ                                        Equation_T;
   typedef BoundarySN<_2D>                           Boundary_T;
   typedef typename Boundary_T::SP_boundary          SP_boundary;
@@ -93,6 +113,9 @@ public:
   /// Sweep.
   inline void sweep(moments_type &phi);
 
+  /// Packet sweeps can be done in single precision.
+  bool has_single_precision() const { return d_packets; }
+
 private:
 
   //-------------------------------------------------------------------------//
@@ -101,6 +124,34 @@ private:
 
   // SN boundary
   SP_boundary d_boundary;
+  /// Use the hyperplane wavefront sweep?
+  bool d_wavefront;
+  /// Cell x indices (relative to the sweep direction) on each hyperplane
+  vec2_int d_hyperplanes;
+  /// Angular flux scratch for each angle in flight
+  std::vector<angular_flux_type> d_wavefront_psi;
+  /// Sweep packets of angles?
+  bool d_packets;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Sweep along hyperplanes.
+  inline void sweep_wavefront(moments_type &phi);
+
+  /// Sweep packets of angles in precision T.
+  template <class T>
+  inline void sweep_packets(moments_type &phi);
+
+  /// Tally the incident boundary fluxes for an angle.
+  inline void tally_incident(const size_t   o,
+                             const size_t   a,
+                             const bf_type &psi_v,
+                             const bf_type &psi_h);
+
+  /// Build the hyperplanes.
+  void setup_wavefront();
 
 };
 
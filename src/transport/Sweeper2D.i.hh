@@ -10,6 +10,7 @@
 #ifndef detran_SWEEPER2D_I_HH_
 #define detran_SWEEPER2D_I_HH_
 
+#include <algorithm>
 #include <iostream>
 #ifdef DETRAN_ENABLE_OPENMP
 #include <omp.h>
@@ -22,17 +23,32 @@ namespace detran
 template <class EQ>
 inline void Sweeper2D<EQ>::sweep(moments_type &phi)
 {
+  // Switch to the wavefront sweep if requested.
+  if (d_wavefront)
+  {
+    sweep_wavefront(phi);
+    return;
+  }
+  if (d_packets)
+  {
+    if (d_single_precision)
+      sweep_packets<float>(phi);
+    else
+      sweep_packets<double>(phi);
+    return;
+  }
 
   // Reset the flux moments
   phi.assign(phi.size(), 0.0);
 
-#ifdef DETRAN_ENABLE_OPENMP
-  moments_type phi_local;
-#else
-  moments_type &phi_local = phi;
-#endif
+  // Reset the boundary flux tally
+  if (d_tally) d_tally->reset(d_g);
 
-  #pragma omp parallel default(shared) private(phi_local)
+  // Size the thread flux accumulators and angular flux scratch.
+  setup_thread_fluxes();
+  setup_thread_psi();
+
+  #pragma omp parallel default(shared)
   {
 
   // Initialize equation and setup for this group.
@@ -40,10 +56,10 @@ inline void Sweeper2D<EQ>::sweep(moments_type &phi)
   equation.setup_group(d_g);
 
   // Reset the flux moments
-  phi_local.resize(d_mesh->number_cells(), 0.0);
+  moments_type &phi_local = thread_flux(phi);
 
-  // Reset the boundary flux tally
-  if (d_tally) d_tally->reset(d_g);
+  // Angular flux scratch.  Every cell is written, so nothing is fetched.
+  State::angular_flux_type &psi = thread_psi()[0];
 
   // Initialize discrete sweep source vector.
   SweepSource<_2D>::sweep_source_type source(d_mesh->number_cells(), 0.0);
@@ -76,10 +92,6 @@ inline void Sweeper2D<EQ>::sweep(moments_type &phi)
       // Setup equation for this angle.
       equation.setup_angle(a);
 
-      // Get psi if needed.
-      State::angular_flux_type psi;
-      if (d_update_psi) psi = d_state->psi(d_g, o, a);
-
       // Update the boundary for this angle.
       if (d_update_boundary) b.update(d_g, o, a);
 
@@ -91,32 +103,8 @@ inline void Sweeper2D<EQ>::sweep(moments_type &phi)
       Equation<_2D>::face_flux_type psi_in  = {0.0, 0.0};
       Equation<_2D>::face_flux_type psi_out = {0.0, 0.0};
 
-      // Tally x-directed face
-      if (d_tally)
-      {
-        // Pick left or right side
-        size_t i = 0;
-        if (o == 1 || o == 2) i = d_mesh->number_cells_x() - 1;
-        // Loop over vertical
-        for (size_t jj = 0; jj < d_mesh->number_cells_y(); jj++)
-        {
-          size_t j = jj;
-          if (o > 1) j = d_mesh->number_cells_y() - j - 1;
-          d_tally->tally(i, j, 0,  d_g,  o, a,  Tally_T::X_DIRECTED, psi_v[j]);
-        }
-      }
-      // Tally y-directed face
-      if (d_tally)
-      {
-        size_t j = 0;
-        if (o > 1) j = d_mesh->number_cells_y() - 1;
-        for (size_t ii = 0; ii < d_mesh->number_cells_x(); ii++)
-        {
-          size_t i = ii;
-          if (o == 1 || o == 2) i = d_mesh->number_cells_x() - i - 1;
-          d_tally->tally(i, j, 0,  d_g,  o, a, Tally_T::Y_DIRECTED, psi_h[i]);
-        }
-      }
+      // Tally the incident fluxes.
+      if (d_tally) tally_incident(o, a, psi_v, psi_h);
 
       // Sweep over all y.
       int j  = d_space_ranges[o][1][0]; // actual index
@@ -156,29 +144,349 @@ inline void Sweeper2D<EQ>::sweep(moments_type &phi)
       b(face_H_o, o, a, d_g) = psi_h;
 
       // Update the angular flux.
-      if (d_update_psi) d_state->psi(d_g, o, a) = psi;
+      if (d_update_psi) d_state->set_psi(d_g, o, a, psi);
 
     } // end angle loop
     // end omp do
 
   } // end octant loop
 
-#ifdef DETRAN_ENABLE_OPENMP
   // Sum local thread fluxes.
-  #pragma omp critical
+  reduce_thread_fluxes(phi);
+
+  } // end omp parallel
+
+  d_number_sweeps++;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper2D<EQ>::sweep_wavefront(moments_type &phi)
+{
+  // Reset the flux moments
+  phi.assign(phi.size(), 0.0);
+
+  // Reset the boundary flux tally
+  if (d_tally) d_tally->reset(d_g);
+
+  // Reference to boundary to simplify clutter.
+  Boundary_T &b = *d_boundary;
+
+  // Octants are independent unless reflected fluxes are updated on the
+  // fly, in which case each octant waits for its predecessors.
+  vec2_int octants;
+  if (d_update_boundary && b.has_reflective())
+  {
+    for (size_t oo = 0; oo < 4; ++oo)
+      octants.push_back(vec_int(1, d_ordered_octants[oo]));
+  }
+  else
   {
-    for (int i = 0; i < d_mesh->number_cells(); i++)
+    octants.push_back(d_ordered_octants);
+  }
+
+  size_t na = d_quadrature->number_angles_octant();
+
+  for (size_t og = 0; og < octants.size(); ++og)
+  {
+    const vec_int &group = octants[og];
+    int number_angles = group.size() * na;
+
+    // Sources, angular fluxes, and working face fluxes for every angle
+    // in flight, indexed by oa = index of octant in group * na + a.  The
+    // angular fluxes persist across sweeps; every cell is written, so
+    // nothing is fetched from the state.
+    std::vector<vec_dbl>            source(number_angles);
+    std::vector<angular_flux_type> &psi = d_wavefront_psi;
+    std::vector<bf_type>            psi_v(number_angles);
+    std::vector<bf_type>            psi_h(number_angles);
+    if (psi.size() < group.size() * na) psi.resize(group.size() * na);
+
+    #pragma omp parallel for
+    for (int oa = 0; oa < number_angles; ++oa)
     {
-      phi[i] += phi_local[i];
+      size_t o = group[oa / na];
+      size_t a = oa % na;
+      source[oa].resize(d_mesh->number_cells(), 0.0);
+      d_sweepsource->source(d_g, o, a, source[oa]);
+      if (d_update_psi) psi[oa].resize(d_mesh->number_cells(), 0.0);
+      if (d_update_boundary) b.update(d_g, o, a);
+      psi_v[oa] = b(d_face_index[o][Mesh::VERT][Boundary_T::IN], o, a, d_g);
+      psi_h[oa] = b(d_face_index[o][Mesh::HORZ][Boundary_T::IN], o, a, d_g);
+      if (d_tally) tally_incident(o, a, psi_v[oa], psi_h[oa]);
     }
-  }
-#endif
+
+    // Size the thread flux accumulators.
+    setup_thread_fluxes();
+
+    #pragma omp parallel default(shared)
+    {
+
+    // Initialize equation and setup for this group.
+    Equation_T equation(d_mesh, d_material, d_quadrature, d_update_psi);
+    equation.setup_group(d_g);
+    int current_oa = -1;
+
+    // Reset the flux moments
+    moments_type &phi_local = thread_flux(phi);
+
+    // Temporary edge fluxes.
+    Equation<_2D>::face_flux_type psi_in  = {0.0, 0.0};
+    Equation<_2D>::face_flux_type psi_out = {0.0, 0.0};
+
+    // Cells on a hyperplane touch distinct rows and columns, so the face
+    // fluxes are updated in place.  Tasks are ordered by angle so that a
+    // static schedule rarely sets up a new angle.
+    for (size_t h = 0; h < d_hyperplanes.size(); ++h)
+    {
+      const vec_int &cells = d_hyperplanes[h];
+      int number_tasks = cells.size() * number_angles;
+
+      #pragma omp for schedule(static)
+      for (int task = 0; task < number_tasks; ++task)
+      {
+        int oa = task / cells.size();
+        size_t o = group[oa / na];
+        size_t a = oa % na;
+        if (oa != current_oa)
+        {
+          equation.setup_octant(o);
+          equation.setup_angle(a);
+          current_oa = oa;
+        }
+        int ii = cells[task % cells.size()];
+        int i  = d_space_ranges[o][0][0] + d_space_ranges[o][0][1] * ii;
+        int j  = d_space_ranges[o][1][0] + d_space_ranges[o][1][1] * (h - ii);
+
+        psi_in[Mesh::HORZ] = psi_h[oa][i];
+        psi_in[Mesh::VERT] = psi_v[oa][j];
+        equation.solve(i, j, 0, source[oa], psi_in, psi_out, phi_local, psi[oa]);
+        psi_h[oa][i] = psi_out[Mesh::HORZ];
+        psi_v[oa][j] = psi_out[Mesh::VERT];
+
+        if (d_tally) d_tally->tally(i, j, 0,  d_g,  o, a,  psi_out);
+      }
+    } // end hyperplane loop
+
+    // Sum local thread fluxes.
+    reduce_thread_fluxes(phi);
+
+    } // end omp parallel
+
+    // Update boundary and angular flux
+    for (int oa = 0; oa < number_angles; ++oa)
+    {
+      size_t o = group[oa / na];
+      size_t a = oa % na;
+      b(d_face_index[o][Mesh::VERT][Boundary_T::OUT], o, a, d_g) = psi_v[oa];
+      b(d_face_index[o][Mesh::HORZ][Boundary_T::OUT], o, a, d_g) = psi_h[oa];
+      if (d_update_psi) d_state->set_psi(d_g, o, a, psi[oa]);
+    }
+
+  } // end octant group loop
+
+  d_number_sweeps++;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+template <class T>
+inline void Sweeper2D<EQ>::sweep_packets(moments_type &phi)
+{
+  typedef typename EquationTraits<_2D, T>::packet_flux_type packet_flux_type;
+  const size_t P = Equation<_2D>::packet_size;
+
+  // Reset the flux moments
+  phi.assign(phi.size(), 0.0);
+
+  // Reset the boundary flux tally
+  if (d_tally) d_tally->reset(d_g);
+
+  // Reference to boundary to simplify clutter.
+  Boundary_T &b = *d_boundary;
+
+  size_t nx = d_mesh->number_cells_x();
+  size_t ny = d_mesh->number_cells_y();
+  size_t nc = d_mesh->number_cells();
+  size_t na = d_quadrature->number_angles_octant();
+  int number_packets = (na + P - 1) / P;
+
+  // Size the thread flux accumulators.
+  setup_thread_fluxes();
+
+  #pragma omp parallel default(shared)
+  {
+
+  // Initialize equation and setup for this group.
+  Equation_T equation(d_mesh, d_material, d_quadrature, d_update_psi);
+  equation.setup_group(d_g);
+
+  // Reset the flux moments
+  moments_type &phi_local = thread_flux(phi);
+
+  // Single angle sweep source, and packet sources, angular fluxes, and
+  // face fluxes, all stored as [index * P + lane] in the sweep precision.
+  SweepSource<_2D>::sweep_source_type source(nc, 0.0);
+  std::vector<T> q(nc * P, 0.0);
+  std::vector<T> psi_p(nc * P, 0.0);
+  State::angular_flux_type psi(d_update_psi ? nc : 0, 0.0);
+  std::vector<T> psi_v(ny * P, 0.0);
+  std::vector<T> psi_h(nx * P, 0.0);
+
+  // Temporary edge fluxes.
+  packet_flux_type psi_in, psi_out;
+  Equation<_2D>::face_flux_type psi_lane = {0.0, 0.0};
+
+  // Sweep over all octants
+  for (size_t oo = 0; oo < 4; oo++)
+  {
+    size_t o = d_ordered_octants[oo];
+
+    // Setup equation for this octant.
+    equation.setup_octant(o);
+
+    // Get face indices
+    const int face_V_i = d_face_index[o][Mesh::VERT][Boundary_T::IN];
+    const int face_H_i = d_face_index[o][Mesh::HORZ][Boundary_T::IN];
+    const int face_V_o = d_face_index[o][Mesh::VERT][Boundary_T::OUT];
+    const int face_H_o = d_face_index[o][Mesh::HORZ][Boundary_T::OUT];
+
+    // Sweep over all packets.
+    #pragma omp for
+    for (int p = 0; p < number_packets; ++p)
+    {
+      size_t a0 = p * P;
+      size_t n  = std::min(P, na - a0);
+
+      // Setup equation for this packet.
+      equation.setup_packet(a0, n);
+
+      // Gather the sources and incident fluxes of each angle into lanes.
+      // Unused lanes are zeroed so they stay finite.
+      for (size_t l = 0; l < P; ++l)
+      {
+        if (l >= n)
+        {
+          for (size_t c = 0; c < nc; ++c) q[c * P + l] = 0.0;
+          for (size_t j = 0; j < ny; ++j) psi_v[j * P + l] = 0.0;
+          for (size_t i = 0; i < nx; ++i) psi_h[i * P + l] = 0.0;
+          continue;
+        }
+        size_t a = a0 + l;
+        d_sweepsource->source(d_g, o, a, source);
+        for (size_t c = 0; c < nc; ++c) q[c * P + l] = source[c];
+        if (d_update_boundary) b.update(d_g, o, a);
+        const bf_type &b_v = b(face_V_i, o, a, d_g);
+        const bf_type &b_h = b(face_H_i, o, a, d_g);
+        for (size_t j = 0; j < ny; ++j) psi_v[j * P + l] = b_v[j];
+        for (size_t i = 0; i < nx; ++i) psi_h[i * P + l] = b_h[i];
+        if (d_tally) tally_incident(o, a, b_v, b_h);
+      }
+
+      // Sweep over all y.
+      int j  = d_space_ranges[o][1][0]; // actual index
+      int dj = d_space_ranges[o][1][1]; // decrement
+      for (size_t jj = 0; jj < ny; ++jj, j += dj)
+      {
+        for (size_t l = 0; l < P; ++l)
+          psi_out[Mesh::VERT][l] = psi_v[j * P + l];
+
+        // Sweep over all x.
+        int i  = d_space_ranges[o][0][0]; // actual index
+        int di = d_space_ranges[o][0][1]; // decrement
+        for (size_t ii = 0; ii < nx; ++ii, i += di)
+        {
+          // Set the incident cell surface fluxes.
+          for (size_t l = 0; l < P; ++l)
+          {
+            psi_in[Mesh::HORZ][l] = psi_h[i * P + l];
+            psi_in[Mesh::VERT][l] = psi_out[Mesh::VERT][l];
+          }
+
+          // Solve the equation in this cell for all lanes.
+          equation.solve_packet(i, j, 0, &q[0], psi_in, psi_out,
+                                phi_local, &psi_p[0]);
+
+          // Save the horizontal flux.
+          for (size_t l = 0; l < P; ++l)
+            psi_h[i * P + l] = psi_out[Mesh::HORZ][l];
+
+          if (d_tally)
+          {
+            for (size_t l = 0; l < n; ++l)
+            {
+              psi_lane[Mesh::VERT] = psi_out[Mesh::VERT][l];
+              psi_lane[Mesh::HORZ] = psi_out[Mesh::HORZ][l];
+              d_tally->tally(i, j, 0,  d_g,  o, a0 + l,  psi_lane);
+            }
+          }
+
+        } // end x loop
+
+        // Save the vertical flux.
+        for (size_t l = 0; l < P; ++l)
+          psi_v[j * P + l] = psi_out[Mesh::VERT][l];
+
+      } // end y loop
+
+      // Update boundary and angular flux for each angle.
+      for (size_t l = 0; l < n; ++l)
+      {
+        size_t a = a0 + l;
+        bf_type &b_v = b(face_V_o, o, a, d_g);
+        bf_type &b_h = b(face_H_o, o, a, d_g);
+        for (size_t j = 0; j < ny; ++j) b_v[j] = psi_v[j * P + l];
+        for (size_t i = 0; i < nx; ++i) b_h[i] = psi_h[i * P + l];
+        if (d_update_psi)
+        {
+          for (size_t c = 0; c < nc; ++c) psi[c] = psi_p[c * P + l];
+          d_state->set_psi(d_g, o, a, psi);
+        }
+      }
+
+    } // end packet loop
+    // end omp do
+
+  } // end octant loop
+
+  // Sum local thread fluxes.
+  reduce_thread_fluxes(phi);
 
   } // end omp parallel
 
-  #pragma omp master
+  d_number_sweeps++;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper2D<EQ>::tally_incident(const size_t   o,
+                                          const size_t   a,
+                                          const bf_type &psi_v,
+                                          const bf_type &psi_h)
+{
+  // Tally x-directed face
+  {
+    // Pick left or right side
+    size_t i = 0;
+    if (o == 1 || o == 2) i = d_mesh->number_cells_x() - 1;
+    // Loop over vertical
+    for (size_t jj = 0; jj < d_mesh->number_cells_y(); jj++)
+    {
+      size_t j = jj;
+      if (o > 1) j = d_mesh->number_cells_y() - j - 1;
+      d_tally->tally(i, j, 0,  d_g,  o, a,  Tally_T::X_DIRECTED, psi_v[j]);
+    }
+  }
+  // Tally y-directed face
   {
-    d_number_sweeps++;
+    size_t j = 0;
+    if (o > 1) j = d_mesh->number_cells_y() - 1;
+    for (size_t ii = 0; ii < d_mesh->number_cells_x(); ii++)
+    {
+      size_t i = ii;
+      if (o == 1 || o == 2) i = d_mesh->number_cells_x() - i - 1;
+      d_tally->tally(i, j, 0,  d_g,  o, a, Tally_T::Y_DIRECTED, psi_h[i]);
+    }
   }
 }
 
@@ -24,8 +24,15 @@ Sweeper2DMOC<EQ>::Sweeper2DMOC(SP_input input,
                                SP_sweepsource sweepsource)
   : Base(input, mesh, material, quadrature, state, boundary, sweepsource)
   , d_boundary(boundary)
+  , d_tracks(mesh->tracks())
+  , d_exp_cache(false)
 {
-    //d_tracks = mesh->tracks();
+  // Sweeping requires the flat track layout.
+  if (d_tracks && !d_tracks->is_flat()) d_tracks->flatten();
+
+  d_exp = ExpTable::Create(input);
+  if (d_input->check("moc_exp_cache"))
+    d_exp_cache = 0 != d_input->template get<int>("moc_exp_cache");
 }
 
 //---------------------------------------------------------------------------//
@@ -44,6 +51,46 @@ Sweeper2DMOC<EQ>::Create(SP_input       input,
   return p;
 }
 
+//---------------------------------------------------------------------------//
+template <class EQ>
+void Sweeper2DMOC<EQ>::setup_attenuation(const size_t g)
+{
+  Require(d_tracks);
+
+  SP_quadrature q = d_quadrature;
+  size_t np = q->number_polar_octant();
+
+  if (d_attenuation.empty())
+  {
+    d_attenuation.resize(d_material->number_groups());
+    d_attenuation_sigma_t.resize(d_material->number_groups());
+  }
+
+  // The cache is keyed on the total cross sections, which a material
+  // may change in place between sweeps.
+  detran_utilities::vec_dbl sigma_t(d_material->number_materials(), 0.0);
+  for (size_t m = 0; m < sigma_t.size(); ++m)
+    sigma_t[m] = d_material->sigma_t(m, g);
+  if (!d_attenuation[g].empty() && sigma_t == d_attenuation_sigma_t[g])
+    return;
+  d_attenuation_sigma_t[g] = sigma_t;
+
+  // Inverse polar sines.
+  detran_utilities::vec_dbl inv_sin(np, 0.0);
+  for (size_t p = 0; p < np; ++p)
+    inv_sin[p] = 1.0 / q->sin_theta(p);
+
+  const vec_int &mat_map = d_mesh->mesh_map("MATERIAL");
+  d_attenuation[g].resize(d_tracks->total_number_segments() * np, 0.0);
+  for (size_t s = 0; s < d_tracks->total_number_segments(); ++s)
+  {
+    double tau = d_material->sigma_t(mat_map[d_tracks->segment_region(s)], g) *
+                 d_tracks->segment_length(s);
+    for (size_t p = 0; p < np; ++p)
+      d_attenuation[g][s * np + p] = (*d_exp)(tau * inv_sin[p]);
+  }
+}
+
 //---------------------------------------------------------------------------//
 // EXPLICIT INSTANTIATIONS
 //---------------------------------------------------------------------------//
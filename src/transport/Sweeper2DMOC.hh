@@ -11,6 +11,7 @@
 #define detran_SWEEPER2DMOC_HH_
 
 #include "transport/Sweeper.hh"
+#include "transport/ExpTable.hh"
 #include "angle/ProductQuadrature.hh"
 #include "boundary/BoundaryMOC.hh"
 #include "geometry/Mesh.hh"
@@ -23,6 +24,25 @@ namespace detran
 /**
  *  @class Sweeper2DMOC
  *  @brief Sweeper for 2D MOC problems.
+ *
+ *  The segment exponentials are evaluated by an ExpTable built from the
+ *  input.  When memory allows, the attenuation of every segment can be
+ *  cached for each polar angle and group on the first sweep of a group,
+ *  which removes the exponential from later sweeps entirely.  The cache
+ *  holds one double per segment, polar angle, and group.  A group's
+ *  cache is rebuilt whenever its total cross sections differ from those
+ *  it was built with, as when a time-dependent material is updated.
+ *
+ *  If the boundary has chains of linked tracks (see BoundaryMOC), each
+ *  angle's chains are swept end to end through all four octants, and
+ *  the flux passes directly from one track to the next.  A closed chain
+ *  starts from its incident flux and leaves its outgoing flux for the
+ *  boundary update, unless the boundary is updated on the fly.
+ *
+ *  Relevant input database entries:
+ *    - moc_exp_type [str]          (see ExpTable)
+ *    - moc_exp_max_error [dbl]     (see ExpTable)
+ *    - moc_exp_cache [int]         (0 = evaluate on the fly, 1 = cache)
  */
 
 template <class EQ>
@@ -54,6 +74,8 @@ public:
   typedef detran_angle::ProductQuadrature::SP_quadrature SP_quadrature;
   typedef detran_geometry::TrackDB::SP_trackdb          SP_trackdb;
   typedef detran_geometry::Track::SP_track              SP_track;
+  typedef ExpTable::SP_exptable                         SP_exptable;
+  typedef detran_utilities::vec2_dbl                    vec2_dbl;
 
   //-------------------------------------------------------------------------//
   // CONSTRUCTOR & DESTRUCTOR
@@ -107,6 +129,25 @@ private:
   SP_boundary d_boundary;
   // Track database
   SP_trackdb d_tracks;
+  /// Exponential evaluator
+  SP_exptable d_exp;
+  /// Cache the segment attenuations?
+  bool d_exp_cache;
+  /// Segment attenuations by [group][flat segment * np + p]
+  vec2_dbl d_attenuation;
+  /// Total cross sections by [group][material] the attenuations used
+  vec2_dbl d_attenuation_sigma_t;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Compute the segment attenuations for a group if not yet cached or
+  /// if its total cross sections have changed since.
+  void setup_attenuation(const size_t g);
+
+  /// Sweep the chains of linked tracks.
+  inline void sweep_chains(moments_type &phi);
 
 };
 
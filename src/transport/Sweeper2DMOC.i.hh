@@ -29,21 +29,31 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
   // Reset the flux moments
   phi.assign(phi.size(), 0.0);
 
-#ifdef DETRAN_ENABLE_OPENMP
-  moments_type phi_local;
-#else
-  moments_type &phi_local = phi;
-#endif
+  // Precompute the segment attenuations if requested.
+  if (d_exp_cache) setup_attenuation(d_g);
+
+  // Size the thread flux accumulators and angular flux scratch.  Chains
+  // cross all four octants, so they hold an angular flux for each.
+  setup_thread_fluxes();
+  setup_thread_psi(4);
+
+  if (d_boundary->has_chains())
+  {
+    sweep_chains(phi);
+    d_number_sweeps++;
+    return;
+  }
 
-  #pragma omp parallel default(shared) private(phi_local)
+  #pragma omp parallel default(shared)
   {
 
   // Initialize equation and setup for this group.
   Equation_T equation(d_mesh, d_material, d_quadrature, d_update_psi);
   equation.setup_group(d_g);
+  equation.set_exp(d_exp);
 
   // Reset the flux moments
-  phi_local.resize(d_mesh->number_cells(), 0.0);
+  moments_type &phi_local = thread_flux(phi);
 
   // Initialize discrete sweep source vector.
   SweepSource<_2D>::sweep_source_type source(d_mesh->number_cells(), 0.0);
@@ -51,7 +61,12 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
   double psi_in  = 0;
   double psi_out = 0;
 
-  SP_quadrature q = d_quadrature;
+  // Angular flux scratch.
+  State::angular_flux_type &psi = thread_psi()[0];
+
+  // Thread-private view; no reference count update.
+  detran_utilities::SPview<detran_angle::ProductQuadrature> q(d_quadrature);
+  size_t np = q->number_polar_octant();
 
   // Sweep over all octants.
   for (size_t oo = 0; oo < 4; oo++)
@@ -104,34 +119,21 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
       // Get sweep source for this angle.
       d_sweepsource->source(d_g, o, a, source);
 
-      // Get psi if update requested.
-      State::angular_flux_type psi;
-      if (d_update_psi) psi = d_state->psi(d_g, o, a);
+      // Segments add to the angular flux, so start it from zero.
+      if (d_update_psi) psi.assign(psi.size(), 0.0);
 
       // Update the boundary for this angle.
       if (d_update_boundary) d_boundary->update(d_g, o, a);
 
-      // Sweep over all tracks.
+      // Sweep over all tracks, which are stored contiguously by angle.
+      size_t first_track = d_tracks->first_track(azimuth);
       for (int t = 0; t < d_tracks->number_tracks(azimuth, 0); t++)
       {
-//        if (!track_reverse)
-//          cout << "    TRACK: " << t << endl;
-//        else
-//          cout << "    TRACK: " << t << " in REVERSE" << endl;
-        // Get track.
-        SP_track track = d_tracks->track(azimuth, 0, t);
+        size_t track = first_track + t;
 
         // *** LOAD THE BOUNDARY FLUX.
-//        if (o == 0)
-//          psi_out = 1.0 + 4*o + t;
-//        else
         psi_out = (*d_boundary)(d_g, o, a, BoundaryMOC<_2D>::IN, t);
 
-//        cout << " OCTANT = " << o << endl;
-//        cout << "   ANGLE = " << a << endl;
-//        cout << "     TRACK = " << t << endl;
-//        cout << "       psi_in = " << psi_out << endl;
-
         // SN access
         // boundary_flux_type psi_v = (*d_boundary)
         //   (d_face_index[o][Mesh::VERT][Boundary_T::IN], o, a, d_g);
@@ -141,34 +143,35 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
         // --> ergo, the side really needn't be part of the storage
         // --> create index maps for which track is on a side, etc.
 
-
-        //cout << "      PSI_IN: " << psi_out << endl;
-
-        double width = track->width();
+        double width = d_tracks->track_width(track);
+        size_t s_begin = d_tracks->segment_begin(track);
+        size_t s_end   = d_tracks->segment_end(track);
 
         // Sweep all segments on the track.
-        int s = 0;
-        for (int ss = 0; ss < track->number_segments(); ss++)
+        for (size_t ss = s_begin; ss < s_end; ++ss)
         {
-          s = ss;
-          if (track_reverse) s = track->number_segments() - ss - 1;
-
-          //cout << "      SEGMENT: " << s << endl;
+          size_t s = ss;
+          if (track_reverse) s = s_end - 1 - (ss - s_begin);
 
           // Update track angular flux
           psi_in = psi_out;
 
-          // Get segment region.
-          int region = track->segment(s).region();
-
-          // Get segment length.
-          double length = track->segment(s).length();
+          // Get segment region and length.
+          int region = d_tracks->segment_region(s);
+          double length = d_tracks->segment_length(s);
 
           // Solve.
-          equation.solve(region, length, width, source,
-                         psi_in, psi_out, phi_local, psi);
-
-          //cout << "        PSI_OUT: " << psi_out << endl;
+          if (d_exp_cache)
+          {
+            double A = d_attenuation[d_g][s * np + polar];
+            equation.solve(region, length, width, A, source,
+                           psi_in, psi_out, phi_local, psi);
+          }
+          else
+          {
+            equation.solve(region, length, width, source,
+                           psi_in, psi_out, phi_local, psi);
+          }
 
         } // end segment
 
@@ -181,7 +184,7 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
       } // end track
 
       // Update the angular flux.
-      if (d_update_psi) d_state->psi(d_g, o, a) = psi;
+      if (d_update_psi) d_state->set_psi(d_g, o, a, psi);
 
 
     } // end angle loop
@@ -189,24 +192,121 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
 
   } // end octant loop
 
-#ifdef DETRAN_ENABLE_OPENMP
   // Sum local thread fluxes.
-  #pragma omp critical
+  reduce_thread_fluxes(phi);
+
+  } // end omp parallel
+
+  d_number_sweeps++;
+  return;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper2DMOC<EQ>::sweep_chains(moments_type &phi)
+{
+  typedef SweepSource<_2D>::sweep_source_type sweep_source_type;
+
+  #pragma omp parallel default(shared)
+  {
+
+  // Initialize equation and setup for this group.
+  Equation_T equation(d_mesh, d_material, d_quadrature, d_update_psi);
+  equation.setup_group(d_g);
+  equation.set_exp(d_exp);
+
+  moments_type &phi_local = thread_flux(phi);
+
+  // Chains cross all four octants, so keep the sources and angular
+  // fluxes of an angle for each.
+  std::vector<sweep_source_type>
+    source(4, sweep_source_type(d_mesh->number_cells(), 0.0));
+  std::vector<State::angular_flux_type> &psi = thread_psi();
+
+  double psi_in  = 0;
+  double psi_out = 0;
+
+  // Thread-private view; no reference count update.
+  detran_utilities::SPview<detran_angle::ProductQuadrature> q(d_quadrature);
+  size_t np = q->number_polar_octant();
+
+  #pragma omp for
+  for (size_t a = 0; a < q->number_angles_octant(); ++a)
   {
-    for (int i = 0; i < d_mesh->number_cells(); i++)
+    size_t azimuth = q->azimuth(a);
+    size_t polar   = q->polar(a);
+    equation.setup_azimuth(azimuth);
+    equation.setup_polar(polar);
+
+    for (size_t o = 0; o < 4; ++o)
     {
-      phi[i] += phi_local[i];
+      d_sweepsource->source(d_g, o, a, source[o]);
+      if (d_update_psi) psi[o].assign(psi[o].size(), 0.0);
     }
-  }
-#endif
 
-  } // end omp parallel
+    for (size_t c = 0; c < d_boundary->number_chains(azimuth); ++c)
+    {
+      // A closed chain starts with its incident flux, and any other
+      // starts at a vacuum side.
+      bool closed = c < d_boundary->number_closed(azimuth);
+      psi_out = closed ? d_boundary->chain_flux(d_g, azimuth, c, polar) : 0.0;
 
-  #pragma omp master
-  {
-    d_number_sweeps++;
-  }
-  return;
+      size_t i_end = d_boundary->chain_end(azimuth, c);
+      for (size_t i = d_boundary->chain_begin(azimuth, c); i < i_end; ++i)
+      {
+        int entry = d_boundary->chain_track(azimuth, i);
+        size_t track = entry / 4;
+        size_t o     = entry % 4;
+        equation.setup_octant(o);
+
+        double width   = d_tracks->track_width(track);
+        size_t s_begin = d_tracks->segment_begin(track);
+        size_t s_end   = d_tracks->segment_end(track);
+
+        // Octants 2 and 3 run the tracks backward.
+        for (size_t ss = s_begin; ss < s_end; ++ss)
+        {
+          size_t s = o < 2 ? ss : s_end - 1 - (ss - s_begin);
+          psi_in = psi_out;
+          int region = d_tracks->segment_region(s);
+          double length = d_tracks->segment_length(s);
+          if (d_exp_cache)
+          {
+            double A = d_attenuation[d_g][s * np + polar];
+            equation.solve(region, length, width, A, source[o],
+                           psi_in, psi_out, phi_local, psi[o]);
+          }
+          else
+          {
+            equation.solve(region, length, width, source[o],
+                           psi_in, psi_out, phi_local, psi[o]);
+          }
+        } // end segment
+
+      } // end track
+
+      // The outgoing flux becomes incident at the boundary update, or
+      // right away when updating on the fly.
+      if (closed)
+      {
+        d_boundary->chain_flux(d_g, azimuth, c, polar,
+                               Boundary_T::OUT) = psi_out;
+        if (d_update_boundary)
+          d_boundary->chain_flux(d_g, azimuth, c, polar) = psi_out;
+      }
+
+    } // end chain
+
+    if (d_update_psi)
+      for (size_t o = 0; o < 4; ++o)
+        d_state->set_psi(d_g, o, a, psi[o]);
+
+  } // end angle loop
+
+  // Sum local thread fluxes.
+  reduce_thread_fluxes(phi);
+
+  } // end omp parallel
 }
 
 } // end namespace detran
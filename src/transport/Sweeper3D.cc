@@ -11,6 +11,7 @@
 #include "transport/Equation_DD_3D.hh"
 //#include "discretization/Equation_SD_3D.hh"
 //#include "discretization/Equation_SC_3D.hh"
+#include <algorithm>
 
 namespace detran
 {
@@ -26,9 +27,35 @@ Sweeper3D<EQ>::Sweeper3D(SP_input input,
                          SP_sweepsource sweepsource)
   : Base(input, mesh, material, quadrature, state, boundary, sweepsource)
   , d_boundary(boundary)
+  , d_kba(false)
+  , d_kba_block_size(3, 0)
+  , d_packets(false)
 {
-    // Preconditions
-    Require(d_boundary);
+  // Preconditions
+  Require(d_boundary);
+
+  // Default KBA blocks are 8x8 columns cut into chunks of 4 planes.
+  d_kba_block_size[0] = 8;
+  d_kba_block_size[1] = 8;
+  d_kba_block_size[2] = 4;
+
+  if (d_input->check("sweeper_kba"))
+    d_kba = 0 != d_input->template get<int>("sweeper_kba");
+  if (d_input->check("sweeper_kba_blocks"))
+  {
+    d_kba_block_size = d_input->template get<vec_int>("sweeper_kba_blocks");
+    Insist(d_kba_block_size.size() == 3,
+           "The KBA block size must be specified for x, y, and z.");
+  }
+  if (d_kba) setup_kba();
+  if (d_input->check("sweeper_angle_packets"))
+    d_packets = 0 != d_input->template get<int>("sweeper_angle_packets");
+  if (d_packets)
+  {
+    Insist(Equation_T::has_packets(),
+           "Angle packets are not implemented for this equation.");
+    Insist(!d_kba, "Angle packets cannot be combined with the KBA sweep.");
+  }
 }
 
 //---------------------------------------------------------------------------//
@@ -47,6 +74,33 @@ Sweeper3D<EQ>::Create(SP_input       input,
   return p;
 }
 
+//---------------------------------------------------------------------------//
+template <class EQ>
+void Sweeper3D<EQ>::setup_kba()
+{
+  // Number of blocks in each dimension, where the last block in a
+  // dimension may be smaller than the others.
+  d_kba_number_blocks.resize(3, 0);
+  for (size_t d = 0; d < 3; ++d)
+  {
+    Insist(d_kba_block_size[d] > 0, "KBA block sizes must be positive.");
+    int n = d_mesh->number_cells(d);
+    d_kba_block_size[d] = std::min(d_kba_block_size[d], n);
+    d_kba_number_blocks[d] = (n + d_kba_block_size[d] - 1) / d_kba_block_size[d];
+  }
+  int nbx = d_kba_number_blocks[0];
+  int nby = d_kba_number_blocks[1];
+  int nbz = d_kba_number_blocks[2];
+
+  // Group the blocks by diagonal.  Block indices are relative to the
+  // sweep direction, so the same stages apply to every octant.
+  d_kba_stages.resize(nbx + nby + nbz - 2);
+  for (int bz = 0; bz < nbz; ++bz)
+    for (int by = 0; by < nby; ++by)
+      for (int bx = 0; bx < nbx; ++bx)
+        d_kba_stages[bx + by + bz].push_back(bx + nbx * (by + nby * bz));
+}
+
 //---------------------------------------------------------------------------//
 // EXPLICIT INSTANTIATIONS
 //---------------------------------------------------------------------------//
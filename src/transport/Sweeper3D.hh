@@ -19,6 +19,26 @@ namespace detran
 /**
  *  @class Sweeper3D
  *  @brief Sweeper for 3D discrete ordinates problems.
+ *
+ *  By default, threading is over the angles within an octant.  For problems
+ *  with few angles per octant, a Koch-Baker-Alcouffe (KBA) wavefront mode
+ *  is available.  The x-y plane is tiled into columns of blocks, and each
+ *  column is cut into chunks of z-planes.  A block depends only on its
+ *  upwind neighbors in x, y, and z, so all blocks on a diagonal plane
+ *  bx + by + bz = const can be swept concurrently.  Each stage of the
+ *  pipeline sweeps one such diagonal for every angle of the octant, so
+ *  the parallelism scales with the mesh rather than with the quadrature.
+ *  When octants are independent (i.e. the boundary is not updated on the
+ *  fly with a reflective side), all octants share the same pipeline.
+ *
+ *  For equations that support it, angles can also be swept in packets of
+ *  Equation::packet_size, with each cell solved for the whole packet at
+ *  once.  See Sweeper2D.
+ *
+ *  Relevant input database entries:
+ *    - sweeper_kba [int]            (0 = angle threading, 1 = KBA)
+ *    - sweeper_kba_blocks [vec_int] (cells per block in x, y, and z)
+ *    - sweeper_angle_packets [int]  (0 = one angle at a time, 1 = packets)
  */
 template <class EQ>
 class Sweeper3D: public Sweeper<_3D>
@@ -46,6 +66,7 @@ public:
   typedef typename Base::vec2_int                   vec2_int;
   typedef typename Base::vec3_int                   vec3_int;
   typedef typename Base::size_t                     size_t;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
   typedef EQ                                        Equation_T;
   typedef BoundarySN<_3D>                           Boundary_T;
   typedef typename Boundary_T::SP_boundary          SP_boundary;
@@ -93,6 +114,9 @@ public:
   /// Sweep.
   inline void sweep(moments_type &phi);
 
+  /// Packet sweeps can be done in single precision.
+  bool has_single_precision() const { return d_packets; }
+
 private:
 
   //-------------------------------------------------------------------------//
@@ -100,6 +124,51 @@ private:
   //-------------------------------------------------------------------------//
 
   SP_boundary d_boundary;
+  /// Use the KBA wavefront sweep?
+  bool d_kba;
+  /// Number of cells per KBA block in each dimension
+  vec_int d_kba_block_size;
+  /// Number of KBA blocks in each dimension
+  vec_int d_kba_number_blocks;
+  /// KBA block indices on each diagonal (i.e. pipeline stage)
+  vec2_int d_kba_stages;
+  /// Angular flux scratch for each angle in flight
+  std::vector<angular_flux_type> d_kba_psi;
+  /// Sweep packets of angles?
+  bool d_packets;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Sweep using the KBA wavefront decomposition.
+  inline void sweep_kba(moments_type &phi);
+
+  /// Sweep one KBA block for one angle.
+  inline void sweep_kba_block(Equation_T         &equation,
+                              const size_t        o,
+                              const size_t        a,
+                              const int           block,
+                              vec_dbl            &source,
+                              bf_type            &psi_yz,
+                              bf_type            &psi_xz,
+                              bf_type            &psi_xy,
+                              moments_type       &phi,
+                              angular_flux_type  &psi);
+
+  /// Sweep packets of angles in precision T.
+  template <class T>
+  inline void sweep_packets(moments_type &phi);
+
+  /// Tally the incident boundary fluxes for an angle.
+  inline void tally_incident(const size_t   o,
+                             const size_t   a,
+                             const bf_type &psi_yz,
+                             const bf_type &psi_xz,
+                             const bf_type &psi_xy);
+
+  /// Build the KBA blocks and pipeline stages.
+  void setup_kba();
 
 };
 
@@ -10,6 +10,7 @@
 #ifndef detran_SWEEPER3D_I_HH_
 #define detran_SWEEPER3D_I_HH_
 
+#include <algorithm>
 #include <iostream>
 #ifdef DETRAN_ENABLE_OPENMP
 #include <omp.h>
@@ -25,16 +26,32 @@ inline void Sweeper3D<EQ>::sweep(moments_type &phi)
   using std::cout;
   using std::endl;
 
+  // Switch to the wavefront sweep if requested.
+  if (d_kba)
+  {
+    sweep_kba(phi);
+    return;
+  }
+  if (d_packets)
+  {
+    if (d_single_precision)
+      sweep_packets<float>(phi);
+    else
+      sweep_packets<double>(phi);
+    return;
+  }
+
   // Reset the flux moments
   phi.assign(phi.size(), 0.0);
 
-#ifdef DETRAN_ENABLE_OPENMP
-  moments_type phi_local;
-#else
-  moments_type &phi_local = phi;
-#endif
+  // Reset the boundary flux tally
+  if (d_tally) d_tally->reset(d_g);
+
+  // Size the thread flux accumulators and angular flux scratch.
+  setup_thread_fluxes();
+  setup_thread_psi();
 
-  #pragma omp parallel default(shared) private(phi_local)
+  #pragma omp parallel default(shared)
   {
 
   // Initialize equation and setup for this group.
@@ -42,10 +59,10 @@ inline void Sweeper3D<EQ>::sweep(moments_type &phi)
   equation.setup_group(d_g);
 
   // Reset the flux moments
-  phi_local.resize(d_mesh->number_cells(), 0.0);
+  moments_type &phi_local = thread_flux(phi);
 
-  // Reset the boundary flux tally
-  if (d_tally) d_tally->reset(d_g);
+  // Angular flux scratch.  Every cell is written, so nothing is fetched.
+  State::angular_flux_type &psi = thread_psi()[0];
 
   // Initialize discrete sweep source vector.
   SweepSource<_3D>::sweep_source_type source(d_mesh->number_cells(), 0.0);
@@ -71,10 +88,6 @@ inline void Sweeper3D<EQ>::sweep(moments_type &phi)
       // Setup equations for this angle.
       equation.setup_angle(a);
 
-      // Get psi if update requested.
-      State::angular_flux_type psi;
-      if (d_update_psi) psi = d_state->psi(d_g, o, a);
-
       // Update the boundary for this angle.
       if (d_update_boundary) b.update(d_g, o, a);
 
@@ -83,6 +96,9 @@ inline void Sweeper3D<EQ>::sweep(moments_type &phi)
       bf_type psi_xz = b(d_face_index[o][Mesh::XZ][Boundary_T::IN], o, a, d_g);
       bf_type psi_xy = b(d_face_index[o][Mesh::XY][Boundary_T::IN], o, a, d_g);
 
+      // Tally the incident boundary.
+      if (d_tally) tally_incident(o, a, psi_yz, psi_xz, psi_xy);
+
       // Temporary edge fluxes.
       Equation<_3D>::face_flux_type psi_in  = { 0.0, 0.0, 0.0 };
       Equation<_3D>::face_flux_type psi_out = { 0.0, 0.0, 0.0 };
@@ -111,13 +127,14 @@ inline void Sweeper3D<EQ>::sweep(moments_type &phi)
             psi_in[Mesh::XY] = psi_xy[j][i];
 
             // Solve.
-            equation.solve(i, j, k, source, psi_in, psi_out, phi, psi);
+            equation.solve(i, j, k, source, psi_in, psi_out, phi_local, psi);
 
             // Save the horizontal flux.
             psi_xz[k][i] = psi_out[Mesh::XZ];
             psi_xy[j][i] = psi_out[Mesh::XY];
 
-            // INSERT ACCELERATION MESH STUFF HERE
+            // Tally the outgoing cell flux.
+            if (d_tally) d_tally->tally(i, j, k, d_g, o, a, psi_out);
 
           } // end x loop
 
@@ -133,31 +150,433 @@ inline void Sweeper3D<EQ>::sweep(moments_type &phi)
       b(d_face_index[o][Mesh::XY][Boundary_T::OUT], o, a, d_g) = psi_xy;
 
       // Angular flux update
-      if (d_update_psi) d_state->psi(d_g, o, a) = psi;
+      if (d_update_psi) d_state->set_psi(d_g, o, a, psi);
 
     } // end angle loop
 
   } // end octant loop
 
-#ifdef DETRAN_ENABLE_OPENMP
   // Sum local thread fluxes.
-  #pragma omp critical
+  reduce_thread_fluxes(phi);
+
+  } // end omp parallel
+
+
+  d_number_sweeps++;
+  return;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper3D<EQ>::sweep_kba(moments_type &phi)
+{
+  // Reset the flux moments
+  phi.assign(phi.size(), 0.0);
+
+  // Reset the boundary flux tally
+  if (d_tally) d_tally->reset(d_g);
+
+  // Reference to boundary to simplify clutter.
+  Boundary_T &b = *d_boundary;
+
+  // Octants are independent unless reflected fluxes are updated on the
+  // fly, in which case each octant waits for its predecessors.
+  vec2_int octants;
+  if (d_update_boundary && b.has_reflective())
   {
-    for (int i = 0; i < d_mesh->number_cells(); i++)
+    for (size_t oo = 0; oo < 8; ++oo)
+      octants.push_back(vec_int(1, d_ordered_octants[oo]));
+  }
+  else
+  {
+    octants.push_back(d_ordered_octants);
+  }
+
+  size_t na = d_quadrature->number_angles_octant();
+
+  for (size_t og = 0; og < octants.size(); ++og)
+  {
+    const vec_int &group = octants[og];
+    int number_angles = group.size() * na;
+
+    // Sources, angular fluxes, and working face fluxes for every angle
+    // in flight, indexed by oa = index of octant in group * na + a.  The
+    // angular fluxes persist across sweeps; every cell is written, so
+    // nothing is fetched from the state.
+    std::vector<vec_dbl>            source(number_angles);
+    std::vector<angular_flux_type> &psi = d_kba_psi;
+    std::vector<bf_type>            psi_yz(number_angles);
+    std::vector<bf_type>            psi_xz(number_angles);
+    std::vector<bf_type>            psi_xy(number_angles);
+    if (psi.size() < group.size() * na) psi.resize(group.size() * na);
+
+    #pragma omp parallel for
+    for (int oa = 0; oa < number_angles; ++oa)
     {
-      phi[i] += phi_local[i];
+      size_t o = group[oa / na];
+      size_t a = oa % na;
+      source[oa].resize(d_mesh->number_cells(), 0.0);
+      d_sweepsource->source(d_g, o, a, source[oa]);
+      if (d_update_psi) psi[oa].resize(d_mesh->number_cells(), 0.0);
+      if (d_update_boundary) b.update(d_g, o, a);
+      psi_yz[oa] = b(d_face_index[o][Mesh::YZ][Boundary_T::IN], o, a, d_g);
+      psi_xz[oa] = b(d_face_index[o][Mesh::XZ][Boundary_T::IN], o, a, d_g);
+      psi_xy[oa] = b(d_face_index[o][Mesh::XY][Boundary_T::IN], o, a, d_g);
+      if (d_tally) tally_incident(o, a, psi_yz[oa], psi_xz[oa], psi_xy[oa]);
     }
+
+    // Size the thread flux accumulators.
+    setup_thread_fluxes();
+
+    #pragma omp parallel default(shared)
+    {
+
+    // Initialize equation and setup for this group.
+    Equation_T equation(d_mesh, d_material, d_quadrature, d_update_psi);
+    equation.setup_group(d_g);
+    int current_oa = -1;
+
+    // Reset the flux moments
+    moments_type &phi_local = thread_flux(phi);
+
+    // Each stage sweeps all blocks on one diagonal for all angles.  The
+    // implicit barrier at the end of the loop closes the stage.
+    for (size_t s = 0; s < d_kba_stages.size(); ++s)
+    {
+      const vec_int &blocks = d_kba_stages[s];
+      int number_tasks = blocks.size() * number_angles;
+
+      #pragma omp for schedule(dynamic)
+      for (int task = 0; task < number_tasks; ++task)
+      {
+        int oa = task / blocks.size();
+        size_t o = group[oa / na];
+        if (oa != current_oa)
+        {
+          equation.setup_octant(o);
+          equation.setup_angle(oa % na);
+          current_oa = oa;
+        }
+        sweep_kba_block(equation, o, oa % na, blocks[task % blocks.size()],
+                        source[oa], psi_yz[oa], psi_xz[oa], psi_xy[oa],
+                        phi_local, psi[oa]);
+      }
+    } // end stage loop
+
+    // Sum local thread fluxes.
+    reduce_thread_fluxes(phi);
+
+    } // end omp parallel
+
+    // Update boundary and angular flux
+    for (int oa = 0; oa < number_angles; ++oa)
+    {
+      size_t o = group[oa / na];
+      size_t a = oa % na;
+      b(d_face_index[o][Mesh::YZ][Boundary_T::OUT], o, a, d_g) = psi_yz[oa];
+      b(d_face_index[o][Mesh::XZ][Boundary_T::OUT], o, a, d_g) = psi_xz[oa];
+      b(d_face_index[o][Mesh::XY][Boundary_T::OUT], o, a, d_g) = psi_xy[oa];
+      if (d_update_psi) d_state->set_psi(d_g, o, a, psi[oa]);
+    }
+
+  } // end octant group loop
+
+  d_number_sweeps++;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper3D<EQ>::sweep_kba_block(Equation_T         &equation,
+                                           const size_t        o,
+                                           const size_t        a,
+                                           const int           block,
+                                           vec_dbl            &source,
+                                           bf_type            &psi_yz,
+                                           bf_type            &psi_xz,
+                                           bf_type            &psi_xy,
+                                           moments_type       &phi,
+                                           angular_flux_type  &psi)
+{
+  // Block indices relative to the sweep direction
+  int bx = block % d_kba_number_blocks[0];
+  int by = (block / d_kba_number_blocks[0]) % d_kba_number_blocks[1];
+  int bz = block / (d_kba_number_blocks[0] * d_kba_number_blocks[1]);
+
+  // Bounds of the block relative to the sweep direction
+  int bounds[3][2];
+  int b_idx[3] = {bx, by, bz};
+  for (size_t d = 0; d < 3; ++d)
+  {
+    bounds[d][0] = b_idx[d] * d_kba_block_size[d];
+    bounds[d][1] = std::min(bounds[d][0] + d_kba_block_size[d],
+                            (int)d_mesh->number_cells(d));
   }
-#endif
+
+  // Temporary edge fluxes.
+  Equation<_3D>::face_flux_type psi_in  = { 0.0, 0.0, 0.0 };
+  Equation<_3D>::face_flux_type psi_out = { 0.0, 0.0, 0.0 };
+
+  // The face fluxes hold whatever left the upwind neighbor, so the block
+  // is swept exactly as the full mesh would be.
+  int dk = d_space_ranges[o][2][1];
+  int k  = d_space_ranges[o][2][0] + dk * bounds[2][0];
+  for (int kk = bounds[2][0]; kk < bounds[2][1]; ++kk, k += dk)
+  {
+    int dj = d_space_ranges[o][1][1];
+    int j  = d_space_ranges[o][1][0] + dj * bounds[1][0];
+    for (int jj = bounds[1][0]; jj < bounds[1][1]; ++jj, j += dj)
+    {
+      psi_out[Mesh::YZ] = psi_yz[k][j];
+
+      int di = d_space_ranges[o][0][1];
+      int i  = d_space_ranges[o][0][0] + di * bounds[0][0];
+      for (int ii = bounds[0][0]; ii < bounds[0][1]; ++ii, i += di)
+      {
+        psi_in[Mesh::YZ] = psi_out[Mesh::YZ];
+        psi_in[Mesh::XZ] = psi_xz[k][i];
+        psi_in[Mesh::XY] = psi_xy[j][i];
+
+        // Solve.
+        equation.solve(i, j, k, source, psi_in, psi_out, phi, psi);
+
+        // Save the horizontal flux.
+        psi_xz[k][i] = psi_out[Mesh::XZ];
+        psi_xy[j][i] = psi_out[Mesh::XY];
+
+        // Tally the outgoing cell flux.
+        if (d_tally) d_tally->tally(i, j, k, d_g, o, a, psi_out);
+      } // end x loop
+
+      // Save the vertical flux.
+      psi_yz[k][j] = psi_out[Mesh::YZ];
+
+    } // end y loop
+  } // end z loop
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+template <class T>
+inline void Sweeper3D<EQ>::sweep_packets(moments_type &phi)
+{
+  typedef typename EquationTraits<_3D, T>::packet_flux_type packet_flux_type;
+  const size_t P = Equation<_3D>::packet_size;
+
+  // Reset the flux moments
+  phi.assign(phi.size(), 0.0);
+
+  // Reset the boundary flux tally
+  if (d_tally) d_tally->reset(d_g);
+
+  // Reference to boundary to simplify clutter.
+  Boundary_T &b = *d_boundary;
+
+  size_t nx = d_mesh->number_cells_x();
+  size_t ny = d_mesh->number_cells_y();
+  size_t nz = d_mesh->number_cells_z();
+  size_t nc = d_mesh->number_cells();
+  size_t na = d_quadrature->number_angles_octant();
+  int number_packets = (na + P - 1) / P;
+
+  // Size the thread flux accumulators.
+  setup_thread_fluxes();
+
+  #pragma omp parallel default(shared)
+  {
+
+  // Initialize equation and setup for this group.
+  Equation_T equation(d_mesh, d_material, d_quadrature, d_update_psi);
+  equation.setup_group(d_g);
+
+  // Reset the flux moments
+  moments_type &phi_local = thread_flux(phi);
+
+  // Single angle sweep source, and packet sources, angular fluxes, and
+  // face fluxes, all stored as [index * P + lane] in the sweep precision.
+  SweepSource<_3D>::sweep_source_type source(nc, 0.0);
+  std::vector<T> q(nc * P, 0.0);
+  std::vector<T> psi_p(nc * P, 0.0);
+  State::angular_flux_type psi(d_update_psi ? nc : 0, 0.0);
+  std::vector<T> psi_yz(nz * ny * P, 0.0);
+  std::vector<T> psi_xz(nz * nx * P, 0.0);
+  std::vector<T> psi_xy(ny * nx * P, 0.0);
+
+  // Temporary edge fluxes.
+  packet_flux_type psi_in, psi_out;
+  Equation<_3D>::face_flux_type psi_lane = {0.0, 0.0, 0.0};
+
+  // Sweep over all octants
+  for (size_t oo = 0; oo < 8; oo++)
+  {
+    size_t o = d_ordered_octants[oo];
+
+    equation.setup_octant(o);
+
+    const int face_yz_i = d_face_index[o][Mesh::YZ][Boundary_T::IN];
+    const int face_xz_i = d_face_index[o][Mesh::XZ][Boundary_T::IN];
+    const int face_xy_i = d_face_index[o][Mesh::XY][Boundary_T::IN];
+    const int face_yz_o = d_face_index[o][Mesh::YZ][Boundary_T::OUT];
+    const int face_xz_o = d_face_index[o][Mesh::XZ][Boundary_T::OUT];
+    const int face_xy_o = d_face_index[o][Mesh::XY][Boundary_T::OUT];
+
+    // Sweep over all packets
+    #pragma omp for
+    for (int p = 0; p < number_packets; ++p)
+    {
+      size_t a0 = p * P;
+      size_t n  = std::min(P, na - a0);
+
+      // Setup equations for this packet.
+      equation.setup_packet(a0, n);
+
+      // Gather the sources and incident fluxes of each angle into lanes.
+      // Unused lanes are zeroed so they stay finite.
+      for (size_t l = 0; l < P; ++l)
+      {
+        if (l >= n)
+        {
+          for (size_t c = 0; c < nc; ++c) q[c * P + l] = 0.0;
+          for (size_t f = 0; f < nz * ny; ++f) psi_yz[f * P + l] = 0.0;
+          for (size_t f = 0; f < nz * nx; ++f) psi_xz[f * P + l] = 0.0;
+          for (size_t f = 0; f < ny * nx; ++f) psi_xy[f * P + l] = 0.0;
+          continue;
+        }
+        size_t a = a0 + l;
+        d_sweepsource->source(d_g, o, a, source);
+        for (size_t c = 0; c < nc; ++c) q[c * P + l] = source[c];
+        if (d_update_boundary) b.update(d_g, o, a);
+        const bf_type &b_yz = b(face_yz_i, o, a, d_g);
+        const bf_type &b_xz = b(face_xz_i, o, a, d_g);
+        const bf_type &b_xy = b(face_xy_i, o, a, d_g);
+        if (d_tally) tally_incident(o, a, b_yz, b_xz, b_xy);
+        for (size_t k = 0; k < nz; ++k)
+        {
+          for (size_t j = 0; j < ny; ++j)
+            psi_yz[(k * ny + j) * P + l] = b_yz[k][j];
+          for (size_t i = 0; i < nx; ++i)
+            psi_xz[(k * nx + i) * P + l] = b_xz[k][i];
+        }
+        for (size_t j = 0; j < ny; ++j)
+          for (size_t i = 0; i < nx; ++i)
+            psi_xy[(j * nx + i) * P + l] = b_xy[j][i];
+      }
+
+      // Sweep over all z
+      int k  = d_space_ranges[o][2][0];
+      int dk = d_space_ranges[o][2][1];
+      for (size_t kk = 0; kk < nz; ++kk, k += dk)
+      {
+
+        // Sweep over all y
+        int j  = d_space_ranges[o][1][0];
+        int dj = d_space_ranges[o][1][1];
+        for (size_t jj = 0; jj < ny; ++jj, j += dj)
+        {
+          T *yz = &psi_yz[(k * ny + j) * P];
+          for (size_t l = 0; l < P; ++l)
+            psi_out[Mesh::YZ][l] = yz[l];
+
+          // Sweep over all x
+          int i  = d_space_ranges[o][0][0];
+          int di = d_space_ranges[o][0][1];
+          for (size_t ii = 0; ii < nx; ++ii, i += di)
+          {
+            T *xz = &psi_xz[(k * nx + i) * P];
+            T *xy = &psi_xy[(j * nx + i) * P];
+            for (size_t l = 0; l < P; ++l)
+            {
+              psi_in[Mesh::YZ][l] = psi_out[Mesh::YZ][l];
+              psi_in[Mesh::XZ][l] = xz[l];
+              psi_in[Mesh::XY][l] = xy[l];
+            }
+
+            // Solve for all lanes.
+            equation.solve_packet(i, j, k, &q[0], psi_in, psi_out,
+                                  phi_local, &psi_p[0]);
+
+            // Save the horizontal flux.
+            for (size_t l = 0; l < P; ++l)
+            {
+              xz[l] = psi_out[Mesh::XZ][l];
+              xy[l] = psi_out[Mesh::XY][l];
+            }
+
+            // Tally the outgoing cell flux of each angle.
+            for (size_t l = 0; d_tally && l < n; ++l)
+            {
+              psi_lane[Mesh::YZ] = psi_out[Mesh::YZ][l];
+              psi_lane[Mesh::XZ] = psi_out[Mesh::XZ][l];
+              psi_lane[Mesh::XY] = psi_out[Mesh::XY][l];
+              d_tally->tally(i, j, k, d_g, o, a0 + l, psi_lane);
+            }
+
+          } // end x loop
+
+          // Save the vertical flux.
+          for (size_t l = 0; l < P; ++l)
+            yz[l] = psi_out[Mesh::YZ][l];
+
+        } // end y loop
+      } // end z loop
+
+      // Update boundary and angular flux for each angle.
+      for (size_t l = 0; l < n; ++l)
+      {
+        size_t a = a0 + l;
+        bf_type &b_yz = b(face_yz_o, o, a, d_g);
+        bf_type &b_xz = b(face_xz_o, o, a, d_g);
+        bf_type &b_xy = b(face_xy_o, o, a, d_g);
+        for (size_t k = 0; k < nz; ++k)
+        {
+          for (size_t j = 0; j < ny; ++j)
+            b_yz[k][j] = psi_yz[(k * ny + j) * P + l];
+          for (size_t i = 0; i < nx; ++i)
+            b_xz[k][i] = psi_xz[(k * nx + i) * P + l];
+        }
+        for (size_t j = 0; j < ny; ++j)
+          for (size_t i = 0; i < nx; ++i)
+            b_xy[j][i] = psi_xy[(j * nx + i) * P + l];
+        if (d_update_psi)
+        {
+          for (size_t c = 0; c < nc; ++c) psi[c] = psi_p[c * P + l];
+          d_state->set_psi(d_g, o, a, psi);
+        }
+      }
+
+    } // end packet loop
+
+  } // end octant loop
+
+  // Sum local thread fluxes.
+  reduce_thread_fluxes(phi);
 
   } // end omp parallel
 
+  d_number_sweeps++;
+}
 
-  #pragma omp master
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper3D<EQ>::tally_incident(const size_t   o,
+                                          const size_t   a,
+                                          const bf_type &psi_yz,
+                                          const bf_type &psi_xz,
+                                          const bf_type &psi_xy)
+{
+  // The incident faces are those on which the sweep starts.
+  size_t i0 = d_space_ranges[o][0][0];
+  size_t j0 = d_space_ranges[o][1][0];
+  size_t k0 = d_space_ranges[o][2][0];
+  for (size_t k = 0; k < d_mesh->number_cells_z(); ++k)
   {
-    d_number_sweeps++;
+    for (size_t j = 0; j < d_mesh->number_cells_y(); ++j)
+      d_tally->tally(i0, j, k, d_g, o, a, Tally_T::X_DIRECTED, psi_yz[k][j]);
+    for (size_t i = 0; i < d_mesh->number_cells_x(); ++i)
+      d_tally->tally(i, j0, k, d_g, o, a, Tally_T::Y_DIRECTED, psi_xz[k][i]);
   }
-  return;
+  for (size_t j = 0; j < d_mesh->number_cells_y(); ++j)
+    for (size_t i = 0; i < d_mesh->number_cells_x(); ++i)
+      d_tally->tally(i, j, k0, d_g, o, a, Tally_T::Z_DIRECTED, psi_xy[j][i]);
 }
 
 } // end namespace detran
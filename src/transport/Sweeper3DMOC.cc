@@ -0,0 +1,87 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Sweeper3DMOC.cc
+ *  @brief  Sweeper3DMOC member definitions.
+ *  @note   Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "transport/Sweeper3DMOC.hh"
+#include "transport/Equation_SC_MOC.hh"
+#include <algorithm>
+#include <cmath>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+Sweeper3DMOC<EQ>::Sweeper3DMOC(SP_input input,
+                               SP_mesh mesh,
+                               SP_material material,
+                               SP_quadrature quadrature,
+                               SP_state state,
+                               SP_boundary boundary,
+                               SP_sweepsource sweepsource)
+  : Base(input, mesh, material, quadrature, state, boundary, sweepsource)
+  , d_boundary(boundary)
+  , d_tracks(mesh->tracks())
+  , d_z_edges(mesh->number_cells_z() + 1, 0.0)
+  , d_number_z(quadrature->number_polar_octant(), 1)
+  , d_slope(quadrature->number_polar_octant(), 0.0)
+{
+  Insist(d_tracks && d_tracks->dimension() == 2,
+         "3D MOC needs the tracks of the radial plane; see tracker_extruded.");
+
+  // Sweeping requires the flat track layout.
+  if (!d_tracks->is_flat()) d_tracks->flatten();
+
+  d_exp = ExpTable::Create(input);
+
+  for (size_t k = 0; k < d_mesh->number_cells_z(); ++k)
+    d_z_edges[k + 1] = d_z_edges[k] + d_mesh->dz(k);
+
+  // Tracks above a 2D track are dz * sin(theta) apart.
+  double spacing = 0.1;
+  if (d_input->check("tracker_maximum_spacing"))
+    spacing = d_input->template get<double>("tracker_maximum_spacing");
+  if (d_input->check("moc_axial_spacing"))
+    spacing = d_input->template get<double>("moc_axial_spacing");
+  Insist(spacing > 0.0, "The axial track spacing must be positive.");
+  double Z = d_z_edges.back();
+  for (size_t p = 0; p < d_number_z.size(); ++p)
+  {
+    double n = std::ceil(Z * quadrature->sin_theta(p) / spacing);
+    d_number_z[p] = std::max(1, int(n));
+    d_slope[p]    = quadrature->cos_theta(p) / quadrature->sin_theta(p);
+  }
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+typename Sweeper3DMOC<EQ>::SP_sweeper
+Sweeper3DMOC<EQ>::Create(SP_input       input,
+                         SP_mesh        mesh,
+                         SP_material    material,
+                         SP_quadrature  quadrature,
+                         SP_state       state,
+                         SP_boundary    boundary,
+                         SP_sweepsource sweepsource)
+{
+  SP_sweeper p(new Sweeper3DMOC(input, mesh, material, quadrature,
+                                state, boundary, sweepsource));
+  return p;
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+TRANSPORT_INSTANTIATE_EXPORT(Sweeper3DMOC<Equation_SC_MOC>)
+TRANSPORT_TEMPLATE_EXPORT(detran_utilities::SP<Sweeper3DMOC<Equation_SC_MOC> >)
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file Sweeper3DMOC.cc
+//---------------------------------------------------------------------------//
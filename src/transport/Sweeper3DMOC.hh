@@ -0,0 +1,183 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Sweeper3DMOC.hh
+ *  @brief  Sweeper3DMOC class definition.
+ *  @note   Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_SWEEPER3DMOC_HH_
+#define detran_SWEEPER3DMOC_HH_
+
+#include "transport/Sweeper.hh"
+#include "transport/ExpTable.hh"
+#include "angle/ProductQuadrature.hh"
+#include "boundary/BoundaryMOC.hh"
+#include "geometry/Mesh.hh"
+#include "geometry/TrackDB.hh"
+
+namespace detran
+{
+
+/**
+ *  @class Sweeper3DMOC
+ *  @brief Sweeper for 3D MOC problems on axially extruded tracks.
+ *
+ *  Storing the segments of every 3D track is rarely affordable.  For a
+ *  mesh that is an extrusion of its bottom layer, each 3D track lies
+ *  over a 2D track of the radial plane, and its segments are those of
+ *  the 2D track further cut by the axial mesh.  The tracks are therefore
+ *  stored in 2D form (see tracker_extruded in Tracker), and the 3D
+ *  segments are found as each track is swept.
+ *
+ *  For a 2D track of length L and a polar angle, the 3D tracks fill the
+ *  plane above the 2D track with parallel lines of slope cot(theta).
+ *  They cross the left end of the 2D track at heights (k + 1/2) dz for
+ *  k = 0 ... nz - 1, with dz = Z / nz and nz chosen so that the lines
+ *  are at most moc_axial_spacing apart, and they cross the bottom (or
+ *  top) at (j + 1/2) dz / cot(theta).  These are exactly the points at
+ *  which the others reach the bottom and top, so a reflecting or
+ *  periodic bottom or top leads one track into another with no
+ *  interpolation.  Each track is followed up and down until it leaves
+ *  through a radial side or reaches a vacuum bottom or top.  The radial
+ *  sides must be vacuum.
+ *
+ *  The threads take the 3D tracks of different angles, so the angular
+ *  flux of each angle is updated by one thread only.
+ *
+ *  Relevant input database entries:
+ *    - moc_exp_type [str]          (see ExpTable)
+ *    - moc_exp_max_error [dbl]     (see ExpTable)
+ *    - moc_axial_spacing [dbl]     (maximum distance between parallel
+ *                                   3D tracks above a 2D track; defaults
+ *                                   to tracker_maximum_spacing, or 0.1)
+ */
+
+template <class EQ>
+class Sweeper3DMOC: public Sweeper<_3D>
+{
+
+public:
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<Sweeper3DMOC>            SP_sweeper;
+  typedef Sweeper<_3D>                                  Base;
+  typedef typename Base::SP_state                       SP_state;
+  typedef typename Base::SP_input                       SP_input;
+  typedef typename Base::SP_material                    SP_material;
+  typedef typename Base::SP_sweepsource                 SP_sweepsource;
+  typedef typename Base::moments_type                   moments_type;
+  typedef typename Base::angular_flux_type              angular_flux_type;
+  typedef typename Base::vec_int                        vec_int;
+  typedef typename Base::size_t                         size_t;
+  typedef EQ                                            Equation_T;
+  typedef BoundaryMOC<_3D>                              Boundary_T;
+  typedef typename Boundary_T::SP_boundary              SP_boundary;
+  typedef detran_geometry::Mesh::SP_mesh                SP_mesh;
+  typedef detran_angle::ProductQuadrature::SP_quadrature SP_quadrature;
+  typedef detran_geometry::TrackDB::SP_trackdb          SP_trackdb;
+  typedef ExpTable::SP_exptable                         SP_exptable;
+  typedef detran_utilities::vec_dbl                     vec_dbl;
+  typedef SweepSource<_3D>::sweep_source_type           sweep_source_type;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor.
+   *  @param    input       User input database.
+   *  @param    mesh        3D mesh with extruded tracks.
+   *  @param    material    Material database.
+   *  @param    quadrature  Angular quadrature for MOC.
+   *  @param    state       State vectors.
+   *  @param    boundary    MOC boundary.
+   *  @param    sweepsource Sweep source constructor.
+   */
+  Sweeper3DMOC(SP_input input,
+               SP_mesh mesh,
+               SP_material material,
+               SP_quadrature quadrature,
+               SP_state state,
+               SP_boundary boundary,
+               SP_sweepsource sweepsource);
+
+  /// Virtual destructor
+  virtual ~Sweeper3DMOC(){}
+
+  /// SP Constructor
+  static SP_sweeper
+  Create(SP_input       input,
+         SP_mesh        mesh,
+         SP_material    material,
+         SP_quadrature  quadrature,
+         SP_state       state,
+         SP_boundary    boundary,
+         SP_sweepsource sweepsource);
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL SWEEPERS MUST IMPLEMENT THESE
+  //-------------------------------------------------------------------------//
+
+  /// Sweep.
+  inline void sweep(moments_type &phi);
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  // MOC boundary
+  SP_boundary d_boundary;
+  // Track database of the radial plane
+  SP_trackdb d_tracks;
+  /// Exponential evaluator
+  SP_exptable d_exp;
+  /// Axial mesh edges
+  vec_dbl d_z_edges;
+  /// Number of 3D tracks crossing the left end of a 2D track, by polar
+  vec_int d_number_z;
+  /// Rise per unit distance along a 2D track, by polar
+  vec_dbl d_slope;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Follow a 3D track and those it leads into.
+   *  @param equation   Equation set up for the angle
+   *  @param track      Flat index of the 2D track
+   *  @param o          Octant, which gives the direction along the
+   *                    2D track and whether the track goes up or down
+   *  @param polar      Polar index
+   *  @param s          Distance along the 2D track of the entry point
+   *  @param z          Height of the entry point
+   *  @param source     Sweep sources of all octants for the angle
+   *  @param psi        Angular fluxes of all octants for the angle
+   *  @param phi        Flux moments
+   */
+  inline void sweep_track(Equation_T                     &equation,
+                          const size_t                    track,
+                          size_t                          o,
+                          const size_t                    polar,
+                          double                          s,
+                          double                          z,
+                          std::vector<sweep_source_type> &source,
+                          std::vector<angular_flux_type> &psi,
+                          moments_type                   &phi);
+
+};
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+// INLINE MEMBER DEFINITIONS
+//---------------------------------------------------------------------------//
+
+#include "Sweeper3DMOC.i.hh"
+
+#endif /* detran_SWEEPER3DMOC_HH_ */
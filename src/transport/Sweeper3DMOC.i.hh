@@ -0,0 +1,243 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Sweeper3DMOC.i.hh
+ *  @brief  Sweeper3DMOC inline member definitions.
+ *  @note   Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_SWEEPER3DMOC_I_HH_
+#define detran_SWEEPER3DMOC_I_HH_
+
+#include <algorithm>
+#include <cmath>
+#ifdef DETRAN_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper3DMOC<EQ>::sweep(moments_type &phi)
+{
+  typedef detran_geometry::Mesh Mesh;
+
+  // Reset the flux moments
+  phi.assign(phi.size(), 0.0);
+
+  // Size the thread flux accumulators and angular flux scratch.
+  setup_thread_fluxes();
+  setup_thread_psi(8);
+
+  #pragma omp parallel default(shared)
+  {
+
+  // Initialize equation and setup for this group.
+  Equation_T equation(d_mesh, d_material, d_quadrature, d_update_psi);
+  equation.setup_group(d_g);
+  equation.set_exp(d_exp);
+
+  moments_type &phi_local = thread_flux(phi);
+
+  // Tracks turn from up to down at a reflecting top (and back at the
+  // bottom), so keep the sources and angular fluxes of an angle for
+  // each octant.
+  std::vector<sweep_source_type>
+    source(8, sweep_source_type(d_mesh->number_cells(), 0.0));
+  std::vector<angular_flux_type> &psi = thread_psi();
+
+  // Thread-private view; no reference count update.
+  detran_utilities::SPview<detran_angle::ProductQuadrature> q(d_quadrature);
+  size_t na = q->number_azimuths_octant();
+  double Z  = d_z_edges.back();
+
+  // Tracks enter through the bottom or top only where it is vacuum.
+  bool open_bottom = !d_boundary->is_reflective(Mesh::BOTTOM) &&
+                     !d_boundary->is_periodic(Mesh::BOTTOM);
+  bool open_top    = !d_boundary->is_reflective(Mesh::TOP) &&
+                     !d_boundary->is_periodic(Mesh::TOP);
+
+  #pragma omp for schedule(dynamic)
+  for (size_t a = 0; a < q->number_angles_octant(); ++a)
+  {
+    size_t azimuth = q->azimuth(a);
+    size_t polar   = q->polar(a);
+    equation.setup_azimuth(azimuth);
+    equation.setup_polar(polar);
+
+    for (size_t o = 0; o < 8; ++o)
+    {
+      d_sweepsource->source(d_g, o, a, source[o]);
+      if (d_update_psi) psi[o].assign(psi[o].size(), 0.0);
+    }
+
+    // Distances between the entry points on the left end and bottom.
+    int    nz = d_number_z[polar];
+    double dz = Z / nz;
+    double ds = dz / d_slope[polar];
+
+    // Octants 0-3 go up and 4-7 down, and each pair follows the 2D
+    // tracks as in the 2D sweep.
+    for (size_t o = 0; o < 8; ++o)
+    {
+      bool up = o < 4;
+      size_t az = azimuth;
+      if (o % 4 == 1 || o % 4 == 3) az += na;
+
+      size_t first_track = d_tracks->first_track(az);
+      for (int t = 0; t < d_tracks->number_tracks(az, 0); ++t)
+      {
+        size_t track = first_track + t;
+
+        double L = 0.0;
+        for (size_t s = d_tracks->segment_begin(track);
+             s < d_tracks->segment_end(track); ++s)
+        {
+          L += d_tracks->segment_length(s);
+        }
+
+        for (int k = 0; k < nz; ++k)
+        {
+          double z = up ? (k + 0.5) * dz : Z - (k + 0.5) * dz;
+          sweep_track(equation, track, o, polar, 0.0, z,
+                      source, psi, phi_local);
+        }
+        if (up ? open_bottom : open_top)
+        {
+          int n = std::max(0, int(std::ceil(L / ds - 0.5)));
+          for (int j = 0; j < n; ++j)
+          {
+            sweep_track(equation, track, o, polar, (j + 0.5) * ds,
+                        up ? 0.0 : Z, source, psi, phi_local);
+          }
+        }
+      } // end track
+
+    } // end octant
+
+    if (d_update_psi)
+      for (size_t o = 0; o < 8; ++o)
+        d_state->set_psi(d_g, o, a, psi[o]);
+
+  } // end angle loop
+
+  // Sum local thread fluxes.
+  reduce_thread_fluxes(phi);
+
+  } // end omp parallel
+
+  d_number_sweeps++;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void
+Sweeper3DMOC<EQ>::sweep_track(Equation_T                     &equation,
+                              const size_t                    track,
+                              size_t                          o,
+                              const size_t                    polar,
+                              double                          s,
+                              double                          z,
+                              std::vector<sweep_source_type> &source,
+                              std::vector<angular_flux_type> &psi,
+                              moments_type                   &phi)
+{
+  typedef detran_geometry::Mesh Mesh;
+
+  size_t nxy = d_mesh->number_cells_x() * d_mesh->number_cells_y();
+  size_t nz  = d_mesh->number_cells_z();
+  double Z   = d_z_edges.back();
+
+  double m = d_slope[polar];
+  double width = d_tracks->track_width(track) * Z / d_number_z[polar];
+
+  // Octants 2 and 3 (and 6 and 7) run the 2D tracks backward.
+  bool   up      = o < 4;
+  bool   reverse = o % 4 > 1;
+  size_t s_begin = d_tracks->segment_begin(track);
+  size_t s_end   = d_tracks->segment_end(track);
+  size_t n       = s_end - s_begin;
+  if (n == 0) return;
+
+  // Find the segment and axial cell of the entry point.
+  size_t i = 0;
+  size_t seg = reverse ? s_end - 1 : s_begin;
+  double s_out = d_tracks->segment_length(seg);
+  while (s_out <= s && i + 1 < n)
+  {
+    ++i;
+    seg = reverse ? s_end - 1 - i : s_begin + i;
+    s_out += d_tracks->segment_length(seg);
+  }
+  size_t k = up ?
+    std::upper_bound(d_z_edges.begin(), d_z_edges.end(), z) - d_z_edges.begin():
+    std::lower_bound(d_z_edges.begin(), d_z_edges.end(), z) - d_z_edges.begin();
+  k = std::min(std::max(k, size_t(1)), nz) - 1;
+
+  equation.setup_octant(o);
+  double psi_in  = 0.0;
+  double psi_out = 0.0;
+  while (true)
+  {
+    // The next 3D segment ends at the nearer of the 2D segment's end and
+    // the next axial mesh plane.
+    double z_out = up ? d_z_edges[k + 1] : d_z_edges[k];
+    double s_z = s + std::abs(z_out - z) / m;
+    double s_next = std::min(s_out, s_z);
+    if (s_next > s)
+    {
+      psi_in = psi_out;
+      size_t region = d_tracks->segment_region(seg) + nxy * k;
+      equation.solve(region, s_next - s, width, source[o],
+                     psi_in, psi_out, phi, psi[o]);
+    }
+    z = s_z <= s_out ? z_out : z + (up ? m : -m) * (s_next - s);
+    s = s_next;
+
+    // Cross into the next axial cell, or through the bottom or top.
+    if (s_z <= s_out)
+    {
+      if (up && k + 1 < nz)
+      {
+        ++k;
+      }
+      else if (!up && k > 0)
+      {
+        --k;
+      }
+      else
+      {
+        int side = up ? Mesh::TOP : Mesh::BOTTOM;
+        if (d_boundary->is_reflective(side))
+        {
+          up = !up;
+          o = up ? o - 4 : o + 4;
+          equation.setup_octant(o);
+        }
+        else if (d_boundary->is_periodic(side))
+        {
+          z = up ? 0.0 : Z;
+          k = up ? 0 : nz - 1;
+        }
+        else
+        {
+          return;
+        }
+      }
+    }
+
+    // Cross into the next 2D segment, or out of the domain.
+    if (s_out <= s_z)
+    {
+      if (++i == n) return;
+      seg = reverse ? s_end - 1 - i : s_begin + i;
+      s_out += d_tracks->segment_length(seg);
+    }
+  }
+}
+
+} // end namespace detran
+
+#endif /* detran_SWEEPER3DMOC_I_HH_ */
@@ -0,0 +1,80 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  test_ExpTable.cc
+ *  @brief Test of ExpTable
+ *  @note  Copyright (C) 2012-2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                     \
+        FUNC(test_ExpTable_table)     \
+        FUNC(test_ExpTable_rational)
+
+#include "TestDriver.hh"
+#include "ExpTable.hh"
+#include <cmath>
+
+using namespace detran;
+using namespace detran_utilities;
+using namespace detran_test;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//----------------------------------------------------------------------------//
+// Largest absolute error on a grid that is not aligned with any table.
+double max_error(const ExpTable &e)
+{
+  double err = 0.0;
+  for (int i = 0; i <= 100000; ++i)
+  {
+    double x = 0.000317 * i;
+    err = std::max(err, std::abs(e(x) - std::exp(-x)));
+  }
+  return err;
+}
+
+//----------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------------------------------------//
+
+int test_ExpTable_table(int argc, char *argv[])
+{
+  double bound[] = {1.0e-4, 1.0e-6, 1.0e-8};
+  for (int i = 0; i < 3; ++i)
+  {
+    ExpTable e(ExpTable::TABLE, bound[i]);
+    TEST(e.table_size() > 0);
+    TEST(max_error(e) <= bound[i]);
+  }
+  ExpTable e(ExpTable::EXACT);
+  TEST(soft_equiv(e(2.0), std::exp(-2.0)));
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_ExpTable_rational(int argc, char *argv[])
+{
+  double bound[] = {1.0e-4, 1.0e-8, 1.0e-12};
+  int order = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    ExpTable e(ExpTable::RATIONAL, bound[i]);
+    TEST(max_error(e) <= bound[i]);
+    // Tighter bounds need higher orders.
+    TEST(e.order() > order);
+    order = e.order();
+    // Thin segments keep their relative accuracy.
+    double x = 1.0e-7;
+    TEST(soft_equiv(1.0 - e(x), x - 0.5 * x * x, 1.0e-6));
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+//              end of test_ExpTable.cc
+//----------------------------------------------------------------------------//
@@ -10,6 +10,7 @@
 #define TEST_LIST                        \
         FUNC(test_ScatterSource_forward) \
         FUNC(test_ScatterSource_adjoint) \
+        FUNC(test_ScatterSource_block)   \
 
 #include "utilities/TestDriver.hh"
 #include "transport/ScatterSource.hh"
@@ -211,6 +212,31 @@ int test_ScatterSource_adjoint(int argc, char *argv[])
   return 0;
 }
 
+//----------------------------------------------------------------------------//
+int test_ScatterSource_block(int argc, char *argv[])
+{
+  ScatterSource::SP_material mat = get_material();
+  for (int adjoint = 0; adjoint < 2; ++adjoint)
+  {
+    State::SP_state state = get_state(adjoint);
+    ScatterSource source(state->get_mesh(), mat, state);
+    for (int cutoff = 0; cutoff < 3; ++cutoff)
+    {
+      // The block kernel must match the group-by-group source.
+      ScatterSource::groups_t groups = range<ScatterSource::size_t>(0, 3);
+      State::vec_moments_type s(3, vec_dbl(1, 0.0));
+      source.build_total_source(groups, cutoff, state->all_phi(), s);
+      for (int g = 0; g < 3; ++g)
+      {
+        vec_dbl ref(1, 0.0);
+        source.build_total_group_source(g, cutoff, state->all_phi(), ref);
+        TEST(soft_equiv(s[g][0], ref[0]));
+      }
+    }
+  }
+  return 0;
+}
+
 //----------------------------------------------------------------------------//
 //              end of test_ScatterSource.cc
 //----------------------------------------------------------------------------//
@@ -8,7 +8,8 @@
 
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST                     \
-        FUNC(test_State_basic)
+        FUNC(test_State_basic)        \
+        FUNC(test_State_angular_flux)
 
 #include "utilities/TestDriver.hh"
 #include "State.hh"
@@ -71,6 +72,70 @@ int test_State_basic(int argc, char *argv[])
   return 0;
 }
 
+//----------------------------------------------------------------------------//
+int test_State_angular_flux(int argc, char *argv[])
+{
+  SP_mesh mesh = mesh_2d_fixture();
+  int nc = mesh->number_cells();
+
+  State::SP_input input;
+  input = new InputDB();
+  input->put<std::string>("equation", "dd");
+  input->put<int>("number_groups", 2);
+  input->put<int>("store_angular_flux", 1);
+  QuadratureFactory::SP_quadrature quad = QuadratureFactory::build(input, 2);
+  int na = quad->number_angles();
+
+  // Double precision with all groups resident
+  State::SP_state state_d(new State(input, mesh, quad));
+  TEST(state_d->angular_flux().memory_size() == 2 * na * nc * sizeof(double));
+
+  // Single precision with only group 0 resident
+  input->put<std::string>("angular_flux_precision", "single");
+  input->put<vec_int>("angular_flux_groups", vec_int(1, 0));
+  State::SP_state state_s(new State(input, mesh, quad));
+  AngularFluxArena &arena = state_s->angular_flux();
+  TEST(arena.precision() == AngularFluxArena::SINGLE);
+  TEST(arena.is_resident(0));
+  TEST(!arena.is_resident(1));
+  TEST(arena.memory_size() == na * nc * sizeof(float));
+
+  // Round trip through single precision
+  State::angular_flux_type psi(nc, 0.0);
+  for (int i = 0; i < nc; ++i)
+    psi[i] = 1.0 / (i + 3.0);
+  state_s->set_psi(0, 1, 0, psi);
+  State::angular_flux_type psi_s = state_s->psi(0, 1, 0);
+  for (int i = 0; i < nc; ++i)
+    TEST(soft_equiv(psi_s[i], psi[i], 1.0e-7));
+
+  // Strided views see the same values
+  int angle = quad->index(1, 0);
+  StridedView<float> row = arena.angle_view<float>(0, angle);
+  TEST(row.size() == nc);
+  TEST(row[2] == (float) psi[2]);
+  StridedView<float> column = arena.cell_view<float>(0, 2);
+  TEST(column.size() == na);
+  TEST(column.stride() == nc);
+  TEST(column[angle] == (float) psi[2]);
+
+  // A nonresident group is recovered from its (isotropic) moments
+  state_s->set_psi(1, 1, 0, psi);
+  for (int i = 0; i < nc; ++i)
+    state_s->phi(1)[i] = 2.0;
+  int last = quad->number_angles_octant() - 1;
+  State::angular_flux_type psi_a = state_s->psi(1, 0, 0);
+  State::angular_flux_type psi_b = state_s->psi(1, 3, last);
+  for (int i = 0; i < nc; ++i)
+  {
+    TEST(psi_a[i] > 0.0);
+    TEST(soft_equiv(psi_a[i], psi_b[i]));
+    TEST(soft_equiv(psi_a[i], psi_a[0]));
+  }
+
+  return 0;
+}
+
 //----------------------------------------------------------------------------//
 //              end of test_State.cc
 //----------------------------------------------------------------------------//
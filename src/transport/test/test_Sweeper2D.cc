@@ -8,7 +8,9 @@
 
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST                     \
-        FUNC(test_Sweeper2D_basic)
+        FUNC(test_Sweeper2D_basic)    \
+        FUNC(test_Sweeper2D_wavefront)\
+        FUNC(test_Sweeper2D_packets)
 
 #include "utilities/TestDriver.hh"
 #include "Sweeper2D.hh"
@@ -18,9 +20,11 @@
 #include "geometry/test/mesh_fixture.hh"
 #include "material/test/material_fixture.hh"
 #include "angle/QuadratureFactory.hh"
+#include "external_source/ConstantSource.hh"
 
 using namespace detran;
 using namespace detran_angle;
+using namespace detran_external_source;
 using namespace detran_geometry;
 using namespace detran_utilities;
 using namespace detran_test;
@@ -76,6 +80,71 @@ int test_Sweeper2D_basic(int argc, char *argv[])
   return 0;
 }
 
+//----------------------------------------------------------------------------//
+// Sweep a source with and without an alternate sweep mode and compare.
+template <class EQ>
+bool mode_matches(std::string equation, std::string mode)
+{
+  typedef Sweeper2D<EQ> Sweeper_T;
+
+  // Uneven mesh so the hyperplanes differ in length at both ends.
+  vec_int fmx(1, 7), fmy(1, 4);
+  vec_dbl cm(2, 0.0);
+  cm[1] = 1.0;
+  vec_int mt(1, 0);
+  SP_mesh mesh(new Mesh2D(fmx, fmy, cm, cm, mt));
+  SP_material mat = material_fixture_1g();
+
+  State::moments_type phi[2];
+  for (int on = 0; on < 2; ++on)
+  {
+    InputDB::SP_input input(new InputDB());
+    input->put<std::string>("equation",     equation);
+    input->put<int>("number_groups",        1);
+    input->put<int>("quad_number_polar_octant",   2);
+    input->put<int>("quad_number_azimuth_octant",  3);
+    input->put<int>("store_angular_flux",   1);
+    input->put<int>(mode,                   on);
+    QuadratureFactory::SP_quadrature quad = QuadratureFactory::build(input, 2);
+    MomentIndexer::SP_momentindexer indexer = MomentIndexer::Create(2, 0);
+    MomentToDiscrete::SP_MtoD m2d(new MomentToDiscrete(indexer));
+    m2d->build(quad);
+    ConstantSource::SP_externalsource
+      q_e(new ConstantSource(1, mesh, 1.0, quad));
+    typename Sweeper_T::SP_state state(new State(input, mesh, quad));
+    typename Sweeper_T::SP_boundary
+      bound(new typename Sweeper_T::Boundary_T(input, mesh, quad));
+    typename Sweeper_T::SP_sweepsource
+      source(new SweepSource<_2D>(state, mesh, quad, mat, m2d));
+    source->set_moment_source(q_e);
+    source->build_fixed(0);
+    Sweeper_T sweeper(input, mesh, mat, quad, state, bound, source);
+    phi[on].resize(mesh->number_cells(), 0.0);
+    sweeper.setup_group(0);
+    sweeper.sweep(phi[on]);
+  }
+
+  for (int i = 0; i < phi[0].size(); i++)
+    if (!soft_equiv(phi[0][i], phi[1][i])) return false;
+  return true;
+}
+
+int test_Sweeper2D_wavefront(int argc, char *argv[])
+{
+  TEST(mode_matches<Equation_DD_2D>("dd", "sweeper_wavefront"));
+  TEST(mode_matches<Equation_SD_2D>("sd", "sweeper_wavefront"));
+  TEST(mode_matches<Equation_SC_2D>("sc", "sweeper_wavefront"));
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper2D_packets(int argc, char *argv[])
+{
+  // Six angles per octant leaves the second packet partially filled.
+  TEST(mode_matches<Equation_DD_2D>("dd", "sweeper_angle_packets"));
+  return 0;
+}
+
 //----------------------------------------------------------------------------//
 //              end of test_Sweeper2D.cc
 //----------------------------------------------------------------------------//
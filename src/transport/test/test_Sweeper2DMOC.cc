@@ -0,0 +1,261 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  test_Sweeper2DMOC.cc
+ *  @brief Test of Sweeper2DMOC
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                        \
+        FUNC(test_Sweeper2DMOC_exp)      \
+        FUNC(test_Sweeper2DMOC_release)  \
+        FUNC(test_Sweeper2DMOC_chains)   \
+        FUNC(test_Sweeper2DMOC_cyclic_bc) \
+        FUNC(test_Sweeper2DMOC_cache_update) \
+        FUNC(test_Sweeper2DMOC_psi)
+
+#include "utilities/TestDriver.hh"
+#include "Sweeper2DMOC.hh"
+#include "Equation_SC_MOC.hh"
+#include "geometry/Mesh2D.hh"
+#include "geometry/Tracker.hh"
+#include "angle/QuadratureFactory.hh"
+#include "angle/MomentToDiscrete.hh"
+#include "external_source/ConstantSource.hh"
+#include "material/Material.hh"
+
+using namespace detran;
+using namespace detran_angle;
+using namespace detran_external_source;
+using namespace detran_geometry;
+using namespace detran_material;
+using namespace detran_utilities;
+using namespace detran_test;
+
+typedef Sweeper2DMOC<Equation_SC_MOC> Sweeper_T;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//----------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------------------------------------//
+
+// Sweep a pure absorber with a unit source and return the scalar flux.
+// If sigma_t_after is positive, the total cross section is then changed
+// in place and the sweeps are repeated.  Boundaries are updated on the
+// fly, as in source iteration.  The state is returned through state_out
+// if given.
+State::moments_type sweep_absorber(Sweeper_T::SP_input input,
+                                   const int           number_sweeps,
+                                   const double        sigma_t_after = 0.0,
+                                   State::SP_state    *state_out = 0)
+{
+  vec_dbl cm(3, 0.0);
+  cm[1] = 1.0;
+  cm[2] = 2.0;
+  vec_int fm(2, 3);
+  vec_int mt(4, 0);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mt));
+
+  Material::SP_material mat = Material::Create(1, 1, "absorber");
+  mat->set_sigma_t(0, 0, 1.0);
+  mat->finalize();
+
+  input->put<int>("number_groups", 1);
+  input->put<std::string>("equation", "scmoc");
+  input->put<std::string>("quad_type", "u-dgl");
+  input->put<int>("quad_number_azimuth_octant", 3);
+  input->put<int>("quad_number_polar_octant", 2);
+  input->put<double>("tracker_maximum_spacing", 0.05);
+  input->put<int>("tracker_cyclic", 1);
+  Sweeper_T::SP_quadrature quad = QuadratureFactory::build(input, 2);
+  Tracker tracker(input, quad);
+  tracker.trackit(mesh);
+  tracker.normalize();
+  mesh->set_tracks(tracker.trackdb());
+
+  MomentIndexer::SP_momentindexer indexer = MomentIndexer::Create(2, 0);
+  MomentToDiscrete::SP_MtoD m2d(new MomentToDiscrete(indexer));
+  m2d->build(quad);
+  ExternalSource::SP_externalsource
+    q(new ConstantSource(1, mesh, 1.0, quad));
+  State::SP_state state(new State(input, mesh, quad));
+  Sweeper_T::SP_boundary boundary(new Sweeper_T::Boundary_T(input, mesh, quad));
+  Sweeper_T::SP_sweepsource
+    source(new SweepSource<_2D>(state, mesh, quad, mat, m2d));
+  source->set_moment_source(q);
+  Sweeper_T sweeper(input, mesh, mat, quad, state, boundary, source);
+  sweeper.set_update_boundary(true);
+
+  State::moments_type phi(mesh->number_cells(), 0.0);
+  source->reset();
+  source->build_fixed(0);
+  sweeper.setup_group(0);
+  for (int i = 0; i < number_sweeps; ++i)
+    sweeper.sweep(phi);
+  if (sigma_t_after > 0.0)
+  {
+    mat->set_sigma_t(0, 0, sigma_t_after);
+    for (int i = 0; i < number_sweeps; ++i)
+      sweeper.sweep(phi);
+  }
+  if (state_out) *state_out = state;
+  return phi;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper2DMOC_exp(int argc, char *argv[])
+{
+  // Every exponential, with or without the attenuation cache, gives the
+  // flux of the library exponential to within its error bound.  With
+  // vacuum sides the flux is positive and below the infinite medium
+  // value of one.
+  const char *type[3] = {"exact", "table", "rational"};
+  State::moments_type ref;
+  for (int t = 0; t < 3; ++t)
+  {
+    for (int c = 0; c < 2; ++c)
+    {
+      InputDB::SP_input input = InputDB::Create();
+      input->put<std::string>("moc_exp_type", type[t]);
+      input->put<int>("moc_exp_cache", c);
+      State::moments_type phi = sweep_absorber(input, 2);
+      if (ref.empty()) ref = phi;
+      TEST(phi.size() == 36);
+      for (int i = 0; i < phi.size(); ++i)
+      {
+        TEST(phi[i] > 0.0);
+        TEST(phi[i] < 1.0);
+        TEST(soft_equiv(phi[i], ref[i], 1.0e-6));
+      }
+    }
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper2DMOC_release(int argc, char *argv[])
+{
+  // The sweep reads only the flat arrays, so releasing the track objects
+  // after tracking leaves the flux unchanged.
+  State::moments_type phi[2];
+  for (int r = 0; r < 2; ++r)
+  {
+    InputDB::SP_input input = InputDB::Create();
+    input->put<int>("tracker_release_tracks", r);
+    phi[r] = sweep_absorber(input, 2);
+  }
+  TEST(phi[0].size() == 36);
+  for (int i = 0; i < phi[0].size(); ++i)
+  {
+    TEST(phi[0][i] > 0.0);
+    TEST(phi[0][i] == phi[1][i]);
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper2DMOC_chains(int argc, char *argv[])
+{
+  // With vacuum sides, sweeping the chains gives the flux of sweeping
+  // the tracks one by one.
+  State::moments_type phi[2];
+  for (int c = 0; c < 2; ++c)
+  {
+    InputDB::SP_input input = InputDB::Create();
+    input->put<int>("moc_chain_sweep", c);
+    phi[c] = sweep_absorber(input, 1);
+  }
+  TEST(phi[0].size() == 36);
+  for (int i = 0; i < phi[0].size(); ++i)
+  {
+    TEST(phi[0][i] > 0.0);
+    TEST(soft_equiv(phi[0][i], phi[1][i], 1.0e-12));
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper2DMOC_cyclic_bc(int argc, char *argv[])
+{
+  // Reflecting or periodic sides make the box an infinite medium, where
+  // the scalar flux is the source over the total cross section.
+  const char *bc[2][2] = {{"reflect", "reflect"}, {"periodic", "reflect"}};
+  for (int b = 0; b < 2; ++b)
+  {
+    InputDB::SP_input input = InputDB::Create();
+    input->put<std::string>("bc_west",  bc[b][0]);
+    input->put<std::string>("bc_east",  bc[b][0]);
+    input->put<std::string>("bc_south", bc[b][1]);
+    input->put<std::string>("bc_north", bc[b][1]);
+    State::moments_type phi = sweep_absorber(input, 30);
+    for (int i = 0; i < phi.size(); ++i)
+      TEST(soft_equiv(phi[i], 1.0, 1.0e-8));
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper2DMOC_cache_update(int argc, char *argv[])
+{
+  // Changing the total cross section between sweeps rebuilds the cached
+  // attenuations, so the cached sweep matches the uncached one.
+  State::moments_type phi[2];
+  for (int c = 0; c < 2; ++c)
+  {
+    InputDB::SP_input input = InputDB::Create();
+    input->put<int>("moc_exp_cache", c);
+    phi[c] = sweep_absorber(input, 2, 2.0);
+  }
+  InputDB::SP_input input = InputDB::Create();
+  input->put<int>("moc_exp_cache", 1);
+  State::moments_type phi_old = sweep_absorber(input, 2);
+  for (int i = 0; i < phi[0].size(); ++i)
+  {
+    TEST(soft_equiv(phi[1][i], phi[0][i]));
+    TEST(phi[1][i] < phi_old[i]);
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper2DMOC_psi(int argc, char *argv[])
+{
+  // The source is fixed and there is no scattering, so every sweep gives
+  // the same angular flux.  The stored flux is that of the last sweep
+  // alone, however many sweeps are made.
+  for (int c = 0; c < 2; ++c)
+  {
+    State::SP_state state[2];
+    for (int n = 0; n < 2; ++n)
+    {
+      InputDB::SP_input input = InputDB::Create();
+      input->put<int>("store_angular_flux", 1);
+      input->put<int>("moc_chain_sweep", c);
+      sweep_absorber(input, 1 + 2 * n, 0.0, &state[n]);
+    }
+    for (int o = 0; o < 4; ++o)
+    {
+      for (int a = 0; a < 6; ++a)
+      {
+        State::angular_flux_type psi_1 = state[0]->psi(0, o, a);
+        State::angular_flux_type psi_3 = state[1]->psi(0, o, a);
+        TEST(psi_1.size() == 36);
+        for (int i = 0; i < psi_1.size(); ++i)
+        {
+          TEST(psi_1[i] > 0.0);
+          TEST(soft_equiv(psi_3[i], psi_1[i], 1.0e-12));
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+//              end of test_Sweeper2DMOC.cc
+//----------------------------------------------------------------------------//
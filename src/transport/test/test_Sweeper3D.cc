@@ -9,12 +9,17 @@
 
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST                     \
-        FUNC(test_Sweeper3D_basic)
+        FUNC(test_Sweeper3D_basic)    \
+        FUNC(test_Sweeper3D_kba)      \
+        FUNC(test_Sweeper3D_packets)
 
 #include "utilities/TestDriver.hh"
 #include "Sweeper3D.hh"
 #include "Equation_DD_3D.hh"
+#include "CoarseMesh.hh"
+#include "CurrentTally.hh"
 #include "angle/LevelSymmetric.hh"
+#include "boundary/BoundaryFactory.t.hh"
 #include "external_source/ConstantSource.hh"
 #include "geometry/Mesh3D.hh"
 #include "geometry/test/mesh_fixture.hh"
@@ -107,6 +112,181 @@ int test_Sweeper3D_basic(int argc, char *argv[])
   return 0;
 }
 
+//----------------------------------------------------------------------------//
+// Sweep a uniform box by angle or by KBA blocks and return the flux.  With
+// reflect, the west, south, and bottom sides reflect, and reflected fluxes
+// are updated on the fly.  Currents are tallied if a tally is given.
+State::moments_type sweep_kba_box(Mesh::SP_mesh                    mesh,
+                                  Sweeper3D<Equation_DD_3D>::SP_tally tally,
+                                  const int                        kba,
+                                  const int                        reflect)
+{
+  typedef Sweeper3D<Equation_DD_3D> Sweeper_T;
+
+  Sweeper_T::SP_material mat    = material_fixture_1g();
+  Sweeper_T::SP_quadrature quad = LevelSymmetric::Create(4, 3);
+  MomentIndexer::SP_momentindexer indexer = MomentIndexer::Create(3, 0);
+  MomentToDiscrete::SP_MtoD m2d(new MomentToDiscrete(indexer));
+  m2d->build(quad);
+  ConstantSource::SP_externalsource q_e(new ConstantSource(1, mesh, 1.0, quad));
+
+  Sweeper_T::SP_input input(new InputDB());
+  input->put<int>("number_groups",       1);
+  input->put<int>("store_angular_flux",  1);
+  input->put<int>("sweeper_kba",         kba);
+  vec_int blocks(3, 2);
+  blocks[1] = 3;
+  input->put<vec_int>("sweeper_kba_blocks", blocks);
+  if (reflect)
+  {
+    input->put<std::string>("bc_west",   "reflect");
+    input->put<std::string>("bc_south",  "reflect");
+    input->put<std::string>("bc_bottom", "reflect");
+  }
+  Sweeper_T::SP_state state(new State(input, mesh, quad));
+  Sweeper_T::SP_boundary
+    bound = BoundaryFactory<_3D, BoundarySN>::build(input, mesh, quad);
+  Sweeper_T::SP_sweepsource
+    source(new SweepSource<_3D>(state, mesh, quad, mat, m2d));
+  source->set_moment_source(q_e);
+  source->build_fixed(0);
+  Sweeper_T sweeper(input, mesh, mat, quad, state, bound, source);
+  if (tally) sweeper.set_tally(tally);
+  sweeper.set_update_boundary(reflect);
+  State::moments_type phi(mesh->number_cells(), 0.0);
+  sweeper.setup_group(0);
+  sweeper.sweep(phi);
+  sweeper.sweep(phi);
+  return phi;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper3D_kba(int argc, char *argv[])
+{
+  typedef Sweeper3D<Equation_DD_3D> Sweeper_T;
+
+  // Uneven mesh so the last blocks are partial.
+  vec_int fmx(1, 5), fmy(1, 4), fmz(1, 3);
+  vec_dbl cm(2, 0.0);
+  cm[1] = 1.0;
+  vec_int mt(1, 0);
+  Sweeper_T::SP_mesh mesh = Mesh3D::Create(fmx, fmy, fmz, cm, cm, cm, mt);
+
+  // The wavefront sweep must reproduce the standard sweep, both with
+  // vacuum sides and with reflecting sides, which serialize the octants.
+  for (int reflect = 0; reflect < 2; ++reflect)
+  {
+    State::moments_type phi[2];
+    for (int kba = 0; kba < 2; ++kba)
+      phi[kba] = sweep_kba_box(mesh, Sweeper_T::SP_tally(0), kba, reflect);
+    for (int i = 0; i < phi[0].size(); i++)
+    {
+      TEST(phi[0][i] > 0.0);
+      TEST(soft_equiv(phi[0][i], phi[1][i]));
+    }
+  }
+
+  // It must also tally the same coarse mesh currents.
+  CoarseMesh::SP_coarsemesh coarse(new CoarseMesh(mesh, 2));
+  Mesh::SP_mesh cmesh = coarse->get_coarse_mesh();
+  for (int reflect = 0; reflect < 2; ++reflect)
+  {
+    CurrentTally<_3D>::SP_currenttally tally[2];
+    for (int kba = 0; kba < 2; ++kba)
+    {
+      tally[kba] = new CurrentTally<_3D>(coarse,
+                                         LevelSymmetric::Create(4, 3), 1);
+      sweep_kba_box(mesh, tally[kba], kba, reflect);
+    }
+    double total = 0.0;
+    for (int d = 0; d < 3; ++d)
+    {
+      int n[3] = {(int)cmesh->number_cells_x(), (int)cmesh->number_cells_y(),
+                  (int)cmesh->number_cells_z()};
+      n[d] += 1;
+      for (int k = 0; k < n[2]; ++k)
+      {
+        for (int j = 0; j < n[1]; ++j)
+        {
+          for (int i = 0; i < n[0]; ++i)
+          {
+            for (int sense = 0; sense < 2; ++sense)
+            {
+              double J_0 = tally[0]->partial_current(i, j, k, 0, d, sense);
+              double J_1 = tally[1]->partial_current(i, j, k, 0, d, sense);
+              TEST(soft_equiv(J_0, J_1));
+              total += J_0;
+            }
+          }
+        }
+      }
+    }
+    TEST(total > 0.0);
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper3D_packets(int argc, char *argv[])
+{
+  typedef Sweeper3D<Equation_DD_3D> Sweeper_T;
+
+  vec_int fmx(1, 5), fmy(1, 4), fmz(1, 3);
+  vec_dbl cm(2, 0.0);
+  cm[1] = 1.0;
+  vec_int mt(1, 0);
+
+  // S6 has six angles per octant, so the second packet is partial.
+  Sweeper_T::SP_mesh mesh       = Mesh3D::Create(fmx, fmy, fmz, cm, cm, cm, mt);
+  Sweeper_T::SP_material mat    = material_fixture_1g();
+  Sweeper_T::SP_quadrature quad = LevelSymmetric::Create(6, 3);
+
+  MomentIndexer::SP_momentindexer indexer = MomentIndexer::Create(3, 0);
+  MomentToDiscrete::SP_MtoD m2d(new MomentToDiscrete(indexer));
+  m2d->build(quad);
+  ConstantSource::SP_externalsource q_e(new ConstantSource(1, mesh, 1.0, quad));
+
+  State::moments_type phi[2];
+  Sweeper_T::SP_state state[2];
+  for (int packets = 0; packets < 2; ++packets)
+  {
+    Sweeper_T::SP_input input(new InputDB());
+    input->put<int>("number_groups",          1);
+    input->put<int>("store_angular_flux",     1);
+    input->put<int>("sweeper_angle_packets",  packets);
+    state[packets] = new State(input, mesh, quad);
+    Sweeper_T::SP_boundary
+      bound(new Sweeper_T::Boundary_T(input, mesh, quad));
+    Sweeper_T::SP_sweepsource
+      source(new SweepSource<_3D>(state[packets], mesh, quad, mat, m2d));
+    source->set_moment_source(q_e);
+    source->build_fixed(0);
+    Sweeper_T sweeper(input, mesh, mat, quad, state[packets], bound, source);
+    phi[packets].resize(mesh->number_cells(), 0.0);
+    sweeper.setup_group(0);
+    sweeper.sweep(phi[packets]);
+  }
+
+  // The packet sweep must reproduce the standard sweep.
+  for (int i = 0; i < phi[0].size(); i++)
+  {
+    TEST(soft_equiv(phi[0][i], phi[1][i]));
+  }
+  for (int o = 0; o < 8; ++o)
+  {
+    for (int a = 0; a < quad->number_angles_octant(); ++a)
+    {
+      const State::angular_flux_type &psi_0 = state[0]->psi(0, o, a);
+      const State::angular_flux_type &psi_1 = state[1]->psi(0, o, a);
+      for (int i = 0; i < psi_0.size(); i++)
+        TEST(soft_equiv(psi_0[i], psi_1[i]));
+    }
+  }
+
+  return 0;
+}
+
 //----------------------------------------------------------------------------//
 //              end of test_Sweeper3D.cc
 //----------------------------------------------------------------------------//
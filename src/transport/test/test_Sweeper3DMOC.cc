@@ -0,0 +1,160 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  test_Sweeper3DMOC.cc
+ *  @brief Test of Sweeper3DMOC
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                        \
+        FUNC(test_Sweeper3DMOC_extruded) \
+        FUNC(test_Sweeper3DMOC_axial)
+
+#include "utilities/TestDriver.hh"
+#include "Sweeper2DMOC.hh"
+#include "Sweeper3DMOC.hh"
+#include "Equation_SC_MOC.hh"
+#include "geometry/Mesh2D.hh"
+#include "geometry/Mesh3D.hh"
+#include "geometry/Tracker.hh"
+#include "angle/QuadratureFactory.hh"
+#include "angle/MomentToDiscrete.hh"
+#include "external_source/ConstantSource.hh"
+#include "material/Material.hh"
+
+using namespace detran;
+using namespace detran_angle;
+using namespace detran_external_source;
+using namespace detran_geometry;
+using namespace detran_material;
+using namespace detran_utilities;
+using namespace detran_test;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//----------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------------------------------------//
+
+// Sweep a pure absorber with a unit source once and return the scalar
+// flux.  The radial mesh is 6 x 6 cells over 2 x 2 cm, and a 3D mesh
+// has nz cells over 2 cm.
+template <class D, class S>
+State::moments_type sweep_absorber(InputDB::SP_input input, const int nz)
+{
+  vec_dbl cm(3, 0.0);
+  cm[1] = 1.0;
+  cm[2] = 2.0;
+  vec_int fm(2, 3);
+  Mesh::SP_mesh mesh;
+  if (D::dimension == 2)
+  {
+    mesh = new Mesh2D(fm, fm, cm, cm, vec_int(4, 0));
+  }
+  else
+  {
+    vec_dbl zcm(2, 0.0);
+    zcm[1] = 2.0;
+    mesh = new Mesh3D(fm, fm, vec_int(1, nz), cm, cm, zcm, vec_int(4, 0));
+    input->put<int>("tracker_extruded", 1);
+  }
+
+  Material::SP_material mat = Material::Create(1, 1, "absorber");
+  mat->set_sigma_t(0, 0, 1.0);
+  mat->finalize();
+
+  input->put<int>("number_groups", 1);
+  input->put<std::string>("equation", "scmoc");
+  input->put<std::string>("quad_type", "u-dgl");
+  input->put<int>("quad_number_azimuth_octant", 3);
+  input->put<int>("quad_number_polar_octant", 2);
+  input->put<double>("tracker_maximum_spacing", 0.05);
+  typename S::SP_quadrature quad = QuadratureFactory::build(input, D::dimension);
+  Tracker tracker(input, quad);
+  tracker.trackit(mesh);
+  tracker.normalize();
+  mesh->set_tracks(tracker.trackdb());
+
+  MomentIndexer::SP_momentindexer indexer =
+    MomentIndexer::Create(D::dimension, 0);
+  MomentToDiscrete::SP_MtoD m2d(new MomentToDiscrete(indexer));
+  m2d->build(quad);
+  ExternalSource::SP_externalsource
+    q(new ConstantSource(1, mesh, 1.0, quad));
+  State::SP_state state(new State(input, mesh, quad));
+  typename S::SP_boundary
+    boundary(new typename S::Boundary_T(input, mesh, quad));
+  typename S::SP_sweepsource
+    source(new SweepSource<D>(state, mesh, quad, mat, m2d));
+  source->set_moment_source(q);
+  S sweeper(input, mesh, mat, quad, state, boundary, source);
+
+  State::moments_type phi(mesh->number_cells(), 0.0);
+  source->reset();
+  source->build_fixed(0);
+  sweeper.setup_group(0);
+  sweeper.sweep(phi);
+  return phi;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper3DMOC_extruded(int argc, char *argv[])
+{
+  // With a reflecting or periodic bottom and top, the flux of a single
+  // layer is that of the 2D problem.
+  InputDB::SP_input input = InputDB::Create();
+  State::moments_type phi_2D =
+    sweep_absorber<_2D, Sweeper2DMOC<Equation_SC_MOC> >(input, 1);
+  const char *bc[] = {"reflect", "periodic"};
+  for (int b = 0; b < 2; ++b)
+  {
+    input = InputDB::Create();
+    input->put<std::string>("bc_bottom", bc[b]);
+    input->put<std::string>("bc_top",    bc[b]);
+    State::moments_type phi =
+      sweep_absorber<_3D, Sweeper3DMOC<Equation_SC_MOC> >(input, 1);
+    TEST(phi.size() == 36);
+    for (int i = 0; i < phi.size(); ++i)
+      TEST(soft_equiv(phi[i], phi_2D[i], 1.0e-10));
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_Sweeper3DMOC_axial(int argc, char *argv[])
+{
+  // With a vacuum bottom and top, the flux is symmetric about the middle
+  // and lowest in the bottom and top layers.
+  const int nz = 4;
+  InputDB::SP_input input = InputDB::Create();
+  State::moments_type phi =
+    sweep_absorber<_3D, Sweeper3DMOC<Equation_SC_MOC> >(input, nz);
+  TEST(phi.size() == 36 * nz);
+  for (int k = 0; k < nz; ++k)
+  {
+    for (int i = 0; i < 36; ++i)
+    {
+      TEST(phi[i + 36 * k] > 0.0);
+      TEST(soft_equiv(phi[i + 36 * k], phi[i + 36 * (nz - 1 - k)], 1.0e-10));
+      if (k == 0) TEST(phi[i] < phi[i + 36]);
+    }
+  }
+
+  // Reflecting the bottom and top only adds flux.
+  input = InputDB::Create();
+  input->put<std::string>("bc_bottom", "reflect");
+  input->put<std::string>("bc_top",    "reflect");
+  State::moments_type phi_r =
+    sweep_absorber<_3D, Sweeper3DMOC<Equation_SC_MOC> >(input, nz);
+  for (int i = 0; i < phi.size(); ++i)
+    TEST(phi_r[i] > phi[i]);
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+//              end of test_Sweeper3DMOC.cc
+//----------------------------------------------------------------------------//
@@ -0,0 +1,121 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  AlignedAllocator.hh
+ *  @brief AlignedAllocator class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+#ifndef detran_utilities_ALIGNEDALLOCATOR_HH_
+#define detran_utilities_ALIGNEDALLOCATOR_HH_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace detran_utilities
+{
+
+/**
+ *  @class AlignedAllocator
+ *  @brief Standard allocator whose blocks start on an A-byte boundary
+ *
+ *  A vector using it keeps its data on a cache line (for A = 64), so
+ *  rows padded to whole lines stay on whole lines.  A must be a power
+ *  of two and a multiple of sizeof(void*).
+ */
+template <class T, std::size_t A = 64>
+class AlignedAllocator
+{
+
+public:
+
+  //--------------------------------------------------------------------------//
+  // TYPEDEFS
+  //--------------------------------------------------------------------------//
+
+  typedef T                   value_type;
+  typedef T*                  pointer;
+  typedef const T*            const_pointer;
+  typedef T&                  reference;
+  typedef const T&            const_reference;
+  typedef std::size_t         size_type;
+  typedef std::ptrdiff_t      difference_type;
+
+  template <class U>
+  struct rebind {typedef AlignedAllocator<U, A> other;};
+
+  //--------------------------------------------------------------------------//
+  // CONSTRUCTORS
+  //--------------------------------------------------------------------------//
+
+  AlignedAllocator() {}
+  AlignedAllocator(const AlignedAllocator&) {}
+  template <class U>
+  AlignedAllocator(const AlignedAllocator<U, A>&) {}
+
+  //--------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //--------------------------------------------------------------------------//
+
+  pointer address(reference x) const {return &x;}
+  const_pointer address(const_reference x) const {return &x;}
+
+  pointer allocate(size_type n, const void* = 0)
+  {
+    if (n == 0) return 0;
+    if (n > max_size()) throw std::bad_alloc();
+    void *p = 0;
+#ifdef _WIN32
+    p = _aligned_malloc(n * sizeof(T), A);
+#else
+    if (posix_memalign(&p, A, n * sizeof(T)) != 0) p = 0;
+#endif
+    if (!p) throw std::bad_alloc();
+    return static_cast<pointer>(p);
+  }
+
+  void deallocate(pointer p, size_type)
+  {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+  }
+
+  size_type max_size() const {return size_type(-1) / sizeof(T);}
+
+  void construct(pointer p, const T &v) {new (static_cast<void*>(p)) T(v);}
+  void destroy(pointer p) {p->~T();}
+
+};
+
+/// All aligned allocators of one alignment are interchangeable.
+template <class T, class U, std::size_t A>
+inline bool operator==(const AlignedAllocator<T, A>&,
+                       const AlignedAllocator<U, A>&)
+{
+  return true;
+}
+template <class T, class U, std::size_t A>
+inline bool operator!=(const AlignedAllocator<T, A>&,
+                       const AlignedAllocator<U, A>&)
+{
+  return false;
+}
+
+/// Vector of doubles starting on a cache line
+typedef std::vector<double, AlignedAllocator<double> > vec_dbl_aligned;
+
+} // end namespace detran_utilities
+
+#endif // detran_utilities_ALIGNEDALLOCATOR_HH_
+
+//----------------------------------------------------------------------------//
+//              end of file AlignedAllocator.hh
+//----------------------------------------------------------------------------//
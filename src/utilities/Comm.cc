@@ -0,0 +1,158 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Comm.cc
+ *  @author Jeremy Roberts
+ *  @brief  Comm member definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Comm.hh"
+#ifdef DETRAN_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+namespace detran_utilities
+{
+
+bool Comm::d_initialized_here = false;
+
+//---------------------------------------------------------------------------//
+void Comm::initialize(int argc, char *argv[])
+{
+#ifdef DETRAN_ENABLE_MPI
+  if (is_initialized()) return;
+  MPI_Init(&argc, &argv);
+  d_initialized_here = true;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+void Comm::finalize()
+{
+#ifdef DETRAN_ENABLE_MPI
+  if (!d_initialized_here) return;
+  int flag = 0;
+  MPI_Finalized(&flag);
+  if (!flag) MPI_Finalize();
+  d_initialized_here = false;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+bool Comm::is_initialized()
+{
+#ifdef DETRAN_ENABLE_MPI
+  int flag = 0;
+  MPI_Initialized(&flag);
+  return flag;
+#else
+  return true;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+int Comm::rank()
+{
+  int r = 0;
+#ifdef DETRAN_ENABLE_MPI
+  if (is_initialized()) MPI_Comm_rank(MPI_COMM_WORLD, &r);
+#endif
+  return r;
+}
+
+//---------------------------------------------------------------------------//
+int Comm::size()
+{
+  int s = 1;
+#ifdef DETRAN_ENABLE_MPI
+  if (is_initialized()) MPI_Comm_size(MPI_COMM_WORLD, &s);
+#endif
+  return s;
+}
+
+//---------------------------------------------------------------------------//
+void Comm::barrier()
+{
+#ifdef DETRAN_ENABLE_MPI
+  if (size() > 1) MPI_Barrier(MPI_COMM_WORLD);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+double Comm::global_sum(const double x)
+{
+  double y = x;
+#ifdef DETRAN_ENABLE_MPI
+  if (size() > 1)
+    MPI_Allreduce(const_cast<double*>(&x), &y, 1,
+                  MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif
+  return y;
+}
+
+//---------------------------------------------------------------------------//
+double Comm::global_max(const double x)
+{
+  double y = x;
+#ifdef DETRAN_ENABLE_MPI
+  if (size() > 1)
+    MPI_Allreduce(const_cast<double*>(&x), &y, 1,
+                  MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+  return y;
+}
+
+//---------------------------------------------------------------------------//
+void Comm::global_sum(vec_dbl &x)
+{
+#ifdef DETRAN_ENABLE_MPI
+  if (size() > 1 && x.size())
+  {
+    vec_dbl y(x.size(), 0.0);
+    MPI_Allreduce(&x[0], &y[0], x.size(),
+                  MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    x.swap(y);
+  }
+#endif
+}
+
+//---------------------------------------------------------------------------//
+void Comm::exchange(const vec_int  &send_rank,
+                    const vec_int  &send_tag,
+                    const vec2_dbl &send,
+                    const vec_int  &recv_rank,
+                    const vec_int  &recv_tag,
+                    vec2_dbl       &recv)
+{
+  Require(send_rank.size() == send.size());
+  Require(send_tag.size()  == send.size());
+  Require(recv_rank.size() == recv.size());
+  Require(recv_tag.size()  == recv.size());
+
+#ifdef DETRAN_ENABLE_MPI
+  std::vector<MPI_Request> requests(send.size() + recv.size());
+  for (size_t i = 0; i < recv.size(); ++i)
+  {
+    MPI_Irecv(recv[i].size() ? &recv[i][0] : NULL, recv[i].size(),
+              MPI_DOUBLE, recv_rank[i], recv_tag[i], MPI_COMM_WORLD,
+              &requests[i]);
+  }
+  for (size_t i = 0; i < send.size(); ++i)
+  {
+    MPI_Isend(send[i].size() ? const_cast<double*>(&send[i][0]) : NULL,
+              send[i].size(), MPI_DOUBLE, send_rank[i], send_tag[i],
+              MPI_COMM_WORLD, &requests[recv.size() + i]);
+  }
+  if (requests.size())
+    MPI_Waitall(requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+#else
+  Insist(send.empty() && recv.empty(),
+         "Messages between processes require DETRAN_ENABLE_MPI.");
+#endif
+}
+
+} // end namespace detran_utilities
+
+//---------------------------------------------------------------------------//
+//              end of Comm.cc
+//---------------------------------------------------------------------------//
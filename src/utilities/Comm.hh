@@ -0,0 +1,105 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Comm.hh
+ *  @author Jeremy Roberts
+ *  @brief  Comm class definition.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_utilities_COMM_HH_
+#define detran_utilities_COMM_HH_
+
+#include "utilities/utilities_export.hh"
+#include "utilities/DBC.hh"
+#include "utilities/Definitions.hh"
+
+namespace detran_utilities
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class Comm
+ *  @brief Thin wrapper around the few MPI operations detran needs.
+ *
+ *  All communication is over MPI_COMM_WORLD.  When MPI is not enabled,
+ *  every function reduces to its trivial single process result, so
+ *  client code need not be guarded.
+ *
+ *  The library initializes MPI only if it has not already been
+ *  initialized, and it finalizes MPI only if it did the initializing.
+ *  Hence, a client that manages MPI itself can use detran freely.
+ */
+//---------------------------------------------------------------------------//
+
+class UTILITIES_EXPORT Comm
+{
+
+public:
+
+  /// Initialize MPI, if enabled and not yet initialized
+  static void initialize(int argc, char *argv[]);
+
+  /// Finalize MPI, if this class initialized it
+  static void finalize();
+
+  /// Has MPI been initialized (always true without MPI)
+  static bool is_initialized();
+
+  /// Rank of this process
+  static int rank();
+
+  /// Number of processes
+  static int size();
+
+  /// Is this process the master (rank 0)?
+  static bool is_master() { return rank() == 0; }
+
+  /// Block until all processes arrive
+  static void barrier();
+
+  /// Sum of a value over all processes
+  static double global_sum(const double x);
+
+  /// Maximum of a value over all processes
+  static double global_max(const double x);
+
+  /// In-place elementwise sum of a vector over all processes
+  static void global_sum(vec_dbl &x);
+
+  /**
+   *  @brief Exchange messages between processes
+   *
+   *  All receives are posted before any send, and the call returns
+   *  only after all messages have completed, so clients may list their
+   *  messages in any order.  Receive buffers must be sized on entry.
+   *  A message is matched by its source rank and tag.  Without MPI,
+   *  both lists must be empty.
+   *
+   *  @param send_rank   destination of each outgoing message
+   *  @param send_tag    tag of each outgoing message
+   *  @param send        outgoing messages
+   *  @param recv_rank   source of each incoming message
+   *  @param recv_tag    tag of each incoming message
+   *  @param recv        incoming messages
+   */
+  static void exchange(const vec_int  &send_rank,
+                       const vec_int  &send_tag,
+                       const vec2_dbl &send,
+                       const vec_int  &recv_rank,
+                       const vec_int  &recv_tag,
+                       vec2_dbl       &recv);
+
+private:
+
+  /// Did we initialize MPI?
+  static bool d_initialized_here;
+
+};
+
+} // end namespace detran_utilities
+
+#endif /* detran_utilities_COMM_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of Comm.hh
+//---------------------------------------------------------------------------//
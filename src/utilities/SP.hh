@@ -32,7 +32,10 @@ namespace detran_utilities
  *  \brief Reference counter for SP class.
  *
  *  This reference counter is thread safe, and allows SP's to be used
- *  as pointers to <i>unmutable</i> objects.
+ *  as pointers to <i>unmutable</i> objects.  The count is updated with
+ *  atomic builtins when the compiler provides them, so copying an SP
+ *  within a threaded region does not serialize the threads.  Otherwise,
+ *  a named critical section is used.
  */
 //---------------------------------------------------------------------------//
 
@@ -53,19 +56,29 @@ public:
   /// Increment the reference count
   inline void increment()
   {
+#ifdef __GNUC__
+    __sync_add_and_fetch(&b_refs, 1);
+#else
     #pragma omp critical(referencecount)
     {
       b_refs++;
     }
+#endif
   }
 
-  /// Decrement the reference count
-  inline void decrement()
+  /// Decrement the reference count and return the remaining count
+  inline int decrement()
   {
+    int r;
+#ifdef __GNUC__
+    r = __sync_sub_and_fetch(&b_refs, 1);
+#else
     #pragma omp critical(referencecount)
     {
-      b_refs--;
+      r = --b_refs;
     }
+#endif
+    return r;
   }
 
 private:
@@ -133,7 +146,9 @@ private:
  *
  * Note, SP is minimally thread-safe in that worker threads can make
  * copies of the SP (which increments the counter) and when out of scope,
- * the counter is decremented, all safely in the counter.  The objects
+ * the counter is decremented, all safely (and atomically) in the counter.
+ * Where even an atomic update is too much, e.g. in a sweep kernel, use
+ * an SPview.  The objects
  * to which these SP's point are <b>not</b> thread safe, but there are
  * few, if any, cases where that behavior would be required.
  *
@@ -257,6 +272,66 @@ private:
 
 };
 
+//---------------------------------------------------------------------------//
+/*!
+ * \class SPview
+ *
+ * \brief Non-owning view of the object held by an SP.
+ *
+ * An SPview is a bare pointer with the SP access interface.  It does not
+ * touch the reference count, so it is the cheap way to hand an object to
+ * an inner loop or a thread-private helper.  The view is only valid while
+ * some SP still owns the object:
+ * \code
+ *     SP<Foo> f(new Foo);
+ *     SPview<Foo> v(f);  // no count update
+ *     v->bar();
+ * \endcode
+ */
+//---------------------------------------------------------------------------//
+
+template<class T>
+class SPview
+{
+
+public:
+
+  /// Default constructor.
+  SPview() : p(0) {}
+
+  /// Construct a view of an SP.
+  SPview(const SP<T> &sp_in) : p(sp_in.bp()) {}
+
+  /// Access operator.
+  T* operator->() const
+  {
+    Requirev(p, std::string(typeid(T).name()));
+    return p;
+  }
+
+  /// Dereference operator.
+  T& operator*() const
+  {
+    Requirev(p, std::string(typeid(T).name()));
+    return *p;
+  }
+
+  /// Get the base-class pointer.
+  T* bp() const { return p; }
+
+  /// Boolean conversion operator.
+  operator bool() const { return p != 0; }
+
+  /// Operator not.
+  bool operator!() const { return p == 0; }
+
+private:
+
+  /// Raw pointer to the viewed object.
+  T *p;
+
+};
+
 } // end namespace detran_utilities
 
 //---------------------------------------------------------------------------//
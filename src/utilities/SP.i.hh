@@ -322,9 +322,9 @@ void SP<T>::free()
 {
 
   Require (r);
-  r->decrement();
-  // if the count goes to zero then we free the data
-  if (r->refs() == 0)
+  // if the count goes to zero then we free the data; the count returned
+  // by the decrement is used so that only one thread can see zero
+  if (r->decrement() == 0)
   {
     delete p;
     delete r;
@@ -0,0 +1,95 @@
+//----------------------------------*-C++-*-----------------------------------//
+/**
+ *  @file  test_SP.cc
+ *  @brief Test of SP and SPview
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//----------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST               \
+        FUNC(test_SP)           \
+        FUNC(test_SP_threaded)
+
+#include "TestDriver.hh"
+#include "utilities/SP.hh"
+
+using namespace std;
+using namespace detran_test;
+using namespace detran_utilities;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//----------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------------------------------------//
+
+class Foo
+{
+public:
+  Foo(int v) : value(v) {}
+  virtual ~Foo() {}
+  int value;
+};
+
+class Bar: public Foo
+{
+public:
+  Bar(int v) : Foo(v) {}
+};
+
+//----------------------------------------------------------------------------//
+int test_SP(int argc, char *argv[])
+{
+  SP<Foo> f(new Foo(1));
+  {
+    SP<Foo> g(f);
+    TEST(g == f);
+    SP<Foo> h;
+    TEST(!h);
+    h = g;
+    TEST(h->value == 1);
+  }
+  SP<Foo> b(new Bar(2));
+  SP<Bar> bb(b);
+  TEST(bb->value == 2);
+
+  // A view does not own the object.
+  SPview<Foo> v(f);
+  TEST(v);
+  TEST(v.bp() == f.bp());
+  TEST(v->value == 1);
+  (*v).value = 3;
+  TEST(f->value == 3);
+  SPview<Foo> w;
+  TEST(!w);
+
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+int test_SP_threaded(int argc, char *argv[])
+{
+  // Copy the same handle from many threads; the object must survive and be
+  // released exactly once when the last owner goes out of scope.
+  SP<Foo> f(new Foo(0));
+  int sum = 0;
+  #pragma omp parallel for reduction(+:sum)
+  for (int i = 0; i < 100000; ++i)
+  {
+    SP<Foo> g(f);
+    SP<Foo> h;
+    h = g;
+    sum += h->value + 1;
+  }
+  TEST(sum == 100000);
+  TEST(f->value == 0);
+  return 0;
+}
+
+//----------------------------------------------------------------------------//
+//              end of test_SP.cc
+//----------------------------------------------------------------------------//